@@ -4,13 +4,14 @@
 \brief Hash files using belt-hash / bash-hash
 \project bee2/cmd 
 \created 2014.10.28
-\version 2025.06.09
+\version 2026.10.16
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
 */
 
 #include <stdio.h>
+#include <bee2/core/blob.h>
 #include <bee2/core/dec.h>
 #include <bee2/core/file.h>
 #include <bee2/core/hex.h>
@@ -37,10 +38,19 @@
 Поддержаны следующие алгоритмы хэширования:
 - belt-hash (СТБ 34.101.31);
 - bash32, bash64, ..., bash512 (СТБ 34.101.77);
-- bash-prg-hashNNND (СТБ 34.101.77), где NNN in {256, 384, 512}, D in {1, 2}.
+- bash-prg-hashNNND (СТБ 34.101.77), где NNN in {256, 384, 512}, D in {1, 2};
+- bash-treeNNN (расширение bee2, см. bashTreeHash()), где 
+  NNN in {256, 384, 512}.
 
 \remark В алгоритмах bash-prg-hashNNND используется пустой анонс (annonce, фр.).
 
+\remark Алгоритмы bash-treeNNN не определены в СТБ 34.101.77. Они 
+предназначены для хэширования очень больших файлов (образов дисков 
+и виртуальных машин): файл разбивается на листья длины BSUM_TREE_LEAF 
+(1 Мб), которые хэшируются в нескольких потоках. Число потоков задается 
+опцией -tN (по умолчанию BSUM_TREE_THREADS). Хэш-значение bash-treeNNN 
+не зависит от числа потоков, но зависит от длины листа.
+
 Хэш-значения выводятся в формате
 ```
 	hex(хэш_значение_файла) имя_файла
@@ -54,6 +64,7 @@
 Примеры:
 	bee2cmd bsum file1 file2 file3
 	bee2cmd bsum -belt-hash file1 file2 file3 > checksum
+	bee2cmd bsum -bash-tree256 -t16 disk.img > checksum
 	bee2cmd bsum -c checksum
 	bee2cmd bsum -- -c
 
@@ -68,6 +79,10 @@
 *******************************************************************************
 */
 
+#define BSUM_TREE_LEAF		((size_t)1 << 20)
+#define BSUM_TREE_THREADS	8
+#define BSUM_TREE_THREADS_MAX	64
+
 static const char _name[] = "bsum";
 static const char _descr[] = "hash files using {belt|bash} algorithms";
 
@@ -84,9 +99,12 @@ static int bsumUsage()
 		"    -bash-prg-hashNNND (STB 34.101.77)\n"
 		"      with NNN in {256, 384, 512}, D in {1, 2}\n"
 		"      \\note annonce = NULL\n"
+		"    -bash-treeNNN (parallel tree hashing, not in STB 34.101.77)\n"
+		"      with NNN in {256, 384, 512}\n"
+		"      \\note leaves of 1 MiB, -tN sets N threads (default %u)\n"
 		"  \\remark use \"--\" to stop parsing options"
 		,
-		_name, _descr
+		_name, _descr, (unsigned)BSUM_TREE_THREADS
 	);
 	return -1;
 }
@@ -98,7 +116,8 @@ static int bsumUsage()
 Идентификатор хэш-алгоритма (hid), заданного в командной строке:
 *	0 -- belt-hash;
 *	32, 64, ..., 512 -- bash32, bash64, ..., bash512;
-*	NNND  -- bash-prg-hashNNND (NNN in {256, 384, 512}, D in {1, 2}).
+*	NNND  -- bash-prg-hashNNND (NNN in {256, 384, 512}, D in {1, 2});
+*	NNN0  -- bash-treeNNN (NNN in {256, 384, 512}).
 *******************************************************************************
 */
 
@@ -106,7 +125,7 @@ static bool_t bsumHidIsValid(size_t hid)
 {
 	return hid == 0 ||
 		(hid <= 512 && hid % 32 == 0) ||
-		(hid % 10 != 0 && hid % 10 <= 2 &&
+		(hid > 512 && hid % 10 <= 2 &&
 			(hid / 10) % 128 == 0 && 2 <= hid / 1280 && hid / 1280 <= 4);
 }
 
@@ -130,7 +149,68 @@ https://stackoverflow.com/questions/24057331/
 *******************************************************************************
 */
 
-static int bsumHash(octet hash[], size_t hid, const char* name)
+static int bsumHashTree(octet hash[], size_t hid, const char* name, 
+	size_t nthreads)
+{
+	const size_t keep = bashTree_keep(nthreads);
+	const size_t buf_len = nthreads * BSUM_TREE_LEAF;
+	size_t hash_len;
+	void* state;
+	octet* buf;
+	file_t file;
+	size_t count;
+	int ret = 0;
+	// pre
+	ASSERT(hid > 512 && hid % 10 == 0 && bsumHidIsValid(hid));
+	ASSERT(0 < nthreads && nthreads <= BSUM_TREE_THREADS_MAX);
+	hash_len = bsumHidHashLen(hid);
+	ASSERT(memIsValid(hash, hash_len));
+	// выделить память (буфер вмещает по листу на поток)
+	state = blobCreate(keep + buf_len);
+	if (!state)
+	{
+		printf("%s: FAILED [memory]\n", name);
+		return -1;
+	}
+	buf = (octet*)state + keep;
+	bashTreeStart(state, hid / 20, BSUM_TREE_LEAF, nthreads);
+	// открыть файл
+	file = fileOpen(name, "rb");
+	if (!file)
+	{
+		blobClose(state);
+		printf("%s: FAILED [open]\n", name);
+		return -1;
+	}
+	// читать и хэшировать файл
+	do
+	{
+		count = fileRead2(buf, buf_len, file);
+		if (count == SIZE_MAX)
+		{
+			printf("%s: FAILED [read]\n", name);
+			ret = -1;
+			break;
+		}
+		bashTreeStepH(buf, count, state);
+	}
+	while (count == buf_len);
+	// закрыть файл
+	if (!fileClose2(file) && ret == 0)
+	{
+		printf("%s: FAILED [close]\n", name);
+		ret = -1;
+	}
+	// возвратить хэш-значение
+	if (ret == 0)
+		bashTreeStepG(hash, hash_len, state);
+	// завершить
+	blobClose(state);
+	return ret;
+}
+
+static int bsumHash(octet hash[], size_t hid, const char* name, 
+	size_t nthreads)
 {
 	octet buf[32768];
 	octet state[4096];
@@ -142,6 +222,9 @@ static int bsumHash(octet hash[], size_t hid, const char* name)
 	ASSERT(beltHash_keep() <= sizeof(state));
 	ASSERT(bashHash_keep() <= sizeof(state));
 	ASSERT(bashPrg_keep() <= sizeof(state));
+	// bash-tree?
+	if (hid > 512 && hid % 10 == 0)
+		return bsumHashTree(hash, hid, name, nthreads);
 	// обработать hid
 	hash_len = bsumHidHashLen(hid);
 	if (hid == 0)
@@ -204,14 +287,14 @@ static int bsumHash(octet hash[], size_t hid, const char* name)
 	return 0;
 }
 
-static int bsumPrint(size_t hid, int argc, char* argv[])
+static int bsumPrint(size_t hid, size_t nthreads, int argc, char* argv[])
 {
 	octet hash[64];
 	char str[64 * 2 + 8];
 	int ret = 0;
 	for (; argc--; argv++)
 	{
-		if (bsumHash(hash, hid, argv[0]) != 0)
+		if (bsumHash(hash, hid, argv[0], nthreads) != 0)
 		{
 			ret = -1;
 			continue;
@@ -223,7 +306,7 @@ static int bsumPrint(size_t hid, int argc, char* argv[])
 	return ret;
 }
 
-static int bsumCheck(size_t hid, const char* name)
+static int bsumCheck(size_t hid, size_t nthreads, const char* name)
 {
 	octet hash[64];
 	size_t hash_len;
@@ -261,7 +344,7 @@ static int bsumCheck(size_t hid, const char* name)
 		if(str[str_len - 1] == '\r') 
 			str[--str_len] = 0;
 		// хэшировать
-		if (bsumHash(hash, hid, str + 2 * hash_len + 2) == -1)
+		if (bsumHash(hash, hid, str + 2 * hash_len + 2, nthreads) == -1)
 		{
 			bad_files++;
 			continue;
@@ -309,6 +392,7 @@ static int bsumMain(int argc, char* argv[])
 {
 	err_t code = ERR_OK;
 	size_t hid = SIZE_MAX;
+	size_t nthreads = 0;
 	bool_t check = FALSE;
 #ifdef OS_WIN
 	setlocale(LC_ALL, "russian_belarus.1251");
@@ -337,7 +421,21 @@ static int bsumMain(int argc, char* argv[])
 			char* alg_name = argv[0] + strLen("-bash-prg-hash");
 			if (hid != SIZE_MAX || !decIsValid(alg_name) ||
 				strLen(alg_name) != 4 || decCLZ(alg_name) ||
-				!bsumHidIsValid(hid = (size_t)decToU32(alg_name)))
+				!bsumHidIsValid(hid = (size_t)decToU32(alg_name)) ||
+				hid % 10 == 0)
+			{
+				code = ERR_CMD_PARAMS;
+				break;
+			}
+			--argc, ++argv;
+		}
+		// bash-tree
+		else if (strStartsWith(argv[0], "-bash-tree"))
+		{
+			char* alg_name = argv[0] + strLen("-bash-tree");
+			if (hid != SIZE_MAX || !decIsValid(alg_name) ||
+				strLen(alg_name) != 3 || decCLZ(alg_name) ||
+				!bsumHidIsValid(hid = 10 * (size_t)decToU32(alg_name)))
 			{
 				code = ERR_CMD_PARAMS;
 				break;
@@ -351,7 +449,23 @@ static int bsumMain(int argc, char* argv[])
 			if (hid != SIZE_MAX || !decIsValid(alg_name) ||
 				2 > strLen(alg_name) || strLen(alg_name) > 4 ||
 				decCLZ(alg_name) ||
-				!bsumHidIsValid(hid = (size_t)decToU32(alg_name)))
+				!bsumHidIsValid(hid = (size_t)decToU32(alg_name)) ||
+				hid > 512 && hid % 10 == 0)
+			{
+				code = ERR_CMD_PARAMS;
+				break;
+			}
+			--argc, ++argv;
+		}
+		// threads
+		else if (strStartsWith(argv[0], "-t"))
+		{
+			char* threads = argv[0] + strLen("-t");
+			if (nthreads || !decIsValid(threads) ||
+				strLen(threads) == 0 || strLen(threads) > 2 ||
+				decCLZ(threads) ||
+				(nthreads = (size_t)decToU32(threads)) == 0 ||
+				nthreads > BSUM_TREE_THREADS_MAX)
 			{
 				code = ERR_CMD_PARAMS;
 				break;
@@ -384,6 +498,9 @@ static int bsumMain(int argc, char* argv[])
 	// дополнительные проверки и обработка ошибок
 	if (code == ERR_OK && (argc < 1 || check && argc != 1))
 		code = ERR_CMD_PARAMS;
+	if (code == ERR_OK && nthreads && (hid == SIZE_MAX || hid <= 512 || 
+		hid % 10 != 0))
+		code = ERR_CMD_PARAMS;
 	if (code != ERR_OK)
 	{
 		fprintf(stderr, "bee2cmd/%s: %s\n", _name, errMsg(code));
@@ -392,9 +509,13 @@ static int bsumMain(int argc, char* argv[])
 	// belt-hash по умолчанию
 	if (hid == SIZE_MAX)
 		hid = 0;
+	// число потоков по умолчанию
+	if (nthreads == 0)
+		nthreads = BSUM_TREE_THREADS;
 	// вычисление/проверка хэш-значениий
 	ASSERT(bsumHidIsValid(hid));
-	return check ? bsumCheck(hid, argv[0]) : bsumPrint(hid, argc, argv);
+	return check ? bsumCheck(hid, nthreads, argv[0]) :
+		bsumPrint(hid, nthreads, argc, argv);
 }
 
 /*
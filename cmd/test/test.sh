@@ -3,7 +3,7 @@
 # \brief Testing command-line interface
 # \project bee2evp/cmd
 # \created 2022.06.24
-# \version 2025.10.18
+# \version 2026.10.16
 # \pre The working directory contains "zed.cert", "zed.csr", "zed.sk"
 # =============================================================================
 
@@ -69,6 +69,18 @@ test_bsum() {
     && return 1
   $bee2cmd bsum -b -c -- -c \
     && return 1
+  $bee2cmd bsum -bash-tree256 -t3 $this > check256 \
+    || return 1
+  $bee2cmd bsum -bash-tree256 -c check256 \
+    || return 1
+  $bee2cmd bsum -bash-tree384 -c check256 \
+    && return 1
+  $bee2cmd bsum -bash-tree2560 $this \
+    && return 1
+  $bee2cmd bsum -bash256 -t3 $this \
+    && return 1
+  $bee2cmd bsum -bash-tree256 -t0 $this \
+    && return 1
   return 0
 }
 
@@ -4,7 +4,7 @@
 \brief Version and build information
 \project bee2/cmd 
 \created 2022.06.22
-\version 2025.10.28
+\version 2026.10.16
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
@@ -12,6 +12,7 @@
 
 #include <stdio.h>
 #include <bee2/core/util.h>
+#include <bee2/crypto/bash.h>
 #include "bee2/cmd.h"
 
 /*
@@ -223,7 +224,7 @@ static void verPrint()
 		"  build options:\n"
 		"    NDEBUG: %s\n"
 		"    safe (constant-time): %s\n"
-		"    bash_platform: %s\n",
+		"    bash_platform: %s [%s]\n",
 		utilVersion(), __DATE__,
 		verArch(),
 		verOS(),
@@ -234,7 +235,7 @@ static void verPrint()
 		verCompiler(),
 		verNDebug(),
 		verSafe(),
-		bash_platform
+		bash_platform, bashPlatform()
 	);
 }
 
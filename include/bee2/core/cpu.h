@@ -0,0 +1,132 @@
+/*
+*******************************************************************************
+\file cpu.h
+\brief Processor capabilities
+\project bee2 [cryptographic library]
+\created 2026.10.16
+\version 2026.10.16
+\copyright The Bee2 authors
+\license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
+*******************************************************************************
+*/
+
+/*!
+*******************************************************************************
+\file cpu.h
+\brief Возможности процессора
+*******************************************************************************
+*/
+
+#ifndef __BEE2_CPU_H
+#define __BEE2_CPU_H
+
+#include "bee2/defs.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*!
+*******************************************************************************
+\file cpu.h
+
+\section cpu-caps Возможности
+
+Возможности процессора -- это поддерживаемые им расширения системы
+команд. Возможности определяются один раз, при первом обращении
+к функции cpuCaps(), и описываются комбинацией (объединением) флагов
+CPU_XXX.
+
+Расширение считается поддерживаемым, если его инструкции выполняются
+процессором, а используемые ими регистры сохраняются операционной
+системой при переключении задач.
+
+На платформах, отличных от x86, x64 и ARM, возможности не определяются
+и cpuCaps() возвращает 0.
+
+\section cpu-dispatch Диспетчеризация
+
+Модули библиотеки могут содержать несколько вариантов (ядер) одной
+и той же функции, рассчитанных на разные возможности. Ядра одной функции
+описываются массивом требуемых возможностей caps. Ядра перечисляются
+в порядке убывания предпочтения, последнее ядро -- базовое, оно не требует
+никаких возможностей (caps[count - 1] == 0). Функция cpuDispatch()
+выбирает первое ядро, все требования которого выполнены.
+
+Все модули (belt, bash и другие) выбирают ядра с помощью функций
+cpuHas() и cpuDispatch(). Поэтому возможности, отключенные функцией
+cpuCapsMask(), одновременно перестают учитываться во всей библиотеке.
+Отключение используется при тестировании и сравнении ядер.
+
+Модуль может кэшировать номер выбранного ядра, чтобы не вызывать 
+cpuDispatch() при каждом обращении к функции. Кэш связывается с номером 
+редакции маски, который возвращает функция cpuCapsEpoch(). Номер 
+увеличивается при каждом вызове cpuCapsMask(), и кэш пересчитывается.
+
+Функция cpuCapsMask() атомарно публикует новую маску и только затем 
+увеличивает номер редакции. Поэтому функции в других потоках видят либо 
+прежнюю, либо новую маску, и кэш, построенный по прежней маске, 
+не используется после увеличения номера.
+
+\warning Операции, начатые в других потоках до вызова cpuCapsMask(), 
+могут завершиться на прежних ядрах.
+*******************************************************************************
+*/
+
+#define CPU_SSE2		0x0001	/*!< SSE2 (x86, x64) */
+#define CPU_PCLMUL		0x0002	/*!< PCLMULQDQ (x86, x64) */
+#define CPU_AVX2		0x0004	/*!< AVX2 (x86, x64) */
+#define CPU_AVX512F		0x0008	/*!< AVX-512 Foundation (x86, x64) */
+#define CPU_NEON		0x0010	/*!< Advanced SIMD (ARM) */
+
+/*!	\brief Возможности процессора
+
+	Определяются возможности процессора.
+	\return Комбинация флагов CPU_XXX за исключением флагов, отключенных
+	функцией cpuCapsMask().
+*/
+size_t cpuCaps();
+
+/*!	\brief Проверка возможностей
+
+	Проверяется, что процессор поддерживает все возможности caps.
+	\return Признак поддержки.
+*/
+bool_t cpuHas(
+	size_t caps				/*!< [in] возможности (флаги CPU_XXX) */
+);
+
+/*!	\brief Маскирование возможностей
+
+	Возможности, не указанные в mask, перестают учитываться функциями
+	cpuCaps(), cpuHas() и cpuDispatch(). Вызов cpuCapsMask(SIZE_MAX)
+	восстанавливает все возможности.
+*/
+void cpuCapsMask(
+	size_t mask				/*!< [in] учитываемые возможности */
+);
+
+/*!	\brief Редакция маски
+
+	Возвращается номер редакции маски возможностей.
+	\return Число вызовов cpuCapsMask().
+*/
+size_t cpuCapsEpoch();
+
+/*!	\brief Выбор ядра
+
+	Выбирается первое из count ядер, возможности caps[i] которого
+	поддерживаются процессором.
+	\pre count > 0 && caps[count - 1] == 0.
+	\return Номер выбранного ядра.
+*/
+size_t cpuDispatch(
+	const size_t caps[],	/*!< [in] требования ядер */
+	size_t count			/*!< [in] число ядер */
+);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* __BEE2_CPU_H */
@@ -4,7 +4,7 @@
 \brief Multithreading
 \project bee2 [cryptographic library]
 \created 2014.10.10
-\version 2023.02.02
+\version 2026.10.16
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
@@ -130,13 +130,144 @@ void mtMtxClose(
 *******************************************************************************
 \file mt.h
 
+\section mt-cnd Условные переменные
+
+Условная переменная позволяет потоку ожидать наступления события, 
+о котором сообщает другой поток. Ожидание выполняется функцией 
+mtCndWait() при заблокированном мьютексе: мьютекс разблокируется на время 
+ожидания и снова блокируется перед возвратом из функции. Поток-источник 
+события сообщает о нем функциями mtCndSignal() (пробуждается один из 
+ожидающих потоков) и mtCndBroadcast() (пробуждаются все ожидающие потоки).
+
+Поток может быть пробужден и без сообщения о событии. Поэтому после 
+возврата из mtCndWait() условие ожидания следует проверить повторно.
+
+Управление условными переменными реализуется по схемам, заданным 
+в стандарте языка Си ISO/IEC 9899:2011 (см. заголовочный файл threads.h).
+
+Если операционная система не распознана, то условные переменные 
+не создаются: без поддержки потоков ожидание события в mtCndWait() 
+не может завершиться.
+
+\typedef mt_cnd_t
+\brief Условная переменная
+*******************************************************************************
+*/
+
+#ifdef OS_WIN
+	typedef CONDITION_VARIABLE mt_cnd_t;
+#elif defined OS_UNIX
+	typedef pthread_cond_t mt_cnd_t;
+#else
+	typedef bool_t mt_cnd_t;
+#endif
+
+/*!	\brief Создание условной переменной
+
+	Создается условная переменная cnd.
+	\return Признак успеха.
+	\post В случае успеха должна быть вызвана функция mtCndClose().
+*/
+bool_t mtCndCreate(
+	mt_cnd_t* cnd		/*!< [out] условная переменная */
+);
+
+/*!	\brief Ожидание события
+
+	Ожидается сообщение о событии, связанном с условной переменной cnd. 
+	На время ожидания мьютекс mtx разблокируется.
+	\pre Условная переменная cnd создана.
+	\pre Мьютекс mtx заблокирован текущим потоком.
+	\post Мьютекс mtx заблокирован текущим потоком.
+*/
+void mtCndWait(
+	mt_cnd_t* cnd,		/*!< [in,out] условная переменная */
+	mt_mtx_t* mtx		/*!< [in,out] мьютекс */
+);
+
+/*!	\brief Сообщение о событии одному потоку
+
+	Пробуждается один из потоков, ожидающих события, связанного 
+	с условной переменной cnd.
+	\pre Условная переменная cnd создана.
+*/
+void mtCndSignal(
+	mt_cnd_t* cnd		/*!< [in,out] условная переменная */
+);
+
+/*!	\brief Сообщение о событии всем потокам
+
+	Пробуждаются все потоки, ожидающие события, связанного с условной 
+	переменной cnd.
+	\pre Условная переменная cnd создана.
+*/
+void mtCndBroadcast(
+	mt_cnd_t* cnd		/*!< [in,out] условная переменная */
+);
+
+/*!	\brief Закрытие условной переменной
+
+	Условная переменная cnd закрывается.
+	\pre Условная переменная cnd создана и ее события не ожидаются.
+*/
+void mtCndClose(
+	mt_cnd_t* cnd		/*!< [in,out] условная переменная */
+);
+
+/*!
+*******************************************************************************
+\file mt.h
+
 \section mt-thrd Управление потоками
 
 Управление потоками реализуется по схемам, заданным в стандарте языка Си
 ISO/IEC 9899:2011 (см. заголовочный файл threads.h).
+
+Интерфейс потоков упрощен по сравнению со стандартом: поток выполняет 
+функцию без возвращаемого значения, завершение потока только ожидается 
+(без получения кода возврата).
+
+Если операционная система не распознана, то функция потока выполняется 
+непосредственно при создании потока, а ожидание завершения потока 
+является пустой операцией.
+
+\typedef mt_thrd_t
+\brief Поток
 *******************************************************************************
 */
 
+#ifdef OS_WIN
+	typedef HANDLE mt_thrd_t;
+#elif defined OS_UNIX
+	typedef pthread_t mt_thrd_t;
+#else
+	typedef size_t mt_thrd_t;
+#endif
+
+/*!	\brief Создание потока
+
+	Создается поток thrd, в котором выполняется функция fn() с аргументом 
+	arg.
+	\return Признак успеха.
+	\post В случае успеха должна быть вызвана функция mtThrdJoin().
+*/
+bool_t mtThrdCreate(
+	mt_thrd_t* thrd,		/*!< [out] поток */
+	void (*fn)(void*),		/*!< [in] функция потока */
+	void* arg				/*!< [in] аргумент функции */
+);
+
+/*!	\brief Ожидание завершения потока
+
+	Ожидается завершение потока thrd. После завершения ресурсы потока 
+	освобождаются.
+	\pre Поток thrd успешно создан.
+	\pre mtThrdJoin() < mtThrdCreate().
+*/
+void mtThrdJoin(
+	mt_thrd_t* thrd			/*!< [in,out] поток */
+);
+
 /*!	\brief Приостановка потока
 
 	Текущий поток приостанавливается на ms миллисекунд.
@@ -4,7 +4,7 @@
 \brief STB 34.101.77 (bash): sponge-based algorithms
 \project bee2 [cryptographic library]
 \created 2014.07.15
-\version 2025.10.10
+\version 2026.10.16
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
@@ -50,6 +50,14 @@ sponge-функции bash-f, реализованной в bashF(). Sponge-фу
 По умолчанию используется реализация для платформы BASH_64 либо, если
 64-разрядные регистры не поддерживаются, BASH_32.
 
+Кроме этого, можно запросить "толстую" сборку (BASH_FAT). В такую сборку 
+включаются реализации BASH_64, BASH_AVX2, BASH_AVX512, а конкретная 
+реализация выбирается при каждом обращении к bashF() с учетом 
+возможностей процессора (см. cpuDispatch()). Толстая сборка 
+используется по умолчанию на платформе x64 при компиляции в GCC и Clang.
+
+Выбранная реализация возвращается функцией bashPlatform().
+
 Глубина стека bashF() определяется с помощью функции bashF_deep().
 
 Конкретный алгоритм хэширования bashHashNNN возвращает NNN-битовые хэш-значения,
@@ -131,13 +139,58 @@ size_t bashF_deep();
 	Буфер block преобразуется с помощью sponge-функции bash-f.
 	\pre Буфер block корректен.
 	\pre Если BASH_PLATFORM == BASH_32, то memIsAligned(block, 4) == TRUE.
-	\pre Если BASH_PLATFORM == BASH_64, то memIsAligned(block, 8) == TRUE.
+	\pre Если BASH_PLATFORM == BASH_64 или BASH_PLATFORM == BASH_FAT, 
+	то memIsAligned(block, 8) == TRUE.
 */
 void bashF(
 	octet block[192],	/*!< [in,out] прообраз/образ */
 	void* stack			/*!< [in,out] стек */
 );
 
+/*!	\brief Реализация sponge-функции
+
+	Определяется реализация sponge-функции, которая используется 
+	в bashF().
+	\return Имя платформы реализации: "BASH_64", "BASH_32", "BASH_SSE2", 
+	"BASH_AVX2", "BASH_AVX512" или "BASH_NEON".
+	\remark В толстой сборке (BASH_FAT) результат зависит от возможностей 
+	процессора и может измениться после вызова cpuCapsMask().
+*/
+const char* bashPlatform();
+
+/*!	\brief Sponge-функция на четырех состояниях
+
+	Четыре состояния, размещенные в буфере blocks послойно, 
+	преобразуются с помощью sponge-функции bash-f. В послойном 
+	представлении 64-битовое слово i состояния j (октеты 8i,..., 8i + 7 
+	состояния как буфера bashF()) размещается по смещению 8(4i + j).
+	\pre Буфер blocks корректен.
+	\pre Глубина стека stack не меньше bashF_deep().
+	\remark Результат совпадает с результатом четырех обращений к bashF(). 
+	Если процессор поддерживает AVX2, то состояния обрабатываются 
+	одновременно в векторных регистрах.
+*/
+void bashF4(
+	octet blocks[768],	/*!< [in,out] прообразы/образы */
+	void* stack			/*!< [in,out] стек */
+);
+
+/*!	\brief Sponge-функция на восьми состояниях
+
+	Восемь состояний, размещенных в буфере blocks послойно, 
+	преобразуются с помощью sponge-функции bash-f. Слово i состояния j 
+	размещается по смещению 8(8i + j).
+	\pre Буфер blocks корректен.
+	\pre Глубина стека stack не меньше bashF_deep().
+	\remark Результат совпадает с результатом восьми обращений к bashF(). 
+	Если процессор поддерживает AVX512F, то состояния обрабатываются 
+	одновременно в векторных регистрах.
+*/
+void bashF8(
+	octet blocks[1536],	/*!< [in,out] прообразы/образы */
+	void* stack			/*!< [in,out] стек */
+);
+
 /*
 *******************************************************************************
 Алгоритмы хэширования (bashHash)
@@ -224,6 +277,84 @@ err_t bashHash(
 	size_t count		/*!< [in] число октетов данных */
 );
 
+/*!	\brief Длина состояния функции хэширования нескольких сообщений
+
+	Возвращается длина состояния (в октетах) функции одновременного 
+	хэширования n сообщений.
+	\pre Длина состояния не превосходит SIZE_MAX.
+	\return Длина состояния.
+*/
+size_t bashHashMulti_keep(
+	size_t n			/*!< [in] число сообщений */
+);
+
+/*!	\brief Инициализация хэширования нескольких сообщений
+
+	В state формируются структуры данных, необходимые для одновременного 
+	хэширования n сообщений на уровне стойкости l.
+	\pre l > 0 && l % 16 == 0 && l <= 256.
+	\pre По адресу state зарезервировано bashHashMulti_keep(n) октетов.
+	\remark Сообщения хэшируются независимо: результат хэширования 
+	каждого сообщения совпадает с результатом bashHash(). Совместная 
+	обработка позволяет применять sponge-функцию к нескольким состояниям 
+	одновременно (см. bashF4(), bashF8()), что ускоряет хэширование 
+	большого числа коротких сообщений.
+*/
+void bashHashMultiStart(
+	void* state,		/*!< [out] состояние */
+	size_t l,			/*!< [in] уровень стойкости */
+	size_t n			/*!< [in] число сообщений */
+);
+
+/*!	\brief Хэширование фрагментов нескольких сообщений
+
+	Текущие хэш-значения сообщений, размещенные в state, пересчитываются 
+	с учетом новых фрагментов: к i-му сообщению добавляется фрагмент 
+	[count[i]]buf[i], i = 0, 1,..., n - 1.
+	\pre Буферы buf[i] и state не пересекаются.
+	\remark Допускаются пустые фрагменты (count[i] == 0).
+	\expect bashHashMultiStart() < bashHashMultiStepH()*.
+*/
+void bashHashMultiStepH(
+	const void* buf[],		/*!< [in] фрагменты */
+	const size_t count[],	/*!< [in] длины фрагментов */
+	void* state				/*!< [in,out] состояние */
+);
+
+/*!	\brief Определение хэш-значений нескольких сообщений
+
+	Определяются окончательные хэш-значения [hash_len * n]hash всех 
+	сообщений: хэш-значение i-го сообщения (первые hash_len октетов 
+	полного хэш-значения) размещается по адресу hash + hash_len * i.
+	\pre hash_len <= l / 4.
+	\expect (bashHashMultiStepH()* < bashHashMultiStepG())*.
+*/
+void bashHashMultiStepG(
+	octet hash[],		/*!< [out] хэш-значения */
+	size_t hash_len,	/*!< [in] длина хэш-значения */
+	void* state			/*!< [in,out] состояние */
+);
+
+/*!	\brief Хэширование нескольких сообщений
+
+	На уровне стойкости l определяются хэш-значения [l / 4 * n]hash 
+	сообщений [count[i]]src[i], i = 0, 1,..., n - 1. Хэш-значение i-го 
+	сообщения размещается по адресу hash + l / 4 * i.
+	\expect{ERR_BAD_PARAMS} l > 0 && l % 16 == 0 && l <= 256.
+	\expect{ERR_BAD_INPUT} Длины состояния и буфера hash не превосходят 
+	SIZE_MAX.
+	\return ERR_OK, если хэширование успешно завершено, и код ошибки
+	в противном случае.
+	\remark Результат совпадает с результатом n обращений к bashHash().
+*/
+err_t bashHashMulti(
+	octet hash[],			/*!< [out] хэш-значения */
+	size_t l,				/*!< [in] уровень стойкости */
+	const void* src[],		/*!< [in] сообщения */
+	const size_t count[],	/*!< [in] длины сообщений */
+	size_t n				/*!< [in] число сообщений */
+);
+
 /*
 *******************************************************************************
 bash256
@@ -394,6 +525,41 @@ void bashPrgSqueeze(
 	void* state			/*!< [in,out] автомат */
 );
 
+/*!	\brief Загрузка данных в несколько автоматов
+
+	В автоматы state[i] загружаются данные [count[i]]buf[i], 
+	i = 0, 1,..., n - 1.
+	\pre Автоматы state[i] попарно различны.
+	\pre Буферы buf[i] не пересекаются с автоматами.
+	\remark Результат совпадает с результатом n обращений к bashPrgAbsorb(). 
+	Sponge-функция применяется к нескольким автоматам одновременно 
+	(см. bashF4(), bashF8()).
+	\expect bashPrgStart() < bashPrgAbsorbMulti()*.
+*/
+void bashPrgAbsorbMulti(
+	const void* buf[],		/*!< [in] данные */
+	const size_t count[],	/*!< [in] длины данных */
+	void* state[],			/*!< [in,out] автоматы */
+	size_t n				/*!< [in] число автоматов */
+);
+
+/*!	\brief Выгрузка данных из нескольких автоматов
+
+	Из автоматов state[i] выгружаются данные [count[i]]buf[i], 
+	i = 0, 1,..., n - 1.
+	\pre Автоматы state[i] попарно различны.
+	\pre Буферы buf[i] не пересекаются с автоматами.
+	\remark Результат совпадает с результатом n обращений 
+	к bashPrgSqueeze().
+	\expect bashPrgStart() < bashPrgSqueezeMulti()*.
+*/
+void bashPrgSqueezeMulti(
+	void* buf[],			/*!< [out] данные */
+	const size_t count[],	/*!< [in] длины данных */
+	void* state[],			/*!< [in,out] автоматы */
+	size_t n				/*!< [in] число автоматов */
+);
+
 /*!	\brief Начало зашифрования
 
 	Инициализируется зашифрование с помощью автомата state.
@@ -473,6 +639,153 @@ void bashPrgRatchet(
 	void* state			/*!< [in,out] автомат */
 );
 
+/*
+*******************************************************************************
+Древовидное хэширование (bash-tree)
+
+\warning Древовидное хэширование не определено в СТБ 34.101.77. 
+Это расширение библиотеки, хэш-значения которого отличаются от 
+хэш-значений bashHash() и стандартных алгоритмов bash-prg-hash.
+
+Хэшируемые данные разбиваются на листья -- фрагменты длины leaf_len 
+октетов (последний лист может быть короче, пустые данные образуют 
+один пустой лист). Каждый лист хэшируется с помощью bashHash() на уровне 
+стойкости l. Хэш-значения листьев объединяются в двоичное дерево Меркла 
+(форма дерева такая же, как в RFC 6962). Хэш-значение внутреннего узла 
+вычисляется по хэш-значениям left и right его потомков с помощью 
+bash-prg-hash уровня l (d = 1) с анонсом "bashtreenode":
+	node = bash-prg-hash(left || right).
+Окончательное хэш-значение вычисляется по хэш-значению top корня дерева 
+с помощью bash-prg-hash с анонсом "bashtreeroot":
+	hash = bash-prg-hash(<leaf_len>_64 || top).
+Все хэш-значения имеют длину l / 4 октетов.
+
+Листья хэшируются независимо и поэтому параллельно: полные листья 
+фрагмента, переданного в bashTreeStepH(), обрабатываются в нескольких 
+потоках. Для распараллеливания фрагмент должен содержать несколько 
+полных листьев.
+
+Хэш-значения листьев можно сохранить (вычислив их с помощью bashHash()) 
+и затем проверять данные по листьям: изменение листа обнаруживается 
+повторным хэшированием только этого листа, а окончательное хэш-значение 
+по сохраненным хэш-значениям листьев восстанавливает функция 
+bashTreeHashLeaves().
+
+Функции bashTreeStart(), bashTreeStepH(), bashTreeStepG(), bashTreeStepV() 
+образуют связку и покрываются высокоуровневой функцией bashTreeHash().
+*******************************************************************************
+*/
+
+/*!	\brief Длина состояния древовидного хэширования
+
+	Возвращается длина состояния (в октетах) древовидного хэширования 
+	в nthreads потоках.
+	\return Длина состояния.
+*/
+size_t bashTree_keep(
+	size_t nthreads		/*!< [in] число потоков */
+);
+
+/*!	\brief Инициализация древовидного хэширования
+
+	В state формируются структуры данных, необходимые для древовидного 
+	хэширования на уровне стойкости l с листьями длины leaf_len 
+	в nthreads или меньшем числе потоков.
+	\pre l == 128 || l == 192 || l == 256.
+	\pre leaf_len > 0 && nthreads > 0.
+	\pre По адресу state зарезервировано bashTree_keep(nthreads) октетов.
+*/
+void bashTreeStart(
+	void* state,		/*!< [out] состояние */
+	size_t l,			/*!< [in] уровень стойкости */
+	size_t leaf_len,	/*!< [in] длина листа */
+	size_t nthreads		/*!< [in] число потоков */
+);
+
+/*!	\brief Древовидное хэширование фрагмента данных
+
+	Текущее хэш-значение, размещенное в state, пересчитывается по алгоритму 
+	bash-tree с учетом нового фрагмента данных [count]buf. Полные листья, 
+	содержащиеся в buf, хэшируются в нескольких потоках.
+	\expect bashTreeStart() < bashTreeStepH()*.
+*/
+void bashTreeStepH(
+	const void* buf,	/*!< [in] данные */
+	size_t count,		/*!< [in] число октетов данных */
+	void* state			/*!< [in,out] состояние */
+);
+
+/*!	\brief Определение древовидного хэш-значения
+
+	Определяются первые октеты [hash_len]hash окончательного хэш-значения 
+	всех данных, обработанных до этого функцией bashTreeStepH().
+	\pre hash_len <= l / 4.
+	\expect (bashTreeStepH()* < bashTreeStepG())*. 
+	\remark Состояние state не меняется: хэширование можно продолжить.
+*/
+void bashTreeStepG(
+	octet hash[],		/*!< [out] хэш-значение */
+	size_t hash_len,	/*!< [in] длина hash */
+	void* state			/*!< [in,out] состояние */
+);
+
+/*!	\brief Проверка древовидного хэш-значения
+
+	Проверяется, что первые октеты окончательного хэш-значения всех 
+	данных, обработанных до этого функцией bashTreeStepH(), совпадают 
+	с [hash_len]hash.
+	\pre hash_len <= l / 4.
+	\expect (bashTreeStepH()* < bashTreeStepV())*.
+	\return Признак успеха.
+*/
+bool_t bashTreeStepV(
+	const octet hash[],	/*!< [in] контрольное хэш-значение */
+	size_t hash_len,	/*!< [in] длина hash */
+	void* state			/*!< [in,out] состояние */
+);
+
+/*!	\brief Древовидное хэширование
+
+	С помощью алгоритма bash-tree на уровне стойкости l с листьями длины 
+	leaf_len определяется хэш-значение [l / 4]hash буфера [count]src. 
+	Листья хэшируются не более чем в nthreads потоках.
+	\expect{ERR_BAD_PARAMS} l == 128 || l == 192 || l == 256.
+	\expect{ERR_BAD_INPUT} leaf_len > 0 && nthreads > 0.
+	\return ERR_OK, если хэширование успешно завершено, и код ошибки
+	в противном случае.
+*/
+err_t bashTreeHash(
+	octet hash[],		/*!< [out] хэш-значение */
+	size_t l,			/*!< [in] уровень стойкости */
+	size_t leaf_len,	/*!< [in] длина листа */
+	const void* src,	/*!< [in] данные */
+	size_t count,		/*!< [in] число октетов данных */
+	size_t nthreads		/*!< [in] число потоков */
+);
+
+/*!	\brief Древовидное хэширование по хэш-значениям листьев
+
+	По хэш-значениям [l / 4 * n]leaves листьев длины leaf_len 
+	восстанавливается окончательное хэш-значение [l / 4]hash алгоритма 
+	bash-tree. Хэш-значение i-го листа размещается по адресу 
+	leaves + l / 4 * i и должно быть вычислено с помощью bashHash() на 
+	уровне стойкости l.
+	\expect{ERR_BAD_PARAMS} l == 128 || l == 192 || l == 256.
+	\expect{ERR_BAD_INPUT} leaf_len > 0 && n > 0.
+	\return ERR_OK, если хэш-значение успешно определено, и код ошибки
+	в противном случае.
+	\remark Если данные длины count октетов разбиты на n листьев, то 
+	n = max(1, ceil(count / leaf_len)), а результат совпадает 
+	с результатом bashTreeHash().
+*/
+err_t bashTreeHashLeaves(
+	octet hash[],			/*!< [out] хэш-значение */
+	size_t l,				/*!< [in] уровень стойкости */
+	size_t leaf_len,		/*!< [in] длина листа */
+	const octet leaves[],	/*!< [in] хэш-значения листьев */
+	size_t n				/*!< [in] число листьев */
+);
+
 #ifdef __cplusplus
 } /* extern "C" */
 #endif
@@ -4,7 +4,7 @@
 \brief STB 34.101.31 (belt): data encryption and integrity algorithms
 \project bee2 [cryptographic library]
 \created 2012.12.18
-\version 2025.12.29
+\version 2026.10.16
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
@@ -177,6 +177,33 @@ void beltKeyExpand2(
 	size_t len			/*!< [in] длина ключа в октетах */
 );
 
+/*!	\brief Длина подготовленного ключа
+
+	Возвращается длина (в октетах) подготовленного ключа.
+	\return Длина подготовленного ключа.
+*/
+size_t beltKey_keep();
+
+/*!	\brief Подготовка ключа
+
+	По ключу [len]key в ks формируется подготовленный ключ: расширенный 
+	форматированный ключ и не зависящие от синхропосылок величины. 
+	Подготовленный ключ используется в функциях belt***StartK(), которые 
+	формируют состояния механизмов без повторного расширения ключа. 
+	Эти функции не изменяют ks, поэтому один подготовленный ключ можно 
+	использовать многократно, в том числе одновременно в нескольких потоках.
+	\pre len == 16 || len == 24 || len == 32.
+	\pre По адресу ks зарезервировано beltKey_keep() октетов.
+	\remark Буферы key и ks могут пересекаться.
+	\warning Подготовленный ключ содержит ключ. После использования его 
+	следует очистить.
+*/
+void beltKeyStart(
+	void* ks,			/*!< [out] подготовленный ключ */
+	const octet key[],	/*!< [in] ключ */
+	size_t len			/*!< [in] длина ключа в октетах */
+);
+
 
 /*
 *******************************************************************************
@@ -414,6 +441,20 @@ void beltECBStart(
 	size_t len				/*!< [in] длина ключа в октетах */
 );
 
+/*!	\brief Инициализация шифрования в режиме ECB по подготовленному ключу
+
+	По подготовленному ключу ks в state формируются структуры данных, 
+	необходимые для шифрования в режиме ECB. Состояние совпадает с состоянием, 
+	которое формирует beltECBStart() по исходному ключу, но ключ не расширяется 
+	и не форматируется.
+	\pre По адресу state зарезервировано beltECB_keep() октетов.
+	\expect beltKeyStart() < beltECBStartK().
+*/
+void beltECBStartK(
+	void* state,			/*!< [out] состояние */
+	const void* ks			/*!< [in] подготовленный ключ */
+);
+
 /*!	\brief Зашифрование фрагмента в режиме ECB
 
 	Буфер [count]buf зашифровывается в режиме ECB на ключе, размещенном 
@@ -486,6 +527,52 @@ err_t beltECBDecr(
 	size_t len				/*!< [in] длина ключа */
 );
 
+/*!	\brief Многопоточное зашифрование в режиме ECB
+
+	Буфер [count]src зашифровывается на ключе [len]key октетов.
+	Результат зашифрования размещается в буфере [count]dest. 
+	Зашифрование выполняется не более чем в nthreads потоках.
+	\expect{ERR_BAD_INPUT}
+	-	len == 16 || len == 24 || len == 32;
+	-	count >= 16;
+	-	nthreads > 0.
+	.
+	\return ERR_OK, если данные успешно зашифрованы, и код ошибки
+	в противном случае.
+	\remark Результат совпадает с результатом beltECBEncr().
+*/
+err_t beltECBEncrParallel(
+	void* dest,				/*!< [out] шифртекст */
+	const void* src,		/*!< [in] открытый текст */
+	size_t count,			/*!< [in] число октетов текста */
+	const octet key[],		/*!< [in] ключ */
+	size_t len,				/*!< [in] длина ключа */
+	size_t nthreads			/*!< [in] число потоков */
+);
+
+/*!	\brief Многопоточное расшифрование в режиме ECB
+
+	Буфер [count]src расшифровывается на ключе [len]key октетов.
+	Результат расшифрования размещается в буфере [count]dest. 
+	Расшифрование выполняется не более чем в nthreads потоках.
+	\expect{ERR_BAD_INPUT}
+	-	len == 16 || len == 24 || len == 32;
+	-	count >= 16;
+	-	nthreads > 0.
+	.
+	\return ERR_OK, если данные успешно расшифрованы, и код ошибки
+	в противном случае.
+	\remark Результат совпадает с результатом beltECBDecr().
+*/
+err_t beltECBDecrParallel(
+	void* dest,				/*!< [out] открытый текст */
+	const void* src,		/*!< [in] шифртекст */
+	size_t count,			/*!< [in] число октетов текста */
+	const octet key[],		/*!< [in] ключ */
+	size_t len,				/*!< [in] длина ключа */
+	size_t nthreads			/*!< [in] число потоков */
+);
+
 /*
 *******************************************************************************
 Шифрование в режиме сцепления блоков (belt-cbc, CBC)
@@ -514,6 +601,21 @@ void beltCBCStart(
 	const octet iv[16]		/*!< [in] синхропосылка */
 );
 
+/*!	\brief Инициализация шифрования в режиме CBC по подготовленному ключу
+
+	По подготовленному ключу ks и синхропосылке iv в state формируются 
+	структуры данных, необходимые для шифрования в режиме CBC. Состояние 
+	совпадает с состоянием, которое формирует beltCBCStart() по исходному 
+	ключу, но ключ не расширяется и не форматируется.
+	\pre По адресу state зарезервировано beltCBC_keep() октетов.
+	\expect beltKeyStart() < beltCBCStartK().
+*/
+void beltCBCStartK(
+	void* state,			/*!< [out] состояние */
+	const void* ks,			/*!< [in] подготовленный ключ */
+	const octet iv[16]		/*!< [in] синхропосылка */
+);
+
 /*!	\brief Зашифрование в режиме CBC
 
 	Буфер [count]buf зашифровывается в режиме CBC на ключе, размещенном 
@@ -548,6 +650,27 @@ void beltCBCStepD(
 	void* state			/*!< [in,out] состояние */
 );
 
+/*!	\brief Зашифрование нескольких потоков в режиме CBC
+
+	Для i = 0, 1,..., n - 1 буфер [count[i]]buf[i] зашифровывается 
+	в режиме CBC на ключе, размещенном в состоянии state[i]. Результат 
+	совпадает с результатом обращений beltCBCStepE(buf[i], count[i], 
+	state[i]). Зашифрования разных потоков выполняются совместно 
+	(с чередованием или в векторных регистрах).
+	\pre count[i] == 0 || count[i] >= 16.
+	\pre Состояния state[i] попарно различны.
+	\pre Буферы buf[i] не пересекаются с состояниями state[j].
+	\expect beltCBCStart() < beltCBCStepEMulti()* для каждого state[i].
+	\remark Сохраняются замечания по функции beltCBCStepE().
+	\remark Потоки могут использовать разные ключи.
+*/
+void beltCBCStepEMulti(
+	void* buf[],			/*!< [in,out] открытые тексты / шифртексты */
+	const size_t count[],	/*!< [in] длины текстов */
+	void* state[],			/*!< [in,out] состояния */
+	size_t n				/*!< [in] число потоков */
+);
+
 /*!	\brief Зашифрование в режиме CBC
 
 	Буфер [count]src зашифровывается на ключе [len]key с использованием 
@@ -618,6 +741,21 @@ void beltCFBStart(
 	const octet iv[16]		/*!< [in] синхропосылка */
 );
 
+/*!	\brief Инициализация шифрования в режиме CFB по подготовленному ключу
+
+	По подготовленному ключу ks и синхропосылке iv в state формируются 
+	структуры данных, необходимые для шифрования в режиме CFB. Состояние 
+	совпадает с состоянием, которое формирует beltCFBStart() по исходному 
+	ключу, но ключ не расширяется и не форматируется.
+	\pre По адресу state зарезервировано beltCFB_keep() октетов.
+	\expect beltKeyStart() < beltCFBStartK().
+*/
+void beltCFBStartK(
+	void* state,			/*!< [out] состояние */
+	const void* ks,			/*!< [in] подготовленный ключ */
+	const octet iv[16]		/*!< [in] синхропосылка */
+);
+
 /*!	\brief Зашифрование в режиме CFB
 
 	Буфер [count]buf зашифровывается в режиме CFB на ключе, размещенном 
@@ -706,6 +844,21 @@ void beltCTRStart(
 	const octet iv[16]		/*!< [in] синхропосылка */
 );
 
+/*!	\brief Инициализация шифрования в режиме CTR по подготовленному ключу
+
+	По подготовленному ключу ks и синхропосылке iv в state формируются 
+	структуры данных, необходимые для шифрования в режиме CTR. Состояние 
+	совпадает с состоянием, которое формирует beltCTRStart() по исходному 
+	ключу, но ключ не расширяется и не форматируется.
+	\pre По адресу state зарезервировано beltCTR_keep() октетов.
+	\expect beltKeyStart() < beltCTRStartK().
+*/
+void beltCTRStartK(
+	void* state,			/*!< [out] состояние */
+	const void* ks,			/*!< [in] подготовленный ключ */
+	const octet iv[16]		/*!< [in] синхропосылка */
+);
+
 /*!	\brief Зашифрование фрагмента в режиме CTR
 
 	Буфер [count]buf зашифровывается в режиме CTR на ключе, размещенном 
@@ -723,6 +876,24 @@ void beltCTRStepE(
 */
 #define beltCTRStepD beltCTRStepE
 
+/*!	\brief Переход к блоку в режиме CTR
+
+	Состояние state перестраивается так, что следующее обращение к 
+	beltCTRStepE() обработает данные, начиная с блока с номером pos 
+	(с октета с номером 16 * pos) от начала шифрования. Предшествующие 
+	блоки не обрабатываются.
+	\expect beltCTRStart() < beltCTRSeek().
+	\remark Переходить можно как вперед, так и назад. Резерв гаммы 
+	(неиспользованные октеты последнего блока) сбрасывается.
+	\remark С помощью beltCTRSeek() можно расшифровать произвольный 
+	фрагмент шифртекста, начинающийся на границе блока, не расшифровывая 
+	предшествующие данные.
+*/
+void beltCTRSeek(
+	void* state,		/*!< [in,out] состояние */
+	size_t pos			/*!< [in] номер блока */
+);
+
 /*!	\brief Шифрование в режиме CTR
 
 	Буфер [count]src зашифровывается или расшифровывается на ключе
@@ -742,6 +913,34 @@ err_t beltCTR(
 	const octet iv[16]		/*!< [in] синхропосылка */
 );
 
+/*!	\brief Многопоточное шифрование в режиме CTR
+
+	Буфер [count]src зашифровывается или расшифровывается на ключе
+	[len]key с использованием синхропосылки iv. Результат шифрования 
+	размещается в буфере [count]dest. Шифрование выполняется не более чем 
+	в nthreads потоках.
+	\expect{ERR_BAD_INPUT}
+	-	len == 16 || len == 24 || len == 32;
+	-	nthreads > 0.
+	.
+	\return ERR_OK, если шифрование завершено успешно, и код ошибки
+	в противном случае.
+	\remark Результат совпадает с результатом beltCTR().
+	\remark Буфер разбивается на фрагменты, границы которых кратны 16 
+	октетам, и фрагменты шифруются независимо в разных потоках. Короткие 
+	буферы (до 64 Кбайт на поток) шифруются в меньшем числе потоков.
+	\remark Буферы могут пересекаться.
+*/
+err_t beltCTRParallel(
+	void* dest,				/*!< [out] шифртекст / открытый текст */
+	const void* src,		/*!< [in] открытый текст / шифртекст */
+	size_t count,			/*!< [in] число октетов текста */
+	const octet key[],		/*!< [in] ключ */
+	size_t len,				/*!< [in] длина ключа */
+	const octet iv[16],		/*!< [in] синхропосылка */
+	size_t nthreads			/*!< [in] число потоков */
+);
+
 /*
 *******************************************************************************
 Имитозащита (belt-mac, MAC)
@@ -769,6 +968,20 @@ void beltMACStart(
 	size_t len				/*!< [in] длина ключа в октетах */
 );
 
+/*!	\brief Инициализация функций MAC по подготовленному ключу
+
+	По подготовленному ключу ks в state формируются структуры данных, 
+	необходимые для имитозащиты в режиме MAC. Состояние совпадает с состоянием, 
+	которое формирует beltMACStart() по исходному ключу, но ключ не расширяется 
+	и не форматируется. Зашифрованный нулевой блок также берется из ks.
+	\pre По адресу state зарезервировано beltMAC_keep() октетов.
+	\expect beltKeyStart() < beltMACStartK().
+*/
+void beltMACStartK(
+	void* state,			/*!< [out] состояние */
+	const void* ks			/*!< [in] подготовленный ключ */
+);
+
 /*!	\brief Имитозащита фрагмента данных в режиме MAC
 
 	Текущая имитовставка, размещенная в state, пересчитывается с учетом нового
@@ -782,6 +995,26 @@ void beltMACStepA(
 	void* state			/*!< [in,out] состояние */
 );
 
+/*!	\brief Имитозащита фрагментов данных нескольких потоков
+
+	Для i = 0, 1,..., n - 1 текущая имитовставка, размещенная в state[i], 
+	пересчитывается с учетом нового фрагмента данных [count[i]]buf[i]. 
+	Результат совпадает с результатом обращений beltMACStepA(buf[i], 
+	count[i], state[i]). Зашифрования разных потоков выполняются 
+	совместно (с чередованием или в векторных регистрах).
+	\pre Состояния state[i] попарно различны.
+	\pre Буферы buf[i] не пересекаются с состояниями state[j].
+	\expect beltMACStart() < beltMACStepAMulti()* для каждого state[i].
+	\remark Допускаются пустые фрагменты (count[i] == 0).
+	\remark Потоки могут использовать разные ключи.
+*/
+void beltMACStepAMulti(
+	const void* buf[],		/*!< [in] фрагменты */
+	const size_t count[],	/*!< [in] длины фрагментов */
+	void* state[],			/*!< [in,out] состояния */
+	size_t n				/*!< [in] число потоков */
+);
+
 /*!	\brief Определение имитовставки в режиме MAC
 
 	Определяется окончательная имитовставка mac всех данных,
@@ -882,6 +1115,21 @@ void beltDWPStart(
 	const octet iv[16]		/*!< [in] синхропосылка */
 );
 
+/*!	\brief Инициализация функций DWP по подготовленному ключу
+
+	По подготовленному ключу ks и синхропосылке iv в state формируются 
+	структуры данных, необходимые для аутентифицированного шифрования в режиме 
+	DWP. Состояние совпадает с состоянием, которое формирует beltDWPStart() по 
+	исходному ключу, но ключ не расширяется и не форматируется.
+	\pre По адресу state зарезервировано beltDWP_keep() октетов.
+	\expect beltKeyStart() < beltDWPStartK().
+*/
+void beltDWPStartK(
+	void* state,			/*!< [out] состояние */
+	const void* ks,			/*!< [in] подготовленный ключ */
+	const octet iv[16]		/*!< [in] синхропосылка */
+);
+
 /*!	\brief Зашифрование критического фрагмента в режиме DWP
 
 	Фрагмент критических данных [count]buf зашифровывается на ключе,
@@ -966,6 +1214,45 @@ void beltDWPStepD(
 	void* state			/*!< [in,out] состояние */
 );
 
+/*!	\brief Зашифрование и имитозащита критического фрагмента в режиме DWP
+
+	Фрагмент критических данных [count]buf зашифровывается на ключе,
+	размещенном в state, и результат зашифрования сразу учитывается 
+	в текущей имитовставке. Результат зашифрования сохраняется в buf.
+	\expect beltDWPStart() < beltDWPStepEA()*.
+	\expect beltDWPStepI()* < beltDWPStepEA()*.
+	\remark Вызов beltDWPStepEA(buf, count, state) эквивалентен 
+	последовательности вызовов beltDWPStepE(buf, count, state), 
+	beltDWPStepA(buf, count, state). Буфер buf обрабатывается 
+	за один проход: фрагмент разбивается на порции, каждая порция 
+	зашифровывается и обрабатывается, пока находится в кэше.
+*/
+void beltDWPStepEA(
+	void* buf,			/*!< [in,out] критические данные */
+	size_t count,		/*!< [in] число октетов данных */
+	void* state			/*!< [in,out] состояние */
+);
+
+/*!	\brief Имитозащита и расшифрование критического фрагмента в режиме DWP
+
+	Фрагмент зашифрованных критических данных [count]buf учитывается 
+	в текущей имитовставке и расшифровывается на ключе, размещенном 
+	в state. Результат расшифрования сохраняется в buf.
+	\expect beltDWPStepI()* < beltDWPStepAD()*.
+	\remark Вызов beltDWPStepAD(buf, count, state) эквивалентен 
+	последовательности вызовов beltDWPStepA(buf, count, state), 
+	beltDWPStepD(buf, count, state). Буфер buf обрабатывается за 
+	один проход.
+	\warning Расшифрование выполняется до проверки имитовставки. 
+	Расшифрованные данные можно использовать только после успешной 
+	проверки функцией beltDWPStepV().
+*/
+void beltDWPStepAD(
+	void* buf,			/*!< [in,out] критические данные */
+	size_t count,		/*!< [in] число октетов данных */
+	void* state			/*!< [in,out] состояние */
+);
+
 /*!	\brief Установка защиты в режиме DWP
 
 	На ключе [len]key с использованием имитовставки iv устанавливается 
@@ -1005,6 +1292,9 @@ err_t beltDWPWrap(
 	\return ERR_OK, если защита успешно снята, и код ошибки
 	в противном случае.
 	\remark Буферы могут пересекаться.
+	\remark Если dest не пересекается с другими буферами, то проверка 
+	целостности и расшифрование выполняются за один проход 
+	(beltDWPStepAD()). При нарушении целостности dest обнуляется.
 */
 err_t beltDWPUnwrap(
 	void* dest,				/*!< [out] расшифрованные критические данные */
@@ -1047,6 +1337,21 @@ void beltCHEStart(
 	const octet iv[16]		/*!< [in] синхропосылка */
 );
 
+/*!	\brief Инициализация функций CHE по подготовленному ключу
+
+	По подготовленному ключу ks и синхропосылке iv в state формируются 
+	структуры данных, необходимые для аутентифицированного шифрования в режиме 
+	CHE. Состояние совпадает с состоянием, которое формирует beltCHEStart() по 
+	исходному ключу, но ключ не расширяется и не форматируется.
+	\pre По адресу state зарезервировано beltCHE_keep() октетов.
+	\expect beltKeyStart() < beltCHEStartK().
+*/
+void beltCHEStartK(
+	void* state,			/*!< [out] состояние */
+	const void* ks,			/*!< [in] подготовленный ключ */
+	const octet iv[16]		/*!< [in] синхропосылка */
+);
+
 /*!	\brief Зашифрование критического фрагмента в режиме CHE
 
 	Фрагмент критических данных [count]buf зашифровывается на ключе,
@@ -1131,6 +1436,45 @@ void beltCHEStepD(
 	void* state			/*!< [in,out] состояние */
 );
 
+/*!	\brief Зашифрование и имитозащита критического фрагмента в режиме CHE
+
+	Фрагмент критических данных [count]buf зашифровывается на ключе,
+	размещенном в state, и результат зашифрования сразу учитывается 
+	в текущей имитовставке. Результат зашифрования сохраняется в buf.
+	\expect beltCHEStart() < beltCHEStepEA()*.
+	\expect beltCHEStepI()* < beltCHEStepEA()*.
+	\remark Вызов beltCHEStepEA(buf, count, state) эквивалентен 
+	последовательности вызовов beltCHEStepE(buf, count, state), 
+	beltCHEStepA(buf, count, state). Буфер buf обрабатывается 
+	за один проход: фрагмент разбивается на порции, каждая порция 
+	зашифровывается и обрабатывается, пока находится в кэше.
+*/
+void beltCHEStepEA(
+	void* buf,			/*!< [in,out] критические данные */
+	size_t count,		/*!< [in] число октетов данных */
+	void* state			/*!< [in,out] состояние */
+);
+
+/*!	\brief Имитозащита и расшифрование критического фрагмента в режиме CHE
+
+	Фрагмент зашифрованных критических данных [count]buf учитывается 
+	в текущей имитовставке и расшифровывается на ключе, размещенном 
+	в state. Результат расшифрования сохраняется в buf.
+	\expect beltCHEStepI()* < beltCHEStepAD()*.
+	\remark Вызов beltCHEStepAD(buf, count, state) эквивалентен 
+	последовательности вызовов beltCHEStepA(buf, count, state), 
+	beltCHEStepD(buf, count, state). Буфер buf обрабатывается за 
+	один проход.
+	\warning Расшифрование выполняется до проверки имитовставки. 
+	Расшифрованные данные можно использовать только после успешной 
+	проверки функцией beltCHEStepV().
+*/
+void beltCHEStepAD(
+	void* buf,			/*!< [in,out] критические данные */
+	size_t count,		/*!< [in] число октетов данных */
+	void* state			/*!< [in,out] состояние */
+);
+
 /*!	\brief Установка защиты в режиме CHE
 
 	На ключе [len]key с использованием имитовставки iv устанавливается
@@ -1170,6 +1514,9 @@ err_t beltCHEWrap(
 	\return ERR_OK, если защита успешно снята, и код ошибки
 	в противном случае.
 	\remark Буферы могут пересекаться.
+	\remark Если dest не пересекается с другими буферами, то проверка 
+	целостности и расшифрование выполняются за один проход 
+	(beltCHEStepAD()). При нарушении целостности dest обнуляется.
 */
 err_t beltCHEUnwrap(
 	void* dest,				/*!< [out] расшифрованные критические данные */
@@ -1244,6 +1591,78 @@ err_t beltKWPUnwrap(
 	size_t len				/*!< [in] длина key в октетах */
 );
 
+/*!	\brief Пакетная установка защиты в режиме KWP
+
+	На ключе [len]key устанавливается защита n ключей, которые составляют 
+	буфер [count * n]src. Ключ [count]src + count * i защищается 
+	с заголовком [16]header + 16 * i (i = 0, 1,..., n - 1), защищенный 
+	ключ размещается по адресу dest + (count + 16) * i. Ключи 
+	обрабатываются в nthreads или меньшем числе потоков.
+	\expect{ERR_BAD_INPUT}
+	-	len == 16 || len == 24 || len == 32;
+	-	count >= 16;
+	-	n > 0;
+	-	nthreads > 0;
+	-	буфер [(count + 16) * n]dest не пересекается с буферами 
+		[count * n]src и [16 * n]header.
+	.
+	\return ERR_OK, если защита успешно установлена, и код ошибки 
+	в противном случае.
+	\remark При нулевом указателе header используются нулевые заголовки.
+	\remark Результат совпадает с результатом n обращений к beltKWPWrap(). 
+	Но ключ защиты расширяется один раз.
+*/
+err_t beltKWPWrapBatch(
+	octet dest[],			/*!< [out] защищенные ключи */
+	const octet src[],		/*!< [in] защищаемые ключи */
+	size_t count,			/*!< [in] длина защищаемых ключей в октетах */
+	size_t n,				/*!< [in] число ключей */
+	const octet header[],	/*!< [in] заголовки ключей */
+	const octet key[],		/*!< [in] ключ защиты */
+	size_t len,				/*!< [in] длина key в октетах */
+	size_t nthreads			/*!< [in] максимальное число потоков */
+);
+
+/*!	\brief Пакетное снятие защиты в режиме KWP
+
+	На ключе [len]key снимается защита с n ключей, которые составляют 
+	буфер [count * n]src. С ключа [count]src + count * i снимается защита 
+	(i = 0, 1,..., n - 1), первоначальный ключ размещается по адресу 
+	dest + (count - 16) * i, а результат снятия защиты -- в rets[i]: 
+	ERR_OK, если защита успешно снята и заголовок совпал с [16]header + 
+	16 * i, и ERR_BAD_KEYTOKEN в противном случае. Ошибка при обработке 
+	одного ключа не прерывает обработку остальных. Ключи обрабатываются 
+	в nthreads или меньшем числе потоков.
+	\expect{ERR_BAD_INPUT} 
+	-	len == 16 || len == 24 || len == 32;
+	-	count >= 32;
+	-	n > 0;
+	-	nthreads > 0;
+	-	буферы [(count - 16) * n]dest, [n]rets, [count * n]src 
+		и [16 * n]header попарно не пересекаются (header и src могут 
+		пересекаться).
+	.
+	\return ERR_OK, если защита успешно снята со всех ключей, 
+	ERR_BAD_KEYTOKEN, если защиту не удалось снять хотя бы с одного ключа,
+	и другой код ошибки, если пакет не обработан.
+	\remark При нулевом указателе header используются нулевые заголовки.
+	\remark Если защиту с ключа снять не удалось, то соответствующий 
+	фрагмент dest обнуляется.
+	\remark Если пакет не обработан из-за нехватки памяти, то во все 
+	элементы rets записывается код ERR_OUTOFMEMORY.
+*/
+err_t beltKWPUnwrapBatch(
+	octet dest[],			/*!< [out] ключи */
+	err_t rets[],			/*!< [out] результаты снятия защиты */
+	const octet src[],		/*!< [in] защищенные ключи */
+	size_t count,			/*!< [in] длина защищенных ключей в октетах */
+	size_t n,				/*!< [in] число ключей */
+	const octet header[],	/*!< [in] заголовки ключей */
+	const octet key[],		/*!< [in] ключ защиты */
+	size_t len,				/*!< [in] длина key в октетах */
+	size_t nthreads			/*!< [in] максимальное число потоков */
+);
+
 /*
 *******************************************************************************
 Хэширование (belt-hash, Hash)
@@ -1346,6 +1765,74 @@ err_t beltHash(
 	size_t count		/*!< [in] число октетов данных */
 );
 
+/*!	\brief Длина состояния функции хэширования нескольких сообщений
+
+	Возвращается длина состояния (в октетах) функции одновременного 
+	хэширования n сообщений.
+	\return Длина состояния.
+*/
+size_t beltHashMulti_keep(
+	size_t n			/*!< [in] число сообщений */
+);
+
+/*!	\brief Инициализация хэширования нескольких сообщений
+
+	В state формируются структуры данных, необходимые для одновременного 
+	хэширования n сообщений.
+	\pre По адресу state зарезервировано beltHashMulti_keep(n) октетов.
+	\remark Сообщения хэшируются независимо: результат хэширования 
+	каждого сообщения совпадает с результатом beltHash(). Совместная 
+	обработка позволяет выполнять зашифрования разных сообщений 
+	одновременно (с чередованием или в векторных регистрах), что 
+	ускоряет хэширование большого числа коротких сообщений.
+*/
+void beltHashMultiStart(
+	void* state,		/*!< [out] состояние */
+	size_t n			/*!< [in] число сообщений */
+);
+
+/*!	\brief Хэширование фрагментов нескольких сообщений
+
+	Текущие хэш-значения сообщений, размещенные в state, пересчитываются 
+	с учетом новых фрагментов: к i-му сообщению добавляется фрагмент 
+	[count[i]]buf[i], i = 0, 1,..., n - 1.
+	\pre Буферы buf[i] и state не пересекаются.
+	\remark Допускаются пустые фрагменты (count[i] == 0).
+	\expect beltHashMultiStart() < beltHashMultiStepH()*.
+*/
+void beltHashMultiStepH(
+	const void* buf[],		/*!< [in] фрагменты */
+	const size_t count[],	/*!< [in] длины фрагментов */
+	void* state				/*!< [in,out] состояние */
+);
+
+/*!	\brief Определение хэш-значений нескольких сообщений
+
+	Определяются окончательные хэш-значения [32 * n]hash всех сообщений: 
+	хэш-значение i-го сообщения размещается по адресу hash + 32 * i.
+	\expect (beltHashMultiStepH()* < beltHashMultiStepG())*.
+*/
+void beltHashMultiStepG(
+	octet hash[],		/*!< [out] хэш-значения */
+	void* state			/*!< [in,out] состояние */
+);
+
+/*!	\brief Хэширование нескольких сообщений
+
+	Определяются хэш-значения [32 * n]hash сообщений [count[i]]src[i], 
+	i = 0, 1,..., n - 1. Хэш-значение i-го сообщения размещается по адресу 
+	hash + 32 * i.
+	\return ERR_OK, если хэширование успешно завершено, и код ошибки
+	в противном случае.
+	\remark Результат совпадает с результатом n обращений к beltHash().
+*/
+err_t beltHashMulti(
+	octet hash[],			/*!< [out] хэш-значения */
+	const void* src[],		/*!< [in] сообщения */
+	const size_t count[],	/*!< [in] длины сообщений */
+	size_t n				/*!< [in] число сообщений */
+);
+
 /*
 *******************************************************************************
 Блоковое дисковое шифрование (belt-bde, BDE)
@@ -1442,6 +1929,65 @@ err_t beltBDEDecr(
 	const octet iv[16]		/*!< [in] синхропосылка */
 );
 
+/*!	\brief Пакетное зашифрование секторов в режиме BDE
+
+	Буфер [size * n]src, который состоит из n секторов по size октетов, 
+	зашифровывается на ключе [len]key. Сектор с номером i (0 <= i < n) 
+	зашифровывается на синхропосылке iv + i, где iv интерпретируется как 
+	128-битовое число, записанное октетами от младшего к старшему. 
+	Результат зашифрования размещается в буфере [size * n]dest. Секторы 
+	обрабатываются в nthreads или меньшем числе потоков.
+	\expect{ERR_BAD_INPUT}
+	-	len == 16 || len == 24 || len == 32;
+	-	size % 16 == 0 && size >= 16;
+	-	n > 0 && size * n не превосходит SIZE_MAX;
+	-	nthreads > 0.
+	.
+	\return ERR_OK, если данные успешно зашифрованы, и код ошибки
+	в противном случае.
+	\remark Результат совпадает с результатом последовательных вызовов 
+	beltBDEEncr() для отдельных секторов.
+	\remark Буферы могут пересекаться.
+*/
+err_t beltBDEEncrSectors(
+	void* dest,				/*!< [out] шифртекст */
+	const void* src,		/*!< [in] открытый текст */
+	size_t size,			/*!< [in] размер сектора */
+	size_t n,				/*!< [in] число секторов */
+	const octet key[],		/*!< [in] ключ */
+	size_t len,				/*!< [in] длина ключа */
+	const octet iv[16],		/*!< [in] синхропосылка первого сектора */
+	size_t nthreads			/*!< [in] максимальное число потоков */
+);
+
+/*!	\brief Пакетное расшифрование секторов в режиме BDE
+
+	Буфер [size * n]src, который состоит из n секторов по size октетов, 
+	расшифровывается на ключе [len]key. Сектор с номером i (0 <= i < n) 
+	расшифровывается на синхропосылке iv + i (см. beltBDEEncrSectors()). 
+	Результат расшифрования размещается в буфере [size * n]dest. Секторы 
+	обрабатываются в nthreads или меньшем числе потоков.
+	\expect{ERR_BAD_INPUT}
+	-	len == 16 || len == 24 || len == 32;
+	-	size % 16 == 0 && size >= 16;
+	-	n > 0 && size * n не превосходит SIZE_MAX;
+	-	nthreads > 0.
+	.
+	\return ERR_OK, если данные успешно расшифрованы, и код ошибки
+	в противном случае.
+	\remark Буферы могут пересекаться.
+*/
+err_t beltBDEDecrSectors(
+	void* dest,				/*!< [out] открытый текст */
+	const void* src,		/*!< [in] шифртекст */
+	size_t size,			/*!< [in] размер сектора */
+	size_t n,				/*!< [in] число секторов */
+	const octet key[],		/*!< [in] ключ */
+	size_t len,				/*!< [in] длина ключа */
+	const octet iv[16],		/*!< [in] синхропосылка первого сектора */
+	size_t nthreads			/*!< [in] максимальное число потоков */
+);
+
 /*
 *******************************************************************************
 Секторное дисковое шифрование (belt-sde, SDE)
@@ -1539,6 +2085,65 @@ err_t beltSDEDecr(
 	const octet iv[16]		/*!< [in] синхропосылка */
 );
 
+/*!	\brief Пакетное зашифрование секторов в режиме SDE
+
+	Буфер [size * n]src, который состоит из n секторов по size октетов, 
+	зашифровывается на ключе [len]key. Сектор с номером i (0 <= i < n) 
+	зашифровывается на синхропосылке iv + i, где iv интерпретируется как 
+	128-битовое число, записанное октетами от младшего к старшему. 
+	Результат зашифрования размещается в буфере [size * n]dest. Секторы 
+	обрабатываются в nthreads или меньшем числе потоков.
+	\expect{ERR_BAD_INPUT}
+	-	len == 16 || len == 24 || len == 32;
+	-	size % 16 == 0 && size >= 32;
+	-	n > 0 && size * n не превосходит SIZE_MAX;
+	-	nthreads > 0.
+	.
+	\return ERR_OK, если данные успешно зашифрованы, и код ошибки
+	в противном случае.
+	\remark Результат совпадает с результатом последовательных вызовов 
+	beltSDEEncr() для отдельных секторов.
+	\remark Буферы могут пересекаться.
+*/
+err_t beltSDEEncrSectors(
+	void* dest,				/*!< [out] шифртекст */
+	const void* src,		/*!< [in] открытый текст */
+	size_t size,			/*!< [in] размер сектора */
+	size_t n,				/*!< [in] число секторов */
+	const octet key[],		/*!< [in] ключ */
+	size_t len,				/*!< [in] длина ключа */
+	const octet iv[16],		/*!< [in] синхропосылка первого сектора */
+	size_t nthreads			/*!< [in] максимальное число потоков */
+);
+
+/*!	\brief Пакетное расшифрование секторов в режиме SDE
+
+	Буфер [size * n]src, который состоит из n секторов по size октетов, 
+	расшифровывается на ключе [len]key. Сектор с номером i (0 <= i < n) 
+	расшифровывается на синхропосылке iv + i (см. beltSDEEncrSectors()). 
+	Результат расшифрования размещается в буфере [size * n]dest. Секторы 
+	обрабатываются в nthreads или меньшем числе потоков.
+	\expect{ERR_BAD_INPUT}
+	-	len == 16 || len == 24 || len == 32;
+	-	size % 16 == 0 && size >= 32;
+	-	n > 0 && size * n не превосходит SIZE_MAX;
+	-	nthreads > 0.
+	.
+	\return ERR_OK, если данные успешно расшифрованы, и код ошибки
+	в противном случае.
+	\remark Буферы могут пересекаться.
+*/
+err_t beltSDEDecrSectors(
+	void* dest,				/*!< [out] открытый текст */
+	const void* src,		/*!< [in] шифртекст */
+	size_t size,			/*!< [in] размер сектора */
+	size_t n,				/*!< [in] число секторов */
+	const octet key[],		/*!< [in] ключ */
+	size_t len,				/*!< [in] длина ключа */
+	const octet iv[16],		/*!< [in] синхропосылка первого сектора */
+	size_t nthreads			/*!< [in] максимальное число потоков */
+);
+
 /*
 *******************************************************************************
 Шифрование с сохранением формата (belt-fmt, FMT)
@@ -1664,6 +2269,84 @@ err_t beltFMTDecr(
 	const octet iv[16]		/*!< [in] синхропосылка */
 );
 
+/*!	\brief Пакетное зашифрование в режиме FMT
+
+	Буфер [count * n]src, который состоит из n строк длины count 
+	в алфавите {0, 1,..., mod - 1}, зашифровывается на ключе [len]key. 
+	Строка с номером i (0 <= i < n) зашифровывается на синхропосылке 
+	[16]iv + 16 * i. При нулевом указателе iv все строки зашифровываются 
+	на нулевой синхропосылке. Результат зашифрования размещается в буфере 
+	[count * n]dest. Строки обрабатываются в nthreads или меньшем числе 
+	потоков.
+	\expect{ERR_BAD_INPUT}
+	- 2 <= mod && mod <= 65536;
+	- 2 <= count;
+	- n > 0;
+	- len == 16 || len == 24 || len == 32;
+	- nthreads > 0;
+	- если iv ненулевой, то буферы [16 * n]iv и [count * n]dest 
+	  не пересекаются.
+	.
+	\expect{ERR_NOT_IMPLEMENTED} count <= 600.
+	\expect Символы src принадлежат алфавиту {0, 1,..., mod - 1}.
+	\return ERR_OK, если зашифрование успешно выполнено, и код ошибки в 
+	противном случае.
+	\remark Результат совпадает с результатом n обращений к beltFMTEncr(). 
+	Но ключ расширяется, а параметры, которые зависят от mod и count, 
+	определяются только один раз. Кроме этого, при коротких строках 
+	(например, при mod == 10 и count <= 38) зашифрования разных строк 
+	выполняются совместно.
+	\remark Все буферы, кроме iv и [count * n]dest, могут пересекаться.
+*/
+err_t beltFMTEncrBatch(
+	u16 dest[],				/*!< [out] шифртексты */
+	u32 mod,				/*!< [in] размер алфавита */
+	const u16 src[],		/*!< [in] открытые тексты */
+	size_t count,			/*!< [in] длина строк */
+	size_t n,				/*!< [in] число строк */
+	const octet key[],		/*!< [in] ключ */
+	size_t len,				/*!< [in] длина key в октетах */
+	const octet iv[],		/*!< [in] синхропосылки */
+	size_t nthreads			/*!< [in] максимальное число потоков */
+);
+
+/*!	\brief Пакетное расшифрование в режиме FMT
+
+	Буфер [count * n]src, который состоит из n строк длины count 
+	в алфавите {0, 1,..., mod - 1}, расшифровывается на ключе [len]key. 
+	Строка с номером i (0 <= i < n) расшифровывается на синхропосылке 
+	[16]iv + 16 * i. При нулевом указателе iv все строки расшифровываются 
+	на нулевой синхропосылке. Результат расшифрования размещается в буфере 
+	[count * n]dest. Строки обрабатываются в nthreads или меньшем числе 
+	потоков.
+	\expect{ERR_BAD_INPUT}
+	- 2 <= mod && mod <= 65536;
+	- 2 <= count;
+	- n > 0;
+	- len == 16 || len == 24 || len == 32;
+	- nthreads > 0;
+	- если iv ненулевой, то буферы [16 * n]iv и [count * n]dest 
+	  не пересекаются.
+	.
+	\expect{ERR_NOT_IMPLEMENTED} count <= 600.
+	\expect Символы src принадлежат алфавиту {0, 1,..., mod - 1}.
+	\return ERR_OK, если расшифрование успешно выполнено, и код ошибки в 
+	противном случае.
+	\remark Результат совпадает с результатом n обращений к beltFMTDecr().
+	\remark Сохраняются замечания по функции beltFMTEncrBatch().
+*/
+err_t beltFMTDecrBatch(
+	u16 dest[],				/*!< [out] открытые тексты */
+	u32 mod,				/*!< [in] размер алфавита */
+	const u16 src[],		/*!< [in] шифртексты */
+	size_t count,			/*!< [in] длина строк */
+	size_t n,				/*!< [in] число строк */
+	const octet key[],		/*!< [in] ключ */
+	size_t len,				/*!< [in] длина key в октетах */
+	const octet iv[],		/*!< [in] синхропосылки */
+	size_t nthreads			/*!< [in] максимальное число потоков */
+);
+
 /*
 *******************************************************************************
 Преобразование ключа (belt-keyrep, KRP)
@@ -1747,6 +2430,12 @@ size_t beltHMAC_keep();
 	имитозащиты в режиме HMAC.
 	\pre По адресу state зарезервировано beltHMAC_keep() октетов.
 	\remark Рекомендуется использовать ключ из 32 октетов.
+	\remark В state сохраняются результаты обработки блоков key ^ ipad 
+	и key ^ opad. Для выработки нескольких имитовставок на одном ключе 
+	достаточно одного вызова beltHMACStart() и последующих вызовов 
+	beltHMACRestart(). Кроме этого, состояние, полученное после 
+	beltHMACStart(), можно скопировать и использовать копию для выработки 
+	новой имитовставки.
 */
 void beltHMACStart(
 	void* state,			/*!< [out] состояние */
@@ -1754,6 +2443,18 @@ void beltHMACStart(
 	size_t len				/*!< [in] длина ключа в октетах */
 );
 
+/*!	\brief Перезапуск функций HMAC
+
+	Состояние state возвращается к начальному состоянию, сформированному 
+	в beltHMACStart(). Ключ повторно не обрабатывается: восстанавливаются 
+	сохраненные в state результаты обработки key ^ ipad и key ^ opad. 
+	После перезапуска можно вырабатывать новую имитовставку на том же ключе.
+	\expect beltHMACStart() < beltHMACRestart().
+*/
+void beltHMACRestart(
+	void* state			/*!< [in,out] состояние */
+);
+
 /*!	\brief Имитозащита фрагмента данных в режиме HMAC
 
 	Текущая имитовставка, размещенная в state, пересчитывается с учетом нового
@@ -1862,6 +2563,36 @@ err_t beltPBKDF2(
 	size_t salt_len			/*!< [in] длина синхропосылки (в октетах) */
 );
 
+/*!	\brief Построение ключей по нескольким паролям
+
+	По паролям [pwd_len[i]]pwd[i] и синхропосылкам [salt_len[i]]salt[i] 
+	строятся ключи [32]key + 32 * i, i = 0, 1,..., n - 1. Каждый ключ 
+	пересчитывается iter > 0 раз. Пересчеты разных ключей выполняются 
+	совместно (с чередованием зашифрований) в nthreads или меньшем числе 
+	потоков.
+	\expect{ERR_BAD_INPUT}
+	-	iter != 0;
+	-	n > 0;
+	-	nthreads > 0.
+	.
+	\return ERR_OK, если ключи успешно построены, и код ошибки в противном 
+	случае.
+	\remark Результат совпадает с результатом n обращений к beltPBKDF2().
+	\remark Для построения ключей по одному паролю и разным синхропосылкам 
+	(или наоборот) можно повторять в массиве pwd (salt) один и тот же 
+	указатель.
+*/
+err_t beltPBKDF2Multi(
+	octet key[],			/*!< [out] ключи */
+	const octet* pwd[],		/*!< [in] пароли */
+	const size_t pwd_len[],	/*!< [in] длины паролей (в октетах) */
+	size_t iter,			/*!< [in] число итераций */
+	const octet* salt[],	/*!< [in] синхропосылки */
+	const size_t salt_len[],	/*!< [in] длины синхропосылок (в октетах) */
+	size_t n,				/*!< [in] число паролей */
+	size_t nthreads			/*!< [in] максимальное число потоков */
+);
+
 
 #ifdef __cplusplus
 } /* extern "C" */
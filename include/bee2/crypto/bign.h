@@ -4,7 +4,7 @@
 \brief STB 34.101.45 (bign): digital signature and key transport algorithms
 \project bee2 [cryptographic library]
 \created 2012.04.27
-\version 2023.09.25
+\version 2026.10.16
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
@@ -378,6 +378,176 @@ err_t bignSign2(
 	size_t t_len				/*!< [in] размер дополнительных данных */
 );
 
+/*!	\brief Дескриптор пула одноразовых ключей
+
+	Пул хранит пары (k, R.x), где k -- одноразовый личный ключ, R.x -- 
+	x-координата точки R = k G. Пары не зависят от подписываемых 
+	сообщений и могут вырабатываться заранее (offline), в том числе 
+	в фоновом потоке. При выработке подписи (online) из пула выбирается 
+	очередная пара и остается выполнить только хэширование и несколько 
+	операций по модулю q.
+
+	Пары размещаются в защищенной памяти (см. blob.h). Выбранная пара 
+	стирается из пула, поэтому одноразовый ключ не может быть использован 
+	повторно. Пул не хранит личных ключей подписи: личный ключ передается 
+	при каждой выработке подписи.
+*/
+typedef struct bign_pool_st* bign_pool_t;
+
+/*!	\brief Создание пула одноразовых ключей
+
+	Создается пустой пул емкости capacity для выработки подписей 
+	с долговременными параметрами params. Одноразовые ключи пула 
+	генерируются с помощью генератора rng с состоянием rng_state. 
+	Дескриптор пула возвращается по адресу *ppool.
+	\expect{ERR_BAD_PARAMS} Параметры params корректны.
+	\expect{ERR_BAD_INPUT} capacity > 0.
+	\expect{ERR_BAD_RNG} Генератор rng (с состоянием rng_state) корректен.
+	\expect Генератор rng является криптографически стойким.
+	\expect Генератор rng используется только пулом, пока пул не закрыт. 
+	Потокобезопасность rng не требуется: пул сам синхронизирует обращения 
+	к нему.
+	\return ERR_OK, если пул создан, и код ошибки в противном случае.
+	\remark При создании пула для базовой точки рассчитываются 
+	предвычисленные кратные. Это стоит примерно 20 вычислений R, но 
+	в несколько раз ускоряет последующие вычисления.
+*/
+err_t bignPoolCreate(
+	bign_pool_t* ppool,			/*!< [out] пул */
+	const bign_params* params,	/*!< [in] долговременные параметры */
+	size_t capacity,			/*!< [in] емкость пула */
+	gen_i rng,					/*!< [in] генератор случайных чисел */
+	void* rng_state				/*!< [in,out] состояние генератора */
+);
+
+/*!	\brief Пополнение пула
+
+	В пул pool добавляется до count пар (k, R.x). Пары вырабатываются 
+	в вызывающем потоке. Пополнение прекращается, если пул заполнен.
+	\expect{ERR_BAD_RNG} Генератор пула корректен.
+	\return ERR_OK, если пул пополнен, и код ошибки в противном случае.
+*/
+err_t bignPoolFill(
+	bign_pool_t pool,			/*!< [in,out] пул */
+	size_t count				/*!< [in] число пар */
+);
+
+/*!	\brief Запуск фонового пополнения пула
+
+	Запускается фоновый поток, который пополняет пул pool до заполнения 
+	и затем поддерживает его заполненным. Заполненный пул пополняется 
+	после выборки из него очередной пары. Поток останавливается при 
+	закрытии пула или при ошибке (например, генератора). Код ошибки 
+	сохраняется и возвращается функцией bignSignPool(), когда пул 
+	опустеет. Повторный запуск работающего потока игнорируется, поток, 
+	остановленный из-за ошибки, запускается заново.
+	\return ERR_OK, если поток запущен, и код ошибки в противном случае.
+	\remark Если операционная система не поддерживает потоки (см. mt.h), 
+	то возвращается код ERR_SYS.
+*/
+err_t bignPoolRun(
+	bign_pool_t pool			/*!< [in,out] пул */
+);
+
+/*!	\brief Число пар в пуле
+
+	Определяется число пар (k, R.x) в пуле pool.
+	\return Число пар.
+*/
+size_t bignPoolCount(
+	bign_pool_t pool			/*!< [in] пул */
+);
+
+/*!	\brief Число выборок из пустого пула
+
+	Определяется число обращений к bignSignPool(), при которых пул pool 
+	был пуст и пара (k, R.x) вырабатывалась в вызывающем потоке.
+	\return Число обращений.
+	\remark Рост счетчика означает, что пул пополняется медленнее, чем 
+	расходуется: следует увеличить емкость пула или пополнять его чаще.
+*/
+size_t bignPoolMisses(
+	bign_pool_t pool			/*!< [in] пул */
+);
+
+/*!	\brief Закрытие пула
+
+	Останавливается фоновый поток пула pool (если он запущен), пары пула 
+	стираются, пул закрывается.
+*/
+void bignPoolClose(
+	bign_pool_t pool			/*!< [in] пул */
+);
+
+/*!	\brief Выработка ЭЦП с пулом одноразовых ключей
+
+	Вырабатывается подпись [3 * l / 8]sig сообщения с хэш-значением 
+	[l / 4]hash, полученном с помощью алгоритма с идентификатором 
+	[oid_len]oid_der. Подпись вырабатывается на личном ключе 
+	[l / 4]privkey с использованием очередной пары (k, R.x) из пула pool. 
+	Если пул пуст, то пара вырабатывается в вызывающем потоке (см. 
+	bignPoolMisses()). Но если пул пуст, а его фоновый поток остановлен 
+	из-за ошибки, то возвращается код этой ошибки.
+	\expect{ERR_BAD_OID} Идентификатор oid_der корректен.
+	\expect{ERR_BAD_INPUT} Буферы sig и hash не пересекаются.
+	\expect{ERR_BAD_PRIVKEY} Личный ключ privkey корректен.
+	\return ERR_OK, если подпись выработана, и код ошибки в противном
+	случае.
+	\remark Подпись совпадает с подписью bignSign(), в которой генератор 
+	выдает те же одноразовые ключи k.
+	\remark Функция может вызываться одновременно в нескольких потоках.
+*/
+err_t bignSignPool(
+	octet sig[],				/*!< [out] подпись */
+	bign_pool_t pool,			/*!< [in,out] пул */
+	const octet oid_der[],		/*!< [in] идентификатор хэш-алгоритма */
+	size_t oid_len,				/*!< [in] длина oid_der в октетах */
+	const octet hash[],			/*!< [in] хэш-значение */
+	const octet privkey[]		/*!< [in] личный ключ */
+);
+
+/*!	\brief Пакетная выработка ЭЦП
+
+	Вырабатываются count подписей: подпись [3 * l / 8]sigs + 3 * l / 8 * i 
+	сообщения с хэш-значением [l / 4]hashes + l / 4 * i (i = 0, 1,..., 
+	count - 1). Хэш-значения получены с помощью алгоритма с идентификатором 
+	[oid_len]oid_der. Подписи вырабатываются на личном ключе [l / 4]privkey. 
+	При выработке ЭЦП используются долговременные параметры params 
+	и генератор rng с состоянием rng_state. Подписи вырабатываются 
+	в nthreads или меньшем числе потоков.
+	\expect{ERR_BAD_PARAMS} Параметры params корректны.
+	\expect{ERR_BAD_OID} Идентификатор oid_der корректен.
+	\expect{ERR_BAD_INPUT}
+	-	count > 0;
+	-	nthreads > 0;
+	-	буфер sigs не пересекается с буферами hashes и privkey.
+	.
+	\expect{ERR_BAD_PRIVKEY} Личный ключ privkey корректен.
+	\expect{ERR_BAD_RNG} Генератор rng (с состоянием rng_state) корректен.
+	\expect Генератор rng является криптографически стойким.
+	\return ERR_OK, если подписи выработаны, и код ошибки в противном
+	случае.
+	\remark Подписи совпадают с подписями, которые выработали бы count 
+	последовательных обращений к bignSign() с тем же генератором. Но 
+	параметры, идентификатор oid_der и личный ключ проверяются один раз, 
+	память выделяется один раз, а при выработке больших пакетов для 
+	базовой точки один раз рассчитываются предвычисленные кратные.
+	\remark Генератор rng вызывается только в вызывающем потоке.
+	\remark Если пакет не обработан, то содержимое sigs не определено.
+*/
+err_t bignSignBatch(
+	octet sigs[],				/*!< [out] подписи */
+	const bign_params* params,	/*!< [in] долговременные параметры */
+	const octet oid_der[],		/*!< [in] идентификатор хэш-алгоритма */
+	size_t oid_len,				/*!< [in] длина oid_der в октетах */
+	const octet hashes[],		/*!< [in] хэш-значения */
+	size_t count,				/*!< [in] число подписей */
+	const octet privkey[],		/*!< [in] личный ключ */
+	gen_i rng,					/*!< [in] генератор случайных чисел */
+	void* rng_state,			/*!< [in,out] состояние генератора */
+	size_t nthreads				/*!< [in] максимальное число потоков */
+);
+
 /*!	\brief Проверка ЭЦП
 
 	Проверяется ЭЦП [3 * l / 8]sig сообщения с хэш-значением [l / 4]hash. При 
@@ -401,6 +571,111 @@ err_t bignVerify(
 	const octet pubkey[]		/*!< [in] открытый ключ */
 );
 
+/*!	\brief Пакетная проверка ЭЦП
+
+	Проверяются count подписей: подпись [3 * l / 8]sigs + 3 * l / 8 * i 
+	сообщения с хэш-значением [l / 4]hashes + l / 4 * i проверяется на 
+	открытом ключе [l / 2]pubkeys + l / 2 * i (i = 0, 1,..., count - 1). 
+	Результат проверки (см. bignVerify()) записывается в rets[i]. 
+	Ошибка в одной подписи не прерывает проверку остальных. При проверке 
+	используются долговременные параметры params. Хэш-значения получены 
+	с помощью алгоритма с идентификатором [oid_len]oid_der. Подписи 
+	проверяются в nthreads или меньшем числе потоков.
+	\expect{ERR_BAD_PARAMS} Параметры params корректны.
+	\expect{ERR_BAD_INPUT}
+	-	count > 0;
+	-	nthreads > 0;
+	-	буфер [count]rets не пересекается с остальными буферами.
+	.
+	\expect{ERR_BAD_OID} Идентификатор oid_der корректен.
+	\return ERR_OK, если все подписи корректны, ERR_BAD_SIG, если хотя бы 
+	одна подпись не прошла проверку, и другой код ошибки, если пакет 
+	не обработан.
+	\remark Результаты совпадают с результатами count обращений 
+	к bignVerify(). Но параметры и идентификатор oid_der проверяются 
+	один раз, а при проверке больших пакетов для базовой точки один раз 
+	рассчитываются предвычисленные кратные.
+	\remark Подписи bign нельзя проверить совместно (с помощью случайной 
+	линейной комбинации проверочных соотношений): в подписи передается 
+	не точка R, а хэш-значение ее координаты. Поэтому каждая подпись 
+	проверяется отдельно и для определения некорректных подписей не 
+	требуется дополнительных действий.
+	\remark Если пакет не обработан из-за ошибки в oid_der или нехватки 
+	памяти, то во все элементы rets записывается соответствующий код.
+*/
+err_t bignVerifyBatch(
+	err_t rets[],				/*!< [out] результаты проверки */
+	const bign_params* params,	/*!< [in] долговременные параметры */
+	const octet oid_der[],		/*!< [in] идентификатор хэш-алгоритма */
+	size_t oid_len,				/*!< [in] длина oid_der в октетах */
+	const octet hashes[],		/*!< [in] хэш-значения */
+	const octet sigs[],			/*!< [in] подписи */
+	const octet pubkeys[],		/*!< [in] открытые ключи */
+	size_t count,				/*!< [in] число подписей */
+	size_t nthreads				/*!< [in] максимальное число потоков */
+);
+
+/*!	\brief Длина состояния предвычислений для открытого ключа
+
+	Возвращается длина состояния (в октетах) функций bignPubkeyPre(), 
+	bignVerifyPre() для уровня стойкости l.
+	\pre l == 128 || l == 192 || l == 256.
+	\return Длина состояния.
+*/
+size_t bignPubkeyPre_keep(
+	size_t l					/*!< [in] уровень стойкости */
+);
+
+/*!	\brief Предвычисления для открытого ключа
+
+	Для открытого ключа [l / 2]pubkey и базовой точки, заданной 
+	долговременными параметрами params, рассчитываются предвычисленные 
+	кратные. Кратные и сам ключ сохраняются в состоянии pre.
+	\expect{ERR_BAD_PARAMS} Параметры params корректны.
+	\expect{ERR_BAD_INPUT} Буфер pre имеет длину bignPubkeyPre_keep(l).
+	\expect{ERR_BAD_PUBKEY} Открытый ключ pubkey корректен.
+	\return ERR_OK, если предвычисления успешно выполнены, и код ошибки 
+	в противном случае.
+	\remark Предвычисления стоят примерно столько же, сколько несколько 
+	проверок подписи. Они окупаются, если на ключе pubkey проверяется 
+	много подписей.
+*/
+err_t bignPubkeyPre(
+	void* pre,					/*!< [out] состояние */
+	const bign_params* params,	/*!< [in] долговременные параметры */
+	const octet pubkey[]		/*!< [in] открытый ключ */
+);
+
+/*!	\brief Проверка ЭЦП с предвычислениями для открытого ключа
+
+	Проверяется ЭЦП [3 * l / 8]sig сообщения с хэш-значением [l / 4]hash 
+	на открытом ключе, для которого функцией bignPubkeyPre() подготовлено 
+	состояние pre. Функция повторяет bignVerify(), но использует 
+	предвычисленные кратные открытого ключа и базовой точки.
+	\expect{ERR_BAD_PARAMS} Параметры params корректны.
+	\expect{ERR_BAD_OID} Идентификатор oid_der корректен.
+	\expect{ERR_BAD_INPUT} Состояние pre подготовлено функцией 
+	bignPubkeyPre() с теми же параметрами params.
+	\return ERR_OK, если подпись корректна, и код ошибки в противном
+	случае.
+	\remark Умножения на открытый ключ и базовую точку выполняются 
+	примерно на 25% быстрее, чем в bignVerify(). Но при каждом обращении, 
+	как и в bignVerify(), по параметрам params строится описание кривой. 
+	Реализации bign128Verify(), bign192Verify(), bign256Verify() 
+	используют постоянные описания кривых и самостоятельно кэшируют 
+	предвычисления для часто используемых открытых ключей.
+	\remark Состояние pre не изменяется и может одновременно 
+	использоваться в нескольких потоках.
+*/
+err_t bignVerifyPre(
+	const bign_params* params,	/*!< [in] долговременные параметры */
+	const octet oid_der[],		/*!< [in] идентификатор хэш-алгоритма */
+	size_t oid_len,				/*!< [in] длина oid_der в октетах */
+	const octet hash[],			/*!< [in] хэш-значение */
+	const octet sig[],			/*!< [in] подпись */
+	const void* pre				/*!< [in] состояние */
+);
+
 /*
 *******************************************************************************
 Транспорт ключа
@@ -4,7 +4,7 @@
 \brief STB 34.101.45 (bign): Bign algorithms with bign-curve512v1 and bash512
 \project bee2 [cryptographic library]
 \created 2025.03.06
-\version 2025.03.06
+\version 2026.10.16
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
@@ -163,6 +163,33 @@ err_t bign256Sign2(
 	size_t t_len				/*!< [in] размер дополнительных данных */
 );
 
+/*!	\brief Пакетная выработка ЭЦП
+
+	Вырабатываются count подписей: подпись [96]sigs + 96 * i сообщения 
+	с хэш-значением [64]hashes + 64 * i (i = 0, 1,..., count - 1). 
+	Подписи вырабатываются на личном ключе privkey. При выработке ЭЦП 
+	используется генератор rng с состоянием rng_state. Подписи 
+	вырабатываются в nthreads или меньшем числе потоков.
+	\expect{ERR_BAD_INPUT} count > 0 && nthreads > 0, буфер sigs 
+	не пересекается с буферами hashes и privkey.
+	\expect{ERR_BAD_PRIVKEY} Личный ключ privkey корректен.
+	\expect{ERR_BAD_RNG} Генератор rng (с состоянием rng_state) корректен.
+	\expect Генератор rng является криптографически стойким.
+	\return ERR_OK, если подписи выработаны, и код ошибки в противном
+	случае.
+	\remark Подписи совпадают с подписями, которые выработали бы count 
+	последовательных обращений к bign256Sign() с тем же генератором.
+*/
+err_t bign256SignBatch(
+	octet sigs[],				/*!< [out] подписи */
+	const octet hashes[],		/*!< [in] хэш-значения */
+	size_t count,				/*!< [in] число подписей */
+	const octet privkey[64],	/*!< [in] личный ключ */
+	gen_i rng,					/*!< [in] генератор случайных чисел */
+	void* rng_state,			/*!< [in,out] состояние генератора */
+	size_t nthreads				/*!< [in] максимальное число потоков */
+);
+
 /*!	\brief Проверка ЭЦП
 
 	Проверяется ЭЦП sig сообщения с хэш-значением hash. При проверке
@@ -177,6 +204,30 @@ err_t bign256Verify(
 	const octet pubkey[128]		/*!< [in] открытый ключ */
 );
 
+/*!	\brief Пакетная проверка ЭЦП
+
+	Проверяются count подписей: подпись [96]sigs + 96 * i сообщения 
+	с хэш-значением [64]hashes + 64 * i проверяется на открытом ключе 
+	[128]pubkeys + 128 * i (i = 0, 1,..., count - 1). Результат проверки 
+	записывается в rets[i]. Подписи проверяются в nthreads или меньшем 
+	числе потоков.
+	\expect{ERR_BAD_INPUT} count > 0 && nthreads > 0, буфер [count]rets 
+	не пересекается с остальными буферами.
+	\return ERR_OK, если все подписи корректны, ERR_BAD_SIG, если хотя бы 
+	одна подпись не прошла проверку, и другой код ошибки, если пакет 
+	не обработан.
+	\remark Результаты совпадают с результатами count обращений 
+	к bign256Verify().
+*/
+err_t bign256VerifyBatch(
+	err_t rets[],				/*!< [out] результаты проверки */
+	const octet hashes[],		/*!< [in] хэш-значения */
+	const octet sigs[],			/*!< [in] подписи */
+	const octet pubkeys[],		/*!< [in] открытые ключи */
+	size_t count,				/*!< [in] число подписей */
+	size_t nthreads				/*!< [in] максимальное число потоков */
+);
+
 /*
 *******************************************************************************
 Транспорт ключа
@@ -4,7 +4,7 @@
 \brief Elliptic curves
 \project bee2 [cryptographic library]
 \created 2012.04.19
-\version 2026.03.13
+\version 2026.10.16
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
@@ -99,9 +99,9 @@ ec->f->from(), экспорт -- с помощью функции ec->f->to(). 
 вместе с точками.
 
 Описание эллиптической кривой включает указатели на функции арифметики 
-в группе точек этой кривой. Функции интерфейсов ec_sgn_i, ec_sgna_i,
-ec_tpl_i, ec_dbladda_i, ec_finadd_i и ec_finadda_i можно не поддерживать.
-Указатель на неподдерживаемую функцию должен быть нулевым.
+в группе точек этой кривой. Функции интерфейсов ec_toan_i, ec_sgn_i, 
+ec_sgna_i, ec_tpl_i, ec_dbladda_i, ec_finadd_i и ec_finadda_i можно 
+не поддерживать. Указатель на неподдерживаемую функцию должен быть нулевым.
 
 Описание кольца организовано как объект. Можно применять функции, описанные 
 в заголовочном файле obj.h.
@@ -186,6 +186,31 @@ typedef bool_t (*ec_toa_i)(
 	void* stack				/*!< [in] вспомогательная память */
 );
 
+/*!	\brief Экспорт в аффинные точки
+
+	По точкам [ec->d * ec->f->n]a[i] эллиптической кривой ec 
+	(i = 0, 1,..., count - 1) строятся аффинные точки [2 * ec->f->n]b[i]. 
+	Точки a[i] размещаются друг за другом в буфере 
+	[count * ec->d * ec->f->n]a, точки b[i] -- в буфере 
+	[count * 2 * ec->f->n]b.
+	\pre Описание ec работоспособно.
+	\pre Буферы a и b не пересекаются.
+	\pre Координаты a[i] лежат в базовом поле.
+	\expect Описание ec корректно.
+	\expect Точки a[i] лежат на кривой.
+	\return TRUE, если аффинные точки построены, и FALSE, если нет 
+	(некоторая точка a[i] == O). 
+	\remark Функции интерфейса выполняют одно обращение в базовом поле 
+	для всех точек (прием Монтгомери).
+*/
+typedef bool_t (*ec_toan_i)(
+	word b[],				/*!< [out] аффинные точки */
+	const word a[],			/*!< [in] входные точки */
+	size_t count,			/*!< [in] число точек */
+	const struct ec_o* ec,	/*!< [in] описание эллиптической кривой */
+	void* stack				/*!< [in] вспомогательная память */
+);
+
 /*!	\brief Обратная точка
 
 	На эллиптической кривой ec определяется точка [ec->d * ec->f->n]b, 
@@ -564,6 +589,7 @@ typedef struct ec_o
 	ec_dbladda_i dbladda;	/*!< функция удвоения со сложением с афф. точкой */
 	ec_finadd_i finadd;		/*!< функция финишного сложения */
 	ec_finadda_i finadda;	/*!< функция финишного сложения с афф. точкой */
+	ec_toan_i toan;			/*!< функция экспорта в аффинные точки */
 	size_t deep;			/*!< максимальная глубина стека функций */
 	mem_align_t descr[];	/*!< память для размещения данных */
 } ec_o;
@@ -1183,6 +1209,41 @@ bool_t ecAddMulA(
 
 size_t ecAddMulA_deep(size_t n, size_t ec_d, size_t ec_deep, size_t k,...);
 
+/*!	\brief Сумма кратных точек: массивы
+
+	Определяется точка [2n]b эллиптической кривой ec, которая является
+	суммой [m]d[i]-кратных точек [2n]a[i], i = 0, 1,.., k - 1:
+	\code
+		b <- d[0] a[0] + d[1] a[1] + ... + d[k - 1] a[k - 1].
+	\endcode
+	Точки a[i] размещаются в массиве [2n * k]a подряд, кратности d[i] -- 
+	в массиве [m * k]d подряд.
+	\pre Описание ec работоспособно.
+	\pre m > 0 && k > 0.
+	\pre Координаты точек a[i] лежат в базовом поле.
+	\pre Буфер b не пересекается с буферами a и d.
+	\expect Описание ec корректно.
+	\expect Точки a[i] лежат на ec.
+	\return TRUE, если полученная точка является аффинной, и FALSE
+	в противном случае (b == O).
+	\deep{stack} ecMulMulti_deep(ec->f->n, ec->d, ec->deep, m, k).
+	\remark В отличие от ecAddMulA(), число слагаемых k может быть большим 
+	(сотни и тысячи). При больших k вместо метода interleaving используется 
+	метод Пиппенджера.
+*/
+bool_t ecMulMulti(
+	word b[],			/*!< [out] сумма кратных точек */
+	const word a[],		/*!< [in] точки */
+	const ec_o* ec,		/*!< [in] описание кривой */
+	const word d[],		/*!< [in] кратности */
+	size_t m,			/*!< [in] длина каждой d[i] в машинных словах */
+	size_t k,			/*!< [in] число точек */
+	void* stack			/*!< [in] вспомогательная память */
+);
+
+size_t ecMulMulti_deep(size_t n, size_t ec_d, size_t ec_deep, size_t m, 
+	size_t k);
+
 #ifdef __cplusplus
 } /* extern "C" */
 #endif
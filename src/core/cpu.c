@@ -0,0 +1,128 @@
+/*
+*******************************************************************************
+\file cpu.c
+\brief Processor capabilities
+\project bee2 [cryptographic library]
+\created 2026.10.16
+\version 2026.10.16
+\copyright The Bee2 authors
+\license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
+*******************************************************************************
+*/
+
+#include "bee2/core/cpu.h"
+#include "bee2/core/mem.h"
+#include "bee2/core/mt.h"
+#include "bee2/core/util.h"
+
+#if defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+	#include <intrin.h>
+#endif
+
+/*
+*******************************************************************************
+Определение возможностей
+
+В GCC и Clang возможности x86 / x64 определяет __builtin_cpu_supports().
+Функция проверяет не только поддержку инструкций процессором, но и
+(через XGETBV) сохранение регистров YMM и ZMM операционной системой.
+В MSVC аналогичные проверки выполняются явно.
+
+Возможности ARM определяются на этапе компиляции: на платформах
+AArch64 расширение Advanced SIMD обязательно.
+*******************************************************************************
+*/
+
+static size_t _once;			/*< триггер определения */
+static size_t _caps;			/*< возможности */
+static size_t _mask = SIZE_MAX;	/*< маска возможностей */
+static size_t _epoch;			/*< редакция маски */
+
+static void cpuInit()
+{
+#if (defined(__GNUC__) || defined(__clang__)) &&\
+	(defined(__i386__) || defined(__x86_64__))
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("sse2"))
+		_caps |= CPU_SSE2;
+	if (__builtin_cpu_supports("pclmul"))
+		_caps |= CPU_PCLMUL;
+	if (__builtin_cpu_supports("avx2"))
+		_caps |= CPU_AVX2;
+	if (__builtin_cpu_supports("avx512f"))
+		_caps |= CPU_AVX512F;
+#elif defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+	int info[4];
+	int max;
+	unsigned __int64 xcr0 = 0;
+	__cpuid(info, 0);
+	max = info[0];
+	__cpuid(info, 1);
+	// SSE2? PCLMULQDQ?
+	if (info[3] & 0x04000000)
+		_caps |= CPU_SSE2;
+	if (info[2] & 0x00000002)
+		_caps |= CPU_PCLMUL;
+	// OSXSAVE && AVX?
+	if ((info[2] & 0x18000000) != 0x18000000 || max < 7)
+		return;
+	xcr0 = _xgetbv(0);
+	__cpuidex(info, 7, 0);
+	// регистры XMM / YMM сохраняются && AVX2?
+	if ((xcr0 & 6) == 6 && (info[1] & 0x00000020))
+		_caps |= CPU_AVX2;
+	// регистры XMM / YMM / ZMM сохраняются && AVX512F?
+	if ((xcr0 & 0xE6) == 0xE6 && (info[1] & 0x00010000))
+		_caps |= CPU_AVX512F;
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__) ||\
+	defined(_M_ARM64)
+	_caps |= CPU_NEON;
+#endif
+}
+
+size_t cpuCaps()
+{
+	if (!mtCallOnce(&_once, cpuInit))
+		return 0;
+	return _caps & _mask;
+}
+
+bool_t cpuHas(size_t caps)
+{
+	return (cpuCaps() & caps) == caps;
+}
+
+void cpuCapsMask(size_t mask)
+{
+	size_t prev;
+	// опубликовать маску
+	do
+		prev = _mask;
+	while (mtAtomicCmpSwap(&_mask, prev, mask) != prev);
+	// сменить редакцию
+	mtAtomicIncr(&_epoch);
+}
+
+size_t cpuCapsEpoch()
+{
+	return _epoch;
+}
+
+/*
+*******************************************************************************
+Диспетчеризация
+*******************************************************************************
+*/
+
+size_t cpuDispatch(const size_t caps[], size_t count)
+{
+	size_t have;
+	size_t i;
+	ASSERT(count > 0 && memIsValid(caps, count * sizeof(size_t)));
+	ASSERT(caps[count - 1] == 0);
+	have = cpuCaps();
+	for (i = 0; i + 1 < count; ++i)
+		if ((caps[i] & have) == caps[i])
+			break;
+	return i;
+}
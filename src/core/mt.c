@@ -4,7 +4,7 @@
 \brief Multithreading
 \project bee2 [cryptographic library]
 \created 2014.10.10
-\version 2025.04.25
+\version 2026.10.16
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
@@ -111,6 +111,107 @@ void mtMtxClose(mt_mtx_t* mtx)
 
 #endif // OS
 
+/*
+*******************************************************************************
+Условные переменные
+
+\remark Условные переменные Windows (CONDITION_VARIABLE) не требуют 
+освобождения ресурсов, поэтому mtCndClose() для Windows -- пустая операция.
+*******************************************************************************
+*/
+
+#ifdef OS_WIN
+
+bool_t mtCndCreate(mt_cnd_t* cnd)
+{
+	ASSERT(memIsValid(cnd, sizeof(mt_cnd_t)));
+	InitializeConditionVariable(cnd);
+	return TRUE;
+}
+
+void mtCndWait(mt_cnd_t* cnd, mt_mtx_t* mtx)
+{
+	ASSERT(memIsValid(cnd, sizeof(mt_cnd_t)));
+	ASSERT(mtMtxIsValid(mtx));
+	SleepConditionVariableCS(cnd, mtx, INFINITE);
+}
+
+void mtCndSignal(mt_cnd_t* cnd)
+{
+	ASSERT(memIsValid(cnd, sizeof(mt_cnd_t)));
+	WakeConditionVariable(cnd);
+}
+
+void mtCndBroadcast(mt_cnd_t* cnd)
+{
+	ASSERT(memIsValid(cnd, sizeof(mt_cnd_t)));
+	WakeAllConditionVariable(cnd);
+}
+
+void mtCndClose(mt_cnd_t* cnd)
+{
+	ASSERT(memIsValid(cnd, sizeof(mt_cnd_t)));
+}
+
+#elif defined OS_UNIX
+
+bool_t mtCndCreate(mt_cnd_t* cnd)
+{
+	ASSERT(memIsValid(cnd, sizeof(mt_cnd_t)));
+	return pthread_cond_init(cnd, 0) == 0;
+}
+
+void mtCndWait(mt_cnd_t* cnd, mt_mtx_t* mtx)
+{
+	ASSERT(memIsValid(cnd, sizeof(mt_cnd_t)));
+	ASSERT(mtMtxIsValid(mtx));
+	pthread_cond_wait(cnd, mtx);
+}
+
+void mtCndSignal(mt_cnd_t* cnd)
+{
+	ASSERT(memIsValid(cnd, sizeof(mt_cnd_t)));
+	pthread_cond_signal(cnd);
+}
+
+void mtCndBroadcast(mt_cnd_t* cnd)
+{
+	ASSERT(memIsValid(cnd, sizeof(mt_cnd_t)));
+	pthread_cond_broadcast(cnd);
+}
+
+void mtCndClose(mt_cnd_t* cnd)
+{
+	ASSERT(memIsValid(cnd, sizeof(mt_cnd_t)));
+	pthread_cond_destroy(cnd);
+}
+
+#else
+
+bool_t mtCndCreate(mt_cnd_t* cnd)
+{
+	return FALSE;
+}
+
+void mtCndWait(mt_cnd_t* cnd, mt_mtx_t* mtx)
+{
+	ASSERT(mtMtxIsValid(mtx));
+}
+
+void mtCndSignal(mt_cnd_t* cnd)
+{
+}
+
+void mtCndBroadcast(mt_cnd_t* cnd)
+{
+}
+
+void mtCndClose(mt_cnd_t* cnd)
+{
+}
+
+#endif // OS
+
 /*
 *******************************************************************************
 Потоки
@@ -119,9 +220,19 @@ void mtMtxClose(mt_mtx_t* mtx)
 функции CRYPTO_THREAD_run_once() из OpenSSL 1.1.1. Другие варианты реализации
 могут быть основаны на функциях InitOnceExecuteOnce() (WinAPI) и pthread_once()
 (<pthread.h>).
+
+Функция потока и ее аргумент передаются в создаваемый поток через 
+контекст mt_thrd_ctx, размещенный в куче. Контекст освобождается 
+в самом потоке до вызова функции.
 *******************************************************************************
 */
 
+typedef struct
+{
+	void (*fn)(void*);	/*< функция потока */
+	void* arg;			/*< аргумент функции */
+} mt_thrd_ctx;
+
 #ifdef OS_WIN
 
 void mtSleep(u32 ms)
@@ -129,6 +240,41 @@ void mtSleep(u32 ms)
 	Sleep(ms);
 }
 
+static DWORD WINAPI mtThrdMain(LPVOID arg)
+{
+	mt_thrd_ctx ctx[1];
+	memCopy(ctx, arg, sizeof(mt_thrd_ctx));
+	memFree(arg);
+	ctx->fn(ctx->arg);
+	return 0;
+}
+
+bool_t mtThrdCreate(mt_thrd_t* thrd, void (*fn)(void*), void* arg)
+{
+	mt_thrd_ctx* ctx;
+	ASSERT(memIsValid(thrd, sizeof(mt_thrd_t)));
+	// подготовить контекст
+	ctx = (mt_thrd_ctx*)memAlloc(sizeof(mt_thrd_ctx));
+	if (!ctx)
+		return FALSE;
+	ctx->fn = fn, ctx->arg = arg;
+	// создать поток
+	*thrd = CreateThread(0, 0, mtThrdMain, ctx, 0, 0);
+	if (*thrd == 0)
+	{
+		memFree(ctx);
+		return FALSE;
+	}
+	return TRUE;
+}
+
+void mtThrdJoin(mt_thrd_t* thrd)
+{
+	ASSERT(memIsValid(thrd, sizeof(mt_thrd_t)));
+	WaitForSingleObject(*thrd, INFINITE);
+	CloseHandle(*thrd);
+}
+
 #elif defined OS_UNIX
 
 #include <time.h>
@@ -142,12 +288,57 @@ void mtSleep(u32 ms)
 	nanosleep(&ts, 0);
 }
 
+static void* mtThrdMain(void* arg)
+{
+	mt_thrd_ctx ctx[1];
+	memCopy(ctx, arg, sizeof(mt_thrd_ctx));
+	memFree(arg);
+	ctx->fn(ctx->arg);
+	return 0;
+}
+
+bool_t mtThrdCreate(mt_thrd_t* thrd, void (*fn)(void*), void* arg)
+{
+	mt_thrd_ctx* ctx;
+	ASSERT(memIsValid(thrd, sizeof(mt_thrd_t)));
+	// подготовить контекст
+	ctx = (mt_thrd_ctx*)memAlloc(sizeof(mt_thrd_ctx));
+	if (!ctx)
+		return FALSE;
+	ctx->fn = fn, ctx->arg = arg;
+	// создать поток
+	if (pthread_create(thrd, 0, mtThrdMain, ctx) != 0)
+	{
+		memFree(ctx);
+		return FALSE;
+	}
+	return TRUE;
+}
+
+void mtThrdJoin(mt_thrd_t* thrd)
+{
+	ASSERT(memIsValid(thrd, sizeof(mt_thrd_t)));
+	pthread_join(*thrd, 0);
+}
+
 #else
 
 void mtSleep(u32 ms)
 {
 }
 
+bool_t mtThrdCreate(mt_thrd_t* thrd, void (*fn)(void*), void* arg)
+{
+	ASSERT(memIsValid(thrd, sizeof(mt_thrd_t)));
+	fn(arg);
+	return TRUE;
+}
+
+void mtThrdJoin(mt_thrd_t* thrd)
+{
+	ASSERT(memIsValid(thrd, sizeof(mt_thrd_t)));
+}
+
 #endif // OS
 
 bool_t mtCallOnce(size_t* once, void (*fn)())
@@ -4,7 +4,7 @@
 \brief STB 34.101.77 (bash): bash-f
 \project bee2 [cryptographic library]
 \created 2019.06.25
-\version 2023.02.02
+\version 2026.10.16
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
@@ -23,22 +23,123 @@
 	#define __SSE2__
 #endif
 
-#if defined(__AVX512F__) && defined(BASH_AVX512)
+#include "bee2/crypto/bash.h"
+#include "bash_lcl.h"
+
+#if defined(BASH_FAT)
+	#include "bee2/core/cpu.h"
+	#include "bee2/core/util.h"
+	const char bash_platform[] = "BASH_FAT";
+#elif defined(__AVX512F__) && defined(BASH_AVX512)
 	#include "bash_favx512.c"
+	#define bashFImpl bashF_avx512
+	#define bashFImpl_deep bashF_avx512_deep
 	const char bash_platform[] = "BASH_AVX512";
 #elif defined(__AVX2__) && defined(BASH_AVX2)
 	#include "bash_favx2.c"
+	#define bashFImpl bashF_avx2
+	#define bashFImpl_deep bashF_avx2_deep
 	const char bash_platform[] = "BASH_AVX2";
 #elif defined(__SSE2__) && defined(BASH_SSE2)
 	#include "bash_fsse2.c"
+	#define bashFImpl bashF_sse2
+	#define bashFImpl_deep bashF_sse2_deep
 	const char bash_platform[] = "BASH_SSE2";
 #elif defined(__ARM_NEON__) && defined(BASH_NEON)
 	#include "bash_fneon.c"
+	#define bashFImpl bashF_neon
+	#define bashFImpl_deep bashF_neon_deep
 	const char bash_platform[] = "BASH_NEON";
 #elif !defined(U64_SUPPORT) || defined(BASH_32)
 	#include "bash_f32.c"
+	#define bashFImpl bashF_32
+	#define bashFImpl_deep bashF_32_deep
 	const char bash_platform[] = "BASH_32";
 #else
 	#include "bash_f64.c"
+	#define bashFImpl bashF_64
+	#define bashFImpl_deep bashF_64_deep
 	const char bash_platform[] = "BASH_64";
 #endif
+
+/*
+*******************************************************************************
+Толстая сборка
+
+Реализации bash_f64.c, bash_favx2.c, bash_favx512.c компилируются 
+в отдельных единицах трансляции с флагами соответствующих платформ 
+(см. src/CMakeLists.txt).
+
+Реализация BASH_SSE2 в толстую сборку не включается: на платформе x64 
+она медленнее BASH_64.
+
+Номер выбранной реализации кэшируется в переменной _sel вместе с номером 
+редакции маски возможностей (см. cpuCapsEpoch()). Реализация выбирается 
+заново (с помощью cpuDispatch()) только после вызова cpuCapsMask(). 
+Значение _sel записывается и читается целиком, поэтому потоки, которые 
+одновременно выбирают реализацию, получают согласованные результаты.
+*******************************************************************************
+*/
+
+#if defined(BASH_FAT)
+
+static const size_t _caps[] = 
+{
+	CPU_AVX512F, CPU_AVX2, 0
+};
+
+static void (* const _fs[])(octet[192], void*) = 
+{
+	bashF_avx512, bashF_avx2, bashF_64
+};
+
+static const char* const _platforms[] = 
+{
+	"BASH_AVX512", "BASH_AVX2", "BASH_64"
+};
+
+static size_t _sel = SIZE_MAX;	/*< (редакция маски << 2) | номер */
+
+static size_t bashFSel()
+{
+	const size_t epoch = cpuCapsEpoch() << 2;
+	register size_t sel = _sel;
+	if ((sel & ~(size_t)3) != epoch)
+		_sel = sel = epoch | cpuDispatch(_caps, COUNT_OF(_caps));
+	return sel & 3;
+}
+
+void bashF(octet block[192], void* stack)
+{
+	_fs[bashFSel()](block, stack);
+}
+
+size_t bashF_deep()
+{
+	return utilMax(3, bashF_avx512_deep(), bashF_avx2_deep(), 
+		bashF_64_deep());
+}
+
+const char* bashPlatform()
+{
+	return _platforms[bashFSel()];
+}
+
+#else
+
+void bashF(octet block[192], void* stack)
+{
+	bashFImpl(block, stack);
+}
+
+size_t bashF_deep()
+{
+	return bashFImpl_deep();
+}
+
+const char* bashPlatform()
+{
+	return bash_platform;
+}
+
+#endif
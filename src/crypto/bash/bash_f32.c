@@ -4,7 +4,7 @@
 \brief STB 34.101.77 (bash): bash-f optimized for 32-bit platforms
 \project bee2 [cryptographic library]
 \created 2019.04.03
-\version 2025.10.06
+\version 2026.10.16
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
@@ -14,6 +14,7 @@
 #include "bee2/core/u32.h"
 #include "bee2/core/util.h"
 #include "bee2/crypto/bash.h"
+#include "bash_lcl.h"
 
 /*
 *******************************************************************************
@@ -245,11 +246,11 @@ static void bashF0(u32 s[3][8][2], void* stack)
 	bashR(s5);  bashC(s0, 24);
 }
 
-void bashF(octet block[192], void* stack)
+void bashF_32(octet block[192], void* stack)
 {
 	size_t i, j;
 	u32 (*s)[3][8][2];
-	ASSERT(memIsDisjoint2(block, 192, stack, bashF_deep()));
+	ASSERT(memIsDisjoint2(block, 192, stack, bashF_32_deep()));
 	ASSERT(memIsAligned(block, 4));
 	s = (u32(*)[3][8][2])block;
 #if (OCTET_ORDER == BIG_ENDIAN)
@@ -267,7 +268,7 @@ void bashF(octet block[192], void* stack)
 #endif
 }
 
-size_t bashF_deep()
+size_t bashF_32_deep()
 {
 	return sizeof(u32) * 2 * 3;
 }
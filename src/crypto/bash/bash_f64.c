@@ -4,7 +4,7 @@
 \brief STB 34.101.77 (bash): bash-f
 \project bee2 [cryptographic library]
 \created 2014.07.15
-\version 2025.10.03
+\version 2026.10.16
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
@@ -14,6 +14,7 @@
 #include "bee2/core/u64.h"
 #include "bee2/core/util.h"
 #include "bee2/crypto/bash.h"
+#include "bash_lcl.h"
 
 /*
 *******************************************************************************
@@ -171,10 +172,10 @@ static void bashF0(u64 s[24])
 	CLEAN3(t0, t1, t2);
 }
 
-void bashF(octet block[192], void* stack)
+void bashF_64(octet block[192], void* stack)
 {
 	u64* s;
-	ASSERT(memIsDisjoint2(block, 192, stack, bashF_deep()));
+	ASSERT(memIsDisjoint2(block, 192, stack, bashF_64_deep()));
 	ASSERT(memIsAligned(block, 8));
 	s = (u64*)block;
 #if (OCTET_ORDER == BIG_ENDIAN)
@@ -186,7 +187,7 @@ void bashF(octet block[192], void* stack)
 #endif
 }
 
-size_t bashF_deep()
+size_t bashF_64_deep()
 {
 	return 0;
 }
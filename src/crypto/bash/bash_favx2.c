@@ -4,7 +4,7 @@
 \brief STB 34.101.77 (bash): bash-f optimized for AVX2
 \project bee2 [cryptographic library]
 \created 2019.04.03
-\version 2025.10.06
+\version 2026.10.16
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
@@ -14,6 +14,8 @@
 	#error "The compiler does not support AVX2 intrinsics"
 #endif
 
+#include "bee2/defs.h"
+
 #if (OCTET_ORDER == BIG_ENDIAN)
 	#error "AVX2 contradicts big-endianness"
 #endif
@@ -23,6 +25,7 @@
 #include "bee2/core/mem.h"
 #include "bee2/core/util.h"
 #include "bee2/crypto/bash.h"
+#include "bash_lcl.h"
 
 /*
 *******************************************************************************
@@ -309,7 +312,7 @@ Bash-f
 	bashR0(23);\
 	bashR1(24)
 
-void bashF(octet block[192], void* stack)
+void bashF_avx2(octet block[192], void* stack)
 {
 	register __m256i Z1, Z2, T0, T1, T2, U0, U1, U2;
 	register __m256i W0, W1, W2, W3, W4, W5;
@@ -330,7 +333,7 @@ void bashF(octet block[192], void* stack)
 	ZEROALL;
 }
 
-size_t bashF_deep()
+size_t bashF_avx2_deep()
 {
 	return 0;
 }
@@ -5,7 +5,7 @@
 \remark AVX512 is interpreted here only as AVX512F
 \project bee2 [cryptographic library]
 \created 2019.04.03
-\version 2025.10.06
+\version 2026.10.16
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
@@ -21,6 +21,8 @@
 	#error "The compiler does not support AVX512 intrinsics"
 #endif
 
+#include "bee2/defs.h"
+
 #if (OCTET_ORDER == BIG_ENDIAN)
 	#error "AVX512 contradicts big-endianness"
 #endif
@@ -30,6 +32,7 @@
 #include "bee2/core/mem.h"
 #include "bee2/core/util.h"
 #include "bee2/crypto/bash.h"
+#include "bash_lcl.h"
 
 /*
 *******************************************************************************
@@ -233,7 +236,7 @@ Bash-f
 	bashR1(23);\
 	bashR2(24)
 
-void bashF(octet block[192], void* stack)
+void bashF_avx512(octet block[192], void* stack)
 {
 	register __m512i U0, U1, U2;
 	register __m512i W0, W1, W2;
@@ -248,7 +251,7 @@ void bashF(octet block[192], void* stack)
 	ZEROALL;
 }
 
-size_t bashF_deep()
+size_t bashF_avx512_deep()
 {
 	return 0;
 }
@@ -0,0 +1,129 @@
+/*
+*******************************************************************************
+\file bash_fn.c
+\brief STB 34.101.77 (bash): bash-f on several states
+\project bee2 [cryptographic library]
+\created 2026.10.16
+\version 2026.10.16
+\copyright The Bee2 authors
+\license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
+*******************************************************************************
+*/
+
+#include "bee2/core/cpu.h"
+#include "bee2/core/mem.h"
+#include "bee2/core/u64.h"
+#include "bee2/core/util.h"
+#include "bee2/crypto/bash.h"
+#include "bash_lcl.h"
+
+/*
+*******************************************************************************
+Послойные состояния
+
+В послойном представлении k состояний 64-битовое слово i состояния j
+(октеты 8i,..., 8i + 7 состояния) размещается по смещению 8(ki + j).
+Если векторная реализация недоступна, то состояния по очереди
+извлекаются из послойного представления и обрабатываются функцией
+bashF().
+*******************************************************************************
+*/
+
+static void bashFLanes(octet blocks[], size_t k, void* stack)
+{
+	u64 s[24];
+	size_t i, j;
+	for (j = 0; j < k; ++j)
+	{
+		for (i = 0; i < 24; ++i)
+			memCopy(s + i, blocks + 8 * (k * i + j), 8);
+		bashF((octet*)s, stack);
+		for (i = 0; i < 24; ++i)
+			memCopy(blocks + 8 * (k * i + j), s + i, 8);
+	}
+	memWipe(s, sizeof(s));
+}
+
+void bashF4(octet blocks[768], void* stack)
+{
+	ASSERT(memIsDisjoint2(blocks, 768, stack, bashF_deep()));
+#ifdef BASH_FN_AVX2
+	if (cpuHas(CPU_AVX2))
+	{
+		bashF4_avx2(blocks);
+		return;
+	}
+#endif
+	bashFLanes(blocks, 4, stack);
+}
+
+void bashF8(octet blocks[1536], void* stack)
+{
+	ASSERT(memIsDisjoint2(blocks, 1536, stack, bashF_deep()));
+#ifdef BASH_FN_AVX512
+	if (cpuHas(CPU_AVX512F))
+	{
+		bashF8_avx512(blocks);
+		return;
+	}
+#endif
+	bashFLanes(blocks, 8, stack);
+}
+
+/*
+*******************************************************************************
+Порции состояний
+
+Функция bashFN() выбирает число k состояний в порции: 8, если bashF8()
+реализуется векторными командами, 4, если векторными командами
+реализуется bashF4(), и 1 в остальных случаях. Неполные порции
+дополняются нулевыми состояниями. Порция из одного состояния
+обрабатывается функцией bashF() напрямую.
+*******************************************************************************
+*/
+
+static size_t bashFN_k()
+{
+#ifdef BASH_FN_AVX512
+	if (cpuHas(CPU_AVX512F))
+		return 8;
+#endif
+#ifdef BASH_FN_AVX2
+	if (cpuHas(CPU_AVX2))
+		return 4;
+#endif
+	return 1;
+}
+
+void bashFN(octet* s[], size_t n, void* stack)
+{
+	u64 blocks[24 * 8];
+	size_t k = bashFN_k();
+	size_t i, j, m;
+	for (; n; n -= m, s += m)
+	{
+		m = MIN2(n, k);
+		if (m == 1)
+		{
+			bashF(s[0], stack);
+			continue;
+		}
+		// собрать порцию
+		if (m < k)
+			memSetZero(blocks, 24 * k * 8);
+		for (j = 0; j < m; ++j)
+		{
+			ASSERT(memIsAligned(s[j], 8));
+			for (i = 0; i < 24; ++i)
+				blocks[k * i + j] = ((const u64*)s[j])[i];
+		}
+		// обработать порцию
+		(k == 8) ? bashF8((octet*)blocks, stack) :
+			bashF4((octet*)blocks, stack);
+		// распределить результаты
+		for (j = 0; j < m; ++j)
+			for (i = 0; i < 24; ++i)
+				((u64*)s[j])[i] = blocks[k * i + j];
+	}
+	memWipe(blocks, sizeof(blocks));
+}
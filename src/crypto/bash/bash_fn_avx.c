@@ -0,0 +1,254 @@
+/*
+*******************************************************************************
+\file bash_fn_avx.c
+\brief STB 34.101.77 (bash): bash-f on several states using AVX2 / AVX512
+\project bee2 [cryptographic library]
+\created 2026.10.16
+\version 2026.10.16
+\copyright The Bee2 authors
+\license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
+*******************************************************************************
+*/
+
+#include "bee2/core/mem.h"
+#include "bee2/core/util.h"
+#include "bee2/crypto/bash.h"
+#include "bash_lcl.h"
+
+#if defined(BASH_FN_AVX2) || defined(BASH_FN_AVX512)
+
+#include <immintrin.h>
+
+/*
+*******************************************************************************
+Послойная обработка
+
+Состояния bash-f размещаются послойно: i-е 64-битовые слова всех 
+состояний собираются в одном векторном регистре (4 слова в 256-разрядном 
+регистре AVX2, 8 слов в 512-разрядном регистре AVX512). После этого 
+такты bash-f выполняются одновременно над всеми состояниями по схеме 
+bash_f64.c: циклические сдвиги в каждом слове S-блока одинаковы для всех 
+состояний.
+
+Макрос bashS повторяет одноименный макрос bash_f64.c. Векторные операции 
+задаются макросами X (сложение), O (дизъюнкция), A (конъюнкция), 
+NO (дизъюнкция с отрицанием первого операнда), ROT (циклический сдвиг 
+в сторону старших разрядов), C (константа). Макросы переопределяются 
+для каждой платформы.
+*******************************************************************************
+*/
+
+#define bashS(w0, w1, w2, m1, n1, m2, n2, t0, t1, t2)\
+	t2 = ROT(w0, m1),\
+	w0 = X(w0, X(w1, w2)),\
+	t1 = X(w1, ROT(w0, n1)),\
+	w1 = X(t1, t2),\
+	w2 = X(w2, X(ROT(w2, m2), ROT(t1, n2))),\
+	t1 = O(w0, w2),\
+	t2 = A(w0, w1),\
+	t0 = NO(w2, w1),\
+	w0 = X(w0, t0),\
+	w1 = X(w1, t1),\
+	w2 = X(w2, t2)\
+
+/*
+*******************************************************************************
+Тактовые константы
+
+Рассчитаны с помощью следующей программы:
+\code
+	const u64 A = 0xDC2BE1997FE0D8AE;
+	u64 C[24];
+	C[0] = 0x3BF5080AC8BA94B1;
+	for (size_t t = 1; t < 24; ++t)
+		C[t] = (C[t - 1] >> 1) ^ (A & 0 - (C[t - 1] & 1));
+\endcode
+*******************************************************************************
+*/
+
+#define c1  0x3BF5080AC8BA94B1ull
+#define c2  0xC1D1659C1BBD92F6ull
+#define c3  0x60E8B2CE0DDEC97Bull
+#define c4  0xEC5FB8FE790FBC13ull
+#define c5  0xAA043DE6436706A7ull
+#define c6  0x8929FF6A5E535BFDull
+#define c7  0x98BF1E2C50C97550ull
+#define c8  0x4C5F8F162864BAA8ull
+#define c9  0x262FC78B14325D54ull
+#define c10 0x1317E3C58A192EAAull
+#define c11 0x098BF1E2C50C9755ull
+#define c12 0xD8EE19681D669304ull
+#define c13 0x6C770CB40EB34982ull
+#define c14 0x363B865A0759A4C1ull
+#define c15 0xC73622B47C4C0ACEull
+#define c16 0x639B115A3E260567ull
+#define c17 0xEDE6693460F3DA1Dull
+#define c18 0xAAD8D5034F9935A0ull
+#define c19 0x556C6A81A7CC9AD0ull
+#define c20 0x2AB63540D3E64D68ull
+#define c21 0x155B1AA069F326B4ull
+#define c22 0x0AAD8D5034F9935Aull
+#define c23 0x0556C6A81A7CC9ADull
+#define c24 0xDE8082CD72DEBC78ull
+
+/*
+*******************************************************************************
+Перестановка P
+
+Перестановка P переносит слово из позиции P(x) в позицию x.
+
+Макросы Pi задают действие перестановки P^i. Значение Pi(x) указывает, 
+какое первоначальное слово будет в позиции x после i тактов.
+
+\warning Рекурсия P_i(x) = P_1(P_{i - 1}(x)) в VS09 работает только 
+до глубины 4. Дальше препроцессор не справляется.
+*******************************************************************************
+*/
+
+#define P0(x) x
+
+#define P1(x)\
+	((x < 8) ? 8 + (x + 2 * (x & 1) + 7) % 8 :\
+		((x < 16) ? 8 + (x ^ 1) : (5 * x + 6) % 8))
+
+#define P2(x) P1(P1(x))
+
+#define P3(x)\
+	(8 * (x / 8) + ( x % 8 + 4) % 8)
+
+#define P4(x) P1(P3(x))
+#define P5(x) P2(P3(x))
+
+/*
+*******************************************************************************
+Такт (см. bash_f64.c)
+*******************************************************************************
+*/
+
+#define bashR(s, p, p_next, i, t0, t1, t2)\
+	bashS(s[p( 0)], s[p( 8)], s[p(16)],  8, 53, 14,  1, t0, t1, t2);\
+	bashS(s[p( 1)], s[p( 9)], s[p(17)], 56, 51, 34,  7, t0, t1, t2);\
+	bashS(s[p( 2)], s[p(10)], s[p(18)],  8, 37, 46, 49, t0, t1, t2);\
+	bashS(s[p( 3)], s[p(11)], s[p(19)], 56,  3,  2, 23, t0, t1, t2);\
+	bashS(s[p( 4)], s[p(12)], s[p(20)],  8, 21, 14, 33, t0, t1, t2);\
+	bashS(s[p( 5)], s[p(13)], s[p(21)], 56, 19, 34, 39, t0, t1, t2);\
+	bashS(s[p( 6)], s[p(14)], s[p(22)],  8,  5, 46, 17, t0, t1, t2);\
+	bashS(s[p( 7)], s[p(15)], s[p(23)], 56, 35,  2, 55, t0, t1, t2);\
+	s[p_next(23)] = X(s[p_next(23)], C(c##i))
+
+#define bashF0(s, t0, t1, t2)\
+	bashR(s, P0, P1,  1, t0, t1, t2);\
+	bashR(s, P1, P2,  2, t0, t1, t2);\
+	bashR(s, P2, P3,  3, t0, t1, t2);\
+	bashR(s, P3, P4,  4, t0, t1, t2);\
+	bashR(s, P4, P5,  5, t0, t1, t2);\
+	bashR(s, P5, P0,  6, t0, t1, t2);\
+	bashR(s, P0, P1,  7, t0, t1, t2);\
+	bashR(s, P1, P2,  8, t0, t1, t2);\
+	bashR(s, P2, P3,  9, t0, t1, t2);\
+	bashR(s, P3, P4, 10, t0, t1, t2);\
+	bashR(s, P4, P5, 11, t0, t1, t2);\
+	bashR(s, P5, P0, 12, t0, t1, t2);\
+	bashR(s, P0, P1, 13, t0, t1, t2);\
+	bashR(s, P1, P2, 14, t0, t1, t2);\
+	bashR(s, P2, P3, 15, t0, t1, t2);\
+	bashR(s, P3, P4, 16, t0, t1, t2);\
+	bashR(s, P4, P5, 17, t0, t1, t2);\
+	bashR(s, P5, P0, 18, t0, t1, t2);\
+	bashR(s, P0, P1, 19, t0, t1, t2);\
+	bashR(s, P1, P2, 20, t0, t1, t2);\
+	bashR(s, P2, P3, 21, t0, t1, t2);\
+	bashR(s, P3, P4, 22, t0, t1, t2);\
+	bashR(s, P4, P5, 23, t0, t1, t2);\
+	bashR(s, P5, P0, 24, t0, t1, t2)
+
+/*
+*******************************************************************************
+Четыре состояния (AVX2)
+
+В AVX2 нет циклических сдвигов 64-битовых слов, они выполняются двумя 
+сдвигами и дизъюнкцией.
+*******************************************************************************
+*/
+
+#ifdef BASH_FN_AVX2
+
+#define X(W1, W2) _mm256_xor_si256(W1, W2)
+#define O(W1, W2) _mm256_or_si256(W1, W2)
+#define A(W1, W2) _mm256_and_si256(W1, W2)
+#define NO(W1, W2) _mm256_or_si256(_mm256_xor_si256(W1, ONES), W2)
+#define ROT(W, m)\
+	_mm256_or_si256(_mm256_slli_epi64(W, m), _mm256_srli_epi64(W, 64 - (m)))
+#define C(c) _mm256_set1_epi64x((long long)(c))
+
+BASH_AVX2_TARGET
+void bashF4_avx2(octet blocks[768])
+{
+	__m256i s[24];
+	__m256i t0, t1, t2;
+	__m256i ONES;
+	size_t i;
+	ASSERT(memIsValid(blocks, 768));
+	ONES = _mm256_set1_epi32(-1);
+	for (i = 0; i < 24; ++i)
+		s[i] = _mm256_loadu_si256((const __m256i*)(blocks + 32 * i));
+	bashF0(s, t0, t1, t2);
+	for (i = 0; i < 24; ++i)
+		_mm256_storeu_si256((__m256i*)(blocks + 32 * i), s[i]);
+	_mm256_zeroall();
+	memWipe(s, sizeof(s));
+}
+
+#undef X
+#undef O
+#undef A
+#undef NO
+#undef ROT
+#undef C
+
+#endif /* BASH_FN_AVX2 */
+
+/*
+*******************************************************************************
+Восемь состояний (AVX512)
+
+Дизъюнкция с отрицанием выполняется одной командой vpternlogq: 
+таблица истинности ~a | b равна 0xCF (a -- первый, b -- второй операнд, 
+третий операнд не используется).
+*******************************************************************************
+*/
+
+#ifdef BASH_FN_AVX512
+
+#define X(W1, W2) _mm512_xor_si512(W1, W2)
+#define O(W1, W2) _mm512_or_si512(W1, W2)
+#define A(W1, W2) _mm512_and_si512(W1, W2)
+#define NO(W1, W2) _mm512_ternarylogic_epi64(W1, W2, W2, 0xCF)
+#define ROT(W, m) _mm512_rol_epi64(W, m)
+#define C(c) _mm512_set1_epi64((long long)(c))
+
+BASH_AVX512_TARGET
+void bashF8_avx512(octet blocks[1536])
+{
+	__m512i s[24];
+	__m512i t0, t1, t2;
+	size_t i;
+	ASSERT(memIsValid(blocks, 1536));
+	for (i = 0; i < 24; ++i)
+		s[i] = _mm512_loadu_si512((const void*)(blocks + 64 * i));
+	bashF0(s, t0, t1, t2);
+	for (i = 0; i < 24; ++i)
+		_mm512_storeu_si512((void*)(blocks + 64 * i), s[i]);
+	memWipe(s, sizeof(s));
+}
+
+#undef X
+#undef O
+#undef A
+#undef NO
+#undef ROT
+#undef C
+
+#endif /* BASH_FN_AVX512 */
+
+#endif /* BASH_FN_AVX2 || BASH_FN_AVX512 */
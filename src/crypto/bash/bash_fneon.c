@@ -4,7 +4,7 @@
 \brief STB 34.101.77 (bash): bash-f optimized for ARM NEON
 \project bee2 [cryptographic library]
 \created 2020.10.26
-\version 2025.10.10
+\version 2026.10.16
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
@@ -19,6 +19,7 @@
 #include "bee2/core/mem.h"
 #include "bee2/core/util.h"
 #include "bee2/crypto/bash.h"
+#include "bash_lcl.h"
 
 /*
 *******************************************************************************
@@ -348,7 +349,7 @@ Bash-f
 typedef size_t uintptr_t;
 #endif
 
-void bashF(octet block[192], void* stack)
+void bashF_neon(octet block[192], void* stack)
 {
 	octet* block2 = (octet*)((((uintptr_t)stack) + 7) & ~((uintptr_t)7));
 	memCopy(block2, block, 192);
@@ -356,7 +357,7 @@ void bashF(octet block[192], void* stack)
 	memCopy(block, block2, 192);
 }
 
-size_t bashF_deep()
+size_t bashF_neon_deep()
 {
 	return 192 + 8;
 }
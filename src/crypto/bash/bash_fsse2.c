@@ -4,7 +4,7 @@
 \brief STB 34.101.77 (bash): bash-f optimized for SSE2
 \project bee2 [cryptographic library]
 \created 2019.07.12
-\version 2025.10.06
+\version 2026.10.16
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
@@ -23,6 +23,7 @@
 #include "bee2/core/mem.h"
 #include "bee2/core/util.h"
 #include "bee2/crypto/bash.h"
+#include "bash_lcl.h"
 
 /*
 *******************************************************************************
@@ -349,7 +350,7 @@ Bash-f
 	bashR0(23);\
 	bashR1(24)
 
-void bashF(octet block[192], void* stack)
+void bashF_sse2(octet block[192], void* stack)
 {
 	register __m128i Z1, Z2, T0, T1, T2, U0, U1, U2;
 	register __m128i W0, W1, W2, W3, W4, W5, W6, W7, W8, W9, W10, W11;
@@ -383,7 +384,7 @@ void bashF(octet block[192], void* stack)
 	W0 = W1 = W2 = W3 = W4 = W5 = W6 = W7 = W8 = W9 = W10 = W11 = ZERO;
 }
 
-size_t bashF_deep()
+size_t bashF_sse2_deep()
 {
 	return 0;
 }
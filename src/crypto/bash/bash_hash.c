@@ -4,7 +4,7 @@
 \brief STB 34.101.77 (bash): hashing algorithms
 \project bee2 [cryptographic library]
 \created 2014.07.15
-\version 2025.09.23
+\version 2026.10.16
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
@@ -15,6 +15,7 @@
 #include "bee2/core/mem.h"
 #include "bee2/core/util.h"
 #include "bee2/crypto/bash.h"
+#include "bash_lcl.h"
 
 /*
 *******************************************************************************
@@ -135,3 +136,174 @@ err_t bashHash(octet hash[], size_t l, const void* src, size_t count)
 	blobClose(state);
 	return ERR_OK;
 }
+
+/*
+*******************************************************************************
+Хэширование нескольких сообщений
+
+Состояние каждого сообщения (bash_hash_lane) повторяет состояние 
+bash_hash_st. Дополнительно в поля buf и count записывается 
+необработанная часть фрагмента, переданного в bashHashMultiStepH().
+
+Sponge-функция применяется порциями до BASH_HASH_MULTI_N состояний 
+функцией bashFN(). В порцию включаются сообщения, для которых накоплен 
+полный блок. Сообщения просматриваются по кругу, начиная с позиции, 
+на которой остановился предыдущий просмотр. Поэтому порции остаются 
+полными, пока полные блоки есть хотя бы у BASH_HASH_MULTI_N сообщений.
+
+Стек bashFN() размещается в состоянии после состояний сообщений.
+*******************************************************************************
+*/
+
+#define BASH_HASH_MULTI_N 8
+
+typedef struct {
+	octet s[192];			/*< состояние */
+	octet s1[192];			/*< копия s */
+	size_t buf_len;			/*< длина буфера */
+	size_t pos;				/*< позиция в буфере (накоплено октетов) */
+	const octet* buf;		/*< необработанные данные */
+	size_t count;			/*< число октетов необработанных данных */
+} bash_hash_lane;
+
+typedef struct {
+	size_t n;				/*< число сообщений */
+	mem_align_t data[];		/*< [n]bash_hash_lane || стек bashFN */
+} bash_hash_multi_st;
+
+size_t bashHashMulti_keep(size_t n)
+{
+	ASSERT(n <= (SIZE_MAX - sizeof(bash_hash_multi_st) - bashF_deep()) /
+		sizeof(bash_hash_lane));
+	return sizeof(bash_hash_multi_st) + n * sizeof(bash_hash_lane) + 
+		bashF_deep();
+}
+
+void bashHashMultiStart(void* state, size_t l, size_t n)
+{
+	bash_hash_multi_st* st = (bash_hash_multi_st*)state;
+	bash_hash_lane* lanes = (bash_hash_lane*)st->data;
+	size_t i;
+	ASSERT(l > 0 && l % 16 == 0 && l <= 256);
+	ASSERT(memIsValid(state, bashHashMulti_keep(n)));
+	st->n = n;
+	for (i = 0; i < n; ++i)
+	{
+		// s <- 0^{1536 - 64} || <l / 4>_{64}
+		memSetZero(lanes[i].s, sizeof(lanes[i].s));
+		lanes[i].s[192 - 8] = (octet)(l / 4);
+		// длина блока
+		lanes[i].buf_len = 192 - l / 2;
+		// нет накопленнных октетов
+		lanes[i].pos = 0;
+	}
+}
+
+void bashHashMultiStepH(const void* buf[], const size_t count[], void* state)
+{
+	bash_hash_multi_st* st = (bash_hash_multi_st*)state;
+	bash_hash_lane* lanes = (bash_hash_lane*)st->data;
+	octet* s[BASH_HASH_MULTI_N];
+	size_t pos, i, m;
+	ASSERT(memIsValid(state, sizeof(bash_hash_multi_st)));
+	ASSERT(memIsValid(state, bashHashMulti_keep(st->n)));
+	ASSERT(memIsValid(buf, st->n * sizeof(const void*)));
+	ASSERT(memIsValid(count, st->n * sizeof(size_t)));
+	// запомнить фрагменты
+	for (i = 0; i < st->n; ++i)
+	{
+		ASSERT(memIsDisjoint2(buf[i], count[i], 
+			state, bashHashMulti_keep(st->n)));
+		lanes[i].buf = (const octet*)buf[i];
+		lanes[i].count = count[i];
+	}
+	// цикл по порциям полных блоков
+	for (pos = 0;;)
+	{
+		// собрать порцию
+		for (i = m = 0; i < st->n && m < BASH_HASH_MULTI_N; 
+			++i, pos = (pos + 1) % st->n)
+		{
+			bash_hash_lane* lane = lanes + pos;
+			size_t t = lane->buf_len - lane->pos;
+			if (lane->count < t)
+				continue;
+			memCopy(lane->s + lane->pos, lane->buf, t);
+			lane->buf += t, lane->count -= t, lane->pos = 0;
+			s[m++] = lane->s;
+		}
+		// нет полных блоков?
+		if (m == 0)
+			break;
+		// применить sponge-функцию
+		bashFN(s, m, lanes + st->n);
+	}
+	// сохранить неполные блоки
+	for (i = 0; i < st->n; ++i)
+	{
+		bash_hash_lane* lane = lanes + i;
+		ASSERT(lane->pos + lane->count < lane->buf_len);
+		memCopy(lane->s + lane->pos, lane->buf, lane->count);
+		lane->pos += lane->count;
+		lane->buf = 0, lane->count = 0;
+	}
+}
+
+void bashHashMultiStepG(octet hash[], size_t hash_len, void* state)
+{
+	bash_hash_multi_st* st = (bash_hash_multi_st*)state;
+	bash_hash_lane* lanes = (bash_hash_lane*)st->data;
+	octet* s[BASH_HASH_MULTI_N];
+	size_t i, m;
+	ASSERT(memIsValid(state, sizeof(bash_hash_multi_st)));
+	ASSERT(memIsValid(state, bashHashMulti_keep(st->n)));
+	ASSERT(memIsValid(hash, hash_len * st->n));
+	// последние блоки
+	for (i = m = 0; i < st->n; ++i)
+	{
+		bash_hash_lane* lane = lanes + i;
+		ASSERT(lane->buf_len + hash_len * 2 <= 192);
+		memCopy(lane->s1, lane->s, sizeof(lane->s));
+		memSetZero(lane->s1 + lane->pos, lane->buf_len - lane->pos);
+		lane->s1[lane->pos] = 0x40;
+		s[m++] = lane->s1;
+		if (m == BASH_HASH_MULTI_N)
+			bashFN(s, m, lanes + st->n), m = 0;
+	}
+	if (m)
+		bashFN(s, m, lanes + st->n);
+	// выгрузить хэш-значения
+	for (i = 0; i < st->n; ++i)
+		memCopy(hash + hash_len * i, lanes[i].s1, hash_len);
+}
+
+err_t bashHashMulti(octet hash[], size_t l, const void* src[], 
+	const size_t count[], size_t n)
+{
+	void* state;
+	size_t i;
+	// проверить входные данные
+	if (l == 0 || l % 16 != 0 || l > 256)
+		return ERR_BAD_PARAMS;
+	if (n > (SIZE_MAX - sizeof(bash_hash_multi_st) - bashF_deep()) /
+			sizeof(bash_hash_lane) ||
+		n > SIZE_MAX / (l / 4) ||
+		!memIsValid(src, n * sizeof(const void*)) ||
+		!memIsValid(count, n * sizeof(size_t)) ||
+		!memIsValid(hash, l / 4 * n))
+		return ERR_BAD_INPUT;
+	for (i = 0; i < n; ++i)
+		if (!memIsValid(src[i], count[i]))
+			return ERR_BAD_INPUT;
+	// создать состояние
+	state = blobCreate(bashHashMulti_keep(n));
+	if (state == 0)
+		return ERR_OUTOFMEMORY;
+	// вычислить хэш-значения
+	bashHashMultiStart(state, l, n);
+	bashHashMultiStepH(src, count, state);
+	bashHashMultiStepG(hash, l / 4, state);
+	// завершить
+	blobClose(state);
+	return ERR_OK;
+}
@@ -0,0 +1,106 @@
+/*
+*******************************************************************************
+\file bash_lcl.h
+\brief STB 34.101.77 (bash): local definitions
+\project bee2 [cryptographic library]
+\created 2026.10.16
+\version 2026.10.16
+\copyright The Bee2 authors
+\license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
+*******************************************************************************
+*/
+
+#ifndef __BASH_LCL_H
+#define __BASH_LCL_H
+
+#include "bee2/defs.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+*******************************************************************************
+Реализации bash-f
+
+Функции bashF_XXX() и bashF_XXX_deep() реализуют bashF() и bashF_deep() 
+на платформе BASH_XXX (файл bash_fXXX.c, XXX = 32, 64, sse2, avx2, avx512, 
+neon). В обычной сборке реализация выбранной платформы подключается 
+в bash_f.c. В толстой сборке (BASH_FAT) файлы bash_f64.c, bash_favx2.c, 
+bash_favx512.c компилируются отдельно, а реализация выбирается во время 
+выполнения.
+*******************************************************************************
+*/
+
+void bashF_32(octet block[192], void* stack);
+size_t bashF_32_deep();
+void bashF_64(octet block[192], void* stack);
+size_t bashF_64_deep();
+void bashF_sse2(octet block[192], void* stack);
+size_t bashF_sse2_deep();
+void bashF_avx2(octet block[192], void* stack);
+size_t bashF_avx2_deep();
+void bashF_avx512(octet block[192], void* stack);
+size_t bashF_avx512_deep();
+void bashF_neon(octet block[192], void* stack);
+size_t bashF_neon_deep();
+
+/*
+*******************************************************************************
+Векторные реализации bashF4() и bashF8()
+
+На платформах x86 и x64 поддержка AVX2 и AVX512F проверяется во время
+выполнения (см. cpuHas()). Если AVX2 поддерживается, то bashF4()
+реализуется функцией bashF4_avx2(), если поддерживается AVX512F, то
+bashF8() реализуется функцией bashF8_avx512().
+
+Векторные функции компилируются без глобальных флагов: в GCC и Clang для
+них указываются атрибуты target("avx2") (BASH_AVX2_TARGET) и
+target("avx512f") (BASH_AVX512_TARGET), в MSVC соответствующие intrinsic
+доступны всегда.
+*******************************************************************************
+*/
+
+#if (OCTET_ORDER == LITTLE_ENDIAN) &&\
+	(defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__)
+	#define BASH_FN_AVX2
+	#define BASH_FN_AVX512
+	#define BASH_AVX2_TARGET __attribute__((target("avx2")))
+	#define BASH_AVX512_TARGET __attribute__((target("avx512f")))
+#elif defined(_MSC_VER) && _MSC_VER >= 1910 && defined(_M_X64)
+	#define BASH_FN_AVX2
+	#define BASH_FN_AVX512
+	#define BASH_AVX2_TARGET
+	#define BASH_AVX512_TARGET
+#endif
+
+#ifdef BASH_FN_AVX2
+void bashF4_avx2(octet blocks[768]);
+#endif
+
+#ifdef BASH_FN_AVX512
+void bashF8_avx512(octet blocks[1536]);
+#endif
+
+/*
+*******************************************************************************
+Одновременное применение bash-f к нескольким состояниям
+
+Функция bashFN() применяет sponge-функцию к n состояниям [192]s[i].
+Состояния собираются в порции по 8 или 4 и обрабатываются функциями
+bashF8() или bashF4(), если такие функции реализованы векторными
+командами. Иначе (а также для единственного состояния) вызывается bashF().
+
+Глубина стека bashFN() совпадает с глубиной стека bashF().
+
+\pre Адреса s[i] выровнены на границу 8 октетов.
+*******************************************************************************
+*/
+
+void bashFN(octet* s[], size_t n, void* stack);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* __BASH_LCL_H */
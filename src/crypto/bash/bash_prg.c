@@ -4,7 +4,7 @@
 \brief STB 34.101.77 (bash): programmable algorithms
 \project bee2 [cryptographic library]
 \created 2018.10.30
-\version 2025.09.23
+\version 2026.10.16
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
@@ -13,6 +13,7 @@
 #include "bee2/core/mem.h"
 #include "bee2/core/util.h"
 #include "bee2/crypto/bash.h"
+#include "bash_lcl.h"
 
 /*
 *******************************************************************************
@@ -80,6 +81,74 @@ size_t bashPrg_keep()
 	(16 * (192 - ((const bash_prg_st*)state)->buf_len) == \
 		((const bash_prg_st*)state)->l * (2 + ((const bash_prg_st*)state)->d))
 
+/*
+*******************************************************************************
+Пословная обработка
+
+Функции bashPrgXor(), bashPrgEncrXor(), bashPrgDecrXor() обрабатывают 
+фрагмент буфера состояния s и фрагмент данных buf одинаковой длины count, 
+count <= 192. Полные слова фрагментов копируются функцией memCopy() 
+в выровненные массивы слов, обрабатываются пословно и копируются обратно. 
+Поэтому выравнивание s и buf может быть произвольным, а число обращений 
+к memCopy() не зависит от count. Неполные слова (длина блока кратна 4, 
+но не всегда кратна O_PER_W) обрабатываются пооктетно.
+*******************************************************************************
+*/
+
+static void bashPrgXor(octet s[], const octet buf[], size_t count)
+{
+	word w[W_OF_O(192)];
+	word v[W_OF_O(192)];
+	const size_t n = count - count % O_PER_W;
+	size_t i;
+	ASSERT(count <= 192);
+	memCopy(w, s, n), memCopy(v, buf, n);
+	for (i = 0; i < n / O_PER_W; ++i)
+		w[i] ^= v[i];
+	memCopy(s, w, n);
+	for (i = n; i < count; ++i)
+		s[i] ^= buf[i];
+	memWipe(w, n), memWipe(v, n);
+}
+
+static void bashPrgEncrXor(octet s[], octet buf[], size_t count)
+{
+	word w[W_OF_O(192)];
+	word v[W_OF_O(192)];
+	const size_t n = count - count % O_PER_W;
+	size_t i;
+	ASSERT(count <= 192);
+	memCopy(w, s, n), memCopy(v, buf, n);
+	for (i = 0; i < n / O_PER_W; ++i)
+		w[i] ^= v[i];
+	memCopy(s, w, n), memCopy(buf, w, n);
+	for (i = n; i < count; ++i)
+		buf[i] = s[i] ^= buf[i];
+	memWipe(w, n), memWipe(v, n);
+}
+
+static void bashPrgDecrXor(octet s[], octet buf[], size_t count)
+{
+	word w[W_OF_O(192)];
+	word v[W_OF_O(192)];
+	const size_t n = count - count % O_PER_W;
+	octet o;
+	size_t i;
+	ASSERT(count <= 192);
+	memCopy(w, s, n), memCopy(v, buf, n);
+	for (i = 0; i < n / O_PER_W; ++i)
+		w[i] ^= v[i];
+	memCopy(buf, w, n), memCopy(s, v, n);
+	for (i = n; i < count; ++i)
+	{
+		o = buf[i];
+		buf[i] ^= s[i];
+		s[i] = o;
+	}
+	memWipe(w, n), memWipe(v, n);
+	CLEAN(o);
+}
+
 /*
 *******************************************************************************
 Commit: завершить предыдущую команду и начать новую с кодом code
@@ -186,26 +255,26 @@ void bashPrgAbsorbStep(const void* buf, size_t count, void* state)
 	// не накопился полный буфер?
 	if (count < st->buf_len - st->pos)
 	{
-		memXor2(st->s + st->pos, buf, count);
+		bashPrgXor(st->s + st->pos, (const octet*)buf, count);
 		st->pos += count;
 		return;
 	}
 	// новый полный буфер
-	memXor2(st->s + st->pos, buf, st->buf_len - st->pos);
+	bashPrgXor(st->s + st->pos, (const octet*)buf, st->buf_len - st->pos);
 	buf = (const octet*)buf + st->buf_len - st->pos;
 	count -= st->buf_len - st->pos;
 	bashF(st->s, st->stack);
 	// цикл по полным блокам
 	while (count >= st->buf_len)
 	{
-		memXor2(st->s, buf, st->buf_len);
+		bashPrgXor(st->s, (const octet*)buf, st->buf_len);
 		buf = (const octet*)buf + st->buf_len;
 		count -= st->buf_len;
 		bashF(st->s, st->stack);
 	}
 	// неполный блок?
 	if (st->pos = count)
-		memXor2(st->s, buf, count);
+		bashPrgXor(st->s, (const octet*)buf, count);
 }
 
 void bashPrgAbsorb(const void* buf, size_t count, void* state)
@@ -279,32 +348,26 @@ void bashPrgEncrStep(void* buf, size_t count, void* state)
 	// остатка буфера достаточно?
 	if (count < st->buf_len - st->pos)
 	{
-		memXor2(st->s + st->pos, buf, count);
-		memCopy(buf, st->s + st->pos, count);
+		bashPrgEncrXor(st->s + st->pos, (octet*)buf, count);
 		st->pos += count;
 		return;
 	}
 	// новый буфер
-	memXor2(st->s + st->pos, buf, st->buf_len - st->pos);
-	memCopy(buf, st->s + st->pos, st->buf_len - st->pos);
+	bashPrgEncrXor(st->s + st->pos, (octet*)buf, st->buf_len - st->pos);
 	buf = (octet*)buf + st->buf_len - st->pos;
 	count -= st->buf_len - st->pos;
 	bashF(st->s, st->stack);
 	// цикл по полным блокам
 	while (count >= st->buf_len)
 	{
-		memXor2(st->s, buf, st->buf_len);
-		memCopy(buf, st->s, st->buf_len);
+		bashPrgEncrXor(st->s, (octet*)buf, st->buf_len);
 		buf = (octet*)buf + st->buf_len;
 		count -= st->buf_len;
 		bashF(st->s, st->stack);
 	}
 	// неполный блок
 	if (st->pos = count)
-	{
-		memXor2(st->s, buf, count);
-		memCopy(buf, st->s, count);
-	}
+		bashPrgEncrXor(st->s, (octet*)buf, count);
 }
 
 void bashPrgEncr(void* buf, size_t count, void* state)
@@ -332,32 +395,26 @@ void bashPrgDecrStep(void* buf, size_t count, void* state)
 	// остатка буфера достаточно?
 	if (count < st->buf_len - st->pos)
 	{
-		memXor2(buf, st->s + st->pos, count);
-		memXor2(st->s + st->pos, buf, count);
+		bashPrgDecrXor(st->s + st->pos, (octet*)buf, count);
 		st->pos += count;
 		return;
 	}
 	// новый буфер
-	memXor2(buf, st->s + st->pos, st->buf_len - st->pos);
-	memXor2(st->s + st->pos, buf, st->buf_len - st->pos);
+	bashPrgDecrXor(st->s + st->pos, (octet*)buf, st->buf_len - st->pos);
 	buf = (octet*)buf + st->buf_len - st->pos;
 	count -= st->buf_len - st->pos;
 	bashF(st->s, st->stack);
 	// цикл по полным блокам
 	while (count >= st->buf_len)
 	{
-		memXor2(buf, st->s, st->buf_len);
-		memXor2(st->s, buf, st->buf_len);
+		bashPrgDecrXor(st->s, (octet*)buf, st->buf_len);
 		buf = (octet*)buf + st->buf_len;
 		count -= st->buf_len;
 		bashF(st->s, st->stack);
 	}
 	// неполный блок
 	if (st->pos = count)
-	{
-		memXor2(buf, st->s, count);
-		memXor2(st->s, buf, count);
-	}
+		bashPrgDecrXor(st->s, (octet*)buf, count);
 }
 
 void bashPrgDecr(void* buf, size_t count, void* state)
@@ -383,3 +440,127 @@ void bashPrgRatchet(void* state)
 	// необратимо изменить
 	memXor2(st->s, st->t, 192);
 }
+
+/*
+*******************************************************************************
+Несколько автоматов
+
+Автоматы обрабатываются группами до BASH_PRG_MULTI_N. В группе команды 
+выполняются синхронно: на каждом шаге в порцию включаются автоматы, 
+у которых заполнен (при загрузке) или исчерпан (при выгрузке) буфер, 
+и к ним одновременно применяется sponge-функция (см. bashFN()). 
+В качестве стека bashFN() используется стек первого автомата группы.
+*******************************************************************************
+*/
+
+#define BASH_PRG_MULTI_N 8
+
+static void bashPrgCommitMulti(octet code, void* state[], size_t n)
+{
+	octet* s[BASH_PRG_MULTI_N];
+	size_t i;
+	ASSERT(0 < n && n <= BASH_PRG_MULTI_N);
+	for (i = 0; i < n; ++i)
+	{
+		bash_prg_st* st = (bash_prg_st*)state[i];
+		ASSERT(memIsValid(st, bashPrg_keep()));
+		ASSERT(st->pos < st->buf_len);
+		// учесть code и инвертировать контрольный бит
+		st->s[st->pos] ^= code;
+		st->s[st->buf_len] ^= 0x80;
+		st->pos = 0;
+		s[i] = st->s;
+	}
+	// применить sponge-функцию
+	bashFN(s, n, ((bash_prg_st*)state[0])->stack);
+}
+
+void bashPrgAbsorbMulti(const void* buf[], const size_t count[], 
+	void* state[], size_t n)
+{
+	octet* s[BASH_PRG_MULTI_N];
+	const octet* b[BASH_PRG_MULTI_N];
+	size_t c[BASH_PRG_MULTI_N];
+	size_t g, i, m;
+	for (; n; n -= g, buf += g, count += g, state += g)
+	{
+		g = MIN2(n, BASH_PRG_MULTI_N);
+		// начать загрузку
+		bashPrgCommitMulti(BASH_PRG_DATA, state, g);
+		for (i = 0; i < g; ++i)
+		{
+			ASSERT(memIsDisjoint2(state[i], bashPrg_keep(), 
+				buf[i], count[i]));
+			b[i] = (const octet*)buf[i], c[i] = count[i];
+		}
+		// цикл по порциям полных блоков
+		while (TRUE)
+		{
+			for (i = m = 0; i < g; ++i)
+			{
+				bash_prg_st* st = (bash_prg_st*)state[i];
+				size_t t = st->buf_len - st->pos;
+				if (c[i] < t)
+					continue;
+				memXor2(st->s + st->pos, b[i], t);
+				b[i] += t, c[i] -= t, st->pos = 0;
+				s[m++] = st->s;
+			}
+			if (m == 0)
+				break;
+			bashFN(s, m, ((bash_prg_st*)state[0])->stack);
+		}
+		// неполные блоки
+		for (i = 0; i < g; ++i)
+		{
+			bash_prg_st* st = (bash_prg_st*)state[i];
+			memXor2(st->s + st->pos, b[i], c[i]);
+			st->pos += c[i];
+		}
+	}
+}
+
+void bashPrgSqueezeMulti(void* buf[], const size_t count[], void* state[], 
+	size_t n)
+{
+	octet* s[BASH_PRG_MULTI_N];
+	octet* b[BASH_PRG_MULTI_N];
+	size_t c[BASH_PRG_MULTI_N];
+	size_t g, i, m;
+	for (; n; n -= g, buf += g, count += g, state += g)
+	{
+		g = MIN2(n, BASH_PRG_MULTI_N);
+		// начать выгрузку
+		bashPrgCommitMulti(BASH_PRG_OUT, state, g);
+		for (i = 0; i < g; ++i)
+		{
+			ASSERT(memIsDisjoint2(state[i], bashPrg_keep(), 
+				buf[i], count[i]));
+			b[i] = (octet*)buf[i], c[i] = count[i];
+		}
+		// цикл по порциям полных блоков
+		while (TRUE)
+		{
+			for (i = m = 0; i < g; ++i)
+			{
+				bash_prg_st* st = (bash_prg_st*)state[i];
+				size_t t = st->buf_len - st->pos;
+				if (c[i] < t)
+					continue;
+				memCopy(b[i], st->s + st->pos, t);
+				b[i] += t, c[i] -= t, st->pos = 0;
+				s[m++] = st->s;
+			}
+			if (m == 0)
+				break;
+			bashFN(s, m, ((bash_prg_st*)state[0])->stack);
+		}
+		// неполные блоки
+		for (i = 0; i < g; ++i)
+		{
+			bash_prg_st* st = (bash_prg_st*)state[i];
+			memCopy(b[i], st->s + st->pos, c[i]);
+			st->pos += c[i];
+		}
+	}
+}
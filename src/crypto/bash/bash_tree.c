@@ -0,0 +1,367 @@
+/*
+*******************************************************************************
+\file bash_tree.c
+\brief STB 34.101.77 (bash): tree hashing
+\project bee2 [cryptographic library]
+\created 2026.10.16
+\version 2026.10.16
+\copyright The Bee2 authors
+\license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
+*******************************************************************************
+*/
+
+#include "bee2/core/blob.h"
+#include "bee2/core/err.h"
+#include "bee2/core/mem.h"
+#include "bee2/core/mt.h"
+#include "bee2/core/u64.h"
+#include "bee2/core/util.h"
+#include "bee2/crypto/bash.h"
+
+/*
+*******************************************************************************
+Узлы дерева
+
+Хэш-значение внутреннего узла определяется по хэш-значениям left и right
+его потомков так:
+	bash-prg-hash(l, 1, ann = "bashtreenode", left || right).
+Окончательное хэш-значение определяется по хэш-значению top корня
+дерева так:
+	bash-prg-hash(l, 1, ann = "bashtreeroot", <leaf_len>_64 || top).
+Различные анонсы и отличие bash-prg-hash от bash-hash, с помощью которого
+хэшируются листья, разделяют области определения хэш-значений листьев,
+узлов и корня.
+*******************************************************************************
+*/
+
+static const octet bash_tree_node[12] = {
+	'b', 'a', 's', 'h', 't', 'r', 'e', 'e', 'n', 'o', 'd', 'e',
+};
+
+static const octet bash_tree_root[12] = {
+	'b', 'a', 's', 'h', 't', 'r', 'e', 'e', 'r', 'o', 'o', 't',
+};
+
+static void bashTreeNode(octet node[], size_t l, const octet left[],
+	const octet right[], void* prg)
+{
+	bashPrgStart(prg, l, 1, bash_tree_node, sizeof(bash_tree_node), 0, 0);
+	bashPrgAbsorbStart(prg);
+	bashPrgAbsorbStep(left, l / 4, prg);
+	bashPrgAbsorbStep(right, l / 4, prg);
+	bashPrgSqueeze(node, l / 4, prg);
+}
+
+static void bashTreeTop(octet hash[], size_t hash_len, size_t l,
+	size_t leaf_len, const octet top[], void* prg)
+{
+	octet len[8];
+	u64 t = (u64)leaf_len;
+	u64To(len, 8, &t);
+	bashPrgStart(prg, l, 1, bash_tree_root, sizeof(bash_tree_root), 0, 0);
+	bashPrgAbsorbStart(prg);
+	bashPrgAbsorbStep(len, 8, prg);
+	bashPrgAbsorbStep(top, l / 4, prg);
+	bashPrgSqueeze(hash, hash_len, prg);
+}
+
+/*
+*******************************************************************************
+Состояние
+
+Корни полных поддеревьев размещаются в стеке: если обработано n листьев,
+то в стеке находятся корни поддеревьев из 2^{i_1} > 2^{i_2} > ... листьев,
+где i_1, i_2,... -- номера ненулевых битов n. При добавлении листа
+вершина стека сливается с предыдущим элементом столько раз, сколько
+младших единичных битов у n. Поэтому глубина стека не превосходит
+B_PER_S + 1, а форма дерева совпадает с формой дерева Меркла
+из RFC 6962.
+
+Полные листья, содержащиеся во фрагменте, переданном в bashTreeStepH(),
+хэшируются порциями до BASH_TREE_BATCH листьев. Порция разбивается
+на не более чем nthreads заданий, задания выполняются в отдельных
+потоках (первое -- в вызывающем потоке). Каждое задание использует
+собственное состояние bashHash. Состояние первого задания используется
+также для хэширования неполного листа.
+*******************************************************************************
+*/
+
+#define BASH_TREE_BATCH 64
+
+typedef struct
+{
+	size_t l;				/*< уровень стойкости */
+	size_t leaf_len;		/*< длина листа */
+	size_t nthreads;		/*< число потоков */
+	size_t leaf_pos;		/*< обработано октетов текущего листа */
+	size_t n;				/*< число обработанных листьев */
+	size_t height;			/*< глубина стека */
+	octet stack[(B_PER_S + 1) * 64];	/*< стек корней поддеревьев */
+	octet hashes[BASH_TREE_BATCH * 64];	/*< хэш-значения порции листьев */
+	octet node[64];			/*< хэш-значение узла */
+	mem_align_t data[];		/*< [nthreads]bash_hash_st || bash_prg_st */
+} bash_tree_st;
+
+typedef struct
+{
+	const octet* src;		/*< листья */
+	size_t count;			/*< число листьев */
+	size_t leaf_len;		/*< длина листа */
+	size_t l;				/*< уровень стойкости */
+	octet* hashes;			/*< хэш-значения листьев */
+	void* state;			/*< состояние bashHash */
+	mt_thrd_t thrd;			/*< поток */
+	bool_t created;			/*< поток создан? */
+} bash_tree_job;
+
+static size_t bashTreeHash_keep()
+{
+	return (bashHash_keep() + sizeof(mem_align_t) - 1) /
+		sizeof(mem_align_t) * sizeof(mem_align_t);
+}
+
+static void* bashTreeHashState(bash_tree_st* st, size_t i)
+{
+	return (octet*)st->data + i * bashTreeHash_keep();
+}
+
+static void* bashTreePrgState(bash_tree_st* st)
+{
+	return bashTreeHashState(st, st->nthreads);
+}
+
+size_t bashTree_keep(size_t nthreads)
+{
+	nthreads = MIN2(nthreads, BASH_TREE_BATCH);
+	return sizeof(bash_tree_st) + nthreads * bashTreeHash_keep() +
+		bashPrg_keep();
+}
+
+void bashTreeStart(void* state, size_t l, size_t leaf_len, size_t nthreads)
+{
+	bash_tree_st* st = (bash_tree_st*)state;
+	ASSERT(l == 128 || l == 192 || l == 256);
+	ASSERT(leaf_len > 0 && nthreads > 0);
+	ASSERT(memIsValid(state, bashTree_keep(nthreads)));
+	st->l = l;
+	st->leaf_len = leaf_len;
+	st->nthreads = MIN2(nthreads, BASH_TREE_BATCH);
+	st->leaf_pos = st->n = st->height = 0;
+	bashHashStart(bashTreeHashState(st, 0), l);
+}
+
+/*
+*******************************************************************************
+Обработка листьев
+*******************************************************************************
+*/
+
+static void bashTreePush(bash_tree_st* st, const octet hash[])
+{
+	const size_t hash_len = st->l / 4;
+	size_t n;
+	ASSERT(st->height <= B_PER_S);
+	memCopy(st->stack + hash_len * st->height++, hash, hash_len);
+	for (n = st->n++; n & 1; n >>= 1, --st->height)
+	{
+		octet* left = st->stack + hash_len * (st->height - 2);
+		bashTreeNode(left, st->l, left, left + hash_len,
+			bashTreePrgState(st));
+	}
+}
+
+static void bashTreeJob(void* arg)
+{
+	bash_tree_job* job = (bash_tree_job*)arg;
+	size_t i;
+	for (i = 0; i < job->count; ++i)
+	{
+		bashHashStart(job->state, job->l);
+		bashHashStepH(job->src + job->leaf_len * i, job->leaf_len,
+			job->state);
+		bashHashStepG(job->hashes + job->l / 4 * i, job->l / 4, job->state);
+	}
+}
+
+static void bashTreeBatch(const octet* src, size_t count, bash_tree_st* st)
+{
+	bash_tree_job jobs[BASH_TREE_BATCH];
+	size_t k, i, pos;
+	ASSERT(0 < count && count <= BASH_TREE_BATCH);
+	// подготовить задания
+	k = MIN2(count, st->nthreads);
+	for (i = pos = 0; i < k; ++i)
+	{
+		jobs[i].count = count / k + (i < count % k);
+		jobs[i].src = src + st->leaf_len * pos;
+		jobs[i].leaf_len = st->leaf_len;
+		jobs[i].l = st->l;
+		jobs[i].hashes = st->hashes + st->l / 4 * pos;
+		jobs[i].state = bashTreeHashState(st, i);
+		pos += jobs[i].count;
+	}
+	// запустить потоки
+	for (i = 1; i < k; ++i)
+		jobs[i].created = mtThrdCreate(&jobs[i].thrd, bashTreeJob, jobs + i);
+	// обработать первое задание
+	bashTreeJob(jobs);
+	// дождаться завершения потоков
+	for (i = 1; i < k; ++i)
+		if (jobs[i].created)
+			mtThrdJoin(&jobs[i].thrd);
+		else
+			bashTreeJob(jobs + i);
+	// добавить листья в дерево
+	for (i = 0; i < count; ++i)
+		bashTreePush(st, st->hashes + st->l / 4 * i);
+}
+
+void bashTreeStepH(const void* buf, size_t count, void* state)
+{
+	bash_tree_st* st = (bash_tree_st*)state;
+	size_t t;
+	ASSERT(memIsValid(state, sizeof(bash_tree_st)));
+	ASSERT(memIsDisjoint2(buf, count, state, bashTree_keep(st->nthreads)));
+	// завершить текущий лист
+	if (st->leaf_pos)
+	{
+		t = MIN2(count, st->leaf_len - st->leaf_pos);
+		bashHashStepH(buf, t, bashTreeHashState(st, 0));
+		buf = (const octet*)buf + t, count -= t;
+		if ((st->leaf_pos += t) < st->leaf_len)
+			return;
+		bashHashStepG(st->node, st->l / 4, bashTreeHashState(st, 0));
+		bashTreePush(st, st->node);
+		st->leaf_pos = 0;
+	}
+	// полные листья
+	while (count >= st->leaf_len)
+	{
+		t = MIN2(count / st->leaf_len, BASH_TREE_BATCH);
+		bashTreeBatch((const octet*)buf, t, st);
+		buf = (const octet*)buf + st->leaf_len * t;
+		count -= st->leaf_len * t;
+	}
+	// начать новый лист
+	bashHashStart(bashTreeHashState(st, 0), st->l);
+	bashHashStepH(buf, count, bashTreeHashState(st, 0));
+	st->leaf_pos = count;
+}
+
+/*
+*******************************************************************************
+Окончательное хэш-значение
+
+Последний неполный лист (пустой лист, если листьев нет) добавляется
+к дереву, после чего корни поддеревьев в стеке последовательно
+сливаются, начиная с вершины. Состояние не изменяется, поэтому
+хэширование можно продолжить.
+*******************************************************************************
+*/
+
+static void bashTreeStepG_internal(size_t hash_len, void* state)
+{
+	bash_tree_st* st = (bash_tree_st*)state;
+	const size_t l4 = st->l / 4;
+	size_t i;
+	ASSERT(memIsValid(state, bashTree_keep(st->nthreads)));
+	ASSERT(hash_len <= l4);
+	// неполный лист или пустое дерево?
+	if (st->leaf_pos || st->n == 0)
+	{
+		bashHashStepG(st->node, l4, bashTreeHashState(st, 0));
+		i = st->height;
+	}
+	else
+	{
+		ASSERT(st->height > 0);
+		memCopy(st->node, st->stack + l4 * (st->height - 1), l4);
+		i = st->height - 1;
+	}
+	// слить корни поддеревьев
+	while (i--)
+		bashTreeNode(st->node, st->l, st->stack + l4 * i, st->node,
+			bashTreePrgState(st));
+	// окончательное хэш-значение
+	bashTreeTop(st->node, hash_len, st->l, st->leaf_len, st->node,
+		bashTreePrgState(st));
+}
+
+void bashTreeStepG(octet hash[], size_t hash_len, void* state)
+{
+	bash_tree_st* st = (bash_tree_st*)state;
+	ASSERT(memIsValid(hash, hash_len));
+	bashTreeStepG_internal(hash_len, state);
+	memCopy(hash, st->node, hash_len);
+}
+
+bool_t bashTreeStepV(const octet hash[], size_t hash_len, void* state)
+{
+	bash_tree_st* st = (bash_tree_st*)state;
+	ASSERT(memIsValid(hash, hash_len));
+	bashTreeStepG_internal(hash_len, state);
+	return memEq(hash, st->node, hash_len);
+}
+
+/*
+*******************************************************************************
+Хэширование за один вызов
+*******************************************************************************
+*/
+
+err_t bashTreeHash(octet hash[], size_t l, size_t leaf_len, const void* src,
+	size_t count, size_t nthreads)
+{
+	void* state;
+	// проверить входные данные
+	if (l != 128 && l != 192 && l != 256)
+		return ERR_BAD_PARAMS;
+	if (leaf_len == 0 || nthreads == 0 ||
+		!memIsValid(src, count) || !memIsValid(hash, l / 4))
+		return ERR_BAD_INPUT;
+	// создать состояние
+	state = blobCreate(bashTree_keep(nthreads));
+	if (state == 0)
+		return ERR_OUTOFMEMORY;
+	// вычислить хэш-значение
+	bashTreeStart(state, l, leaf_len, nthreads);
+	bashTreeStepH(src, count, state);
+	bashTreeStepG(hash, l / 4, state);
+	// завершить
+	blobClose(state);
+	return ERR_OK;
+}
+
+/*
+*******************************************************************************
+Хэширование по хэш-значениям листьев
+
+Стек корней поддеревьев строится так же, как в bashTreeStepH().
+Для стека и хэш-значений узлов используется блоб.
+*******************************************************************************
+*/
+
+err_t bashTreeHashLeaves(octet hash[], size_t l, size_t leaf_len,
+	const octet leaves[], size_t n)
+{
+	bash_tree_st* st;
+	size_t i;
+	// проверить входные данные
+	if (l != 128 && l != 192 && l != 256)
+		return ERR_BAD_PARAMS;
+	if (leaf_len == 0 || n == 0 || n > SIZE_MAX / (l / 4) ||
+		!memIsValid(leaves, l / 4 * n) || !memIsValid(hash, l / 4))
+		return ERR_BAD_INPUT;
+	// создать состояние
+	st = (bash_tree_st*)blobCreate(bashTree_keep(1));
+	if (st == 0)
+		return ERR_OUTOFMEMORY;
+	// построить дерево
+	bashTreeStart(st, l, leaf_len, 1);
+	for (i = 0; i < n; ++i)
+		bashTreePush(st, leaves + l / 4 * i);
+	bashTreeStepG(hash, l / 4, st);
+	// завершить
+	blobClose(st);
+	return ERR_OK;
+}
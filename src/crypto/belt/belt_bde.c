@@ -4,7 +4,7 @@
 \brief STB 34.101.31 (belt): BDE (Blockwise Disk Encryption)
 \project bee2 [cryptographic library]
 \created 2018.06.28
-\version 2025.10.02
+\version 2026.10.16
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
@@ -29,6 +29,8 @@ typedef struct
 	u32 s[4];			/*< переменная s */
 	octet block[16];	/*< вспомогательный блок */
 	octet block1[16];	/*< второй вспомогательный блок */
+	u32 ss[4 * BELT_BLOCK_N];		/*< порция значений s */
+	u32 blocks[4 * BELT_BLOCK_N];	/*< порция блоков */
 } belt_bde_st;
 
 size_t beltBDE_keep()
@@ -49,8 +51,25 @@ void beltBDEStart(void* state, const octet key[], size_t len,
 void beltBDEStepE(void* buf, size_t count, void* state)
 {
 	belt_bde_st* st = (belt_bde_st*)state;
+	size_t i;
 	ASSERT(count % 16 == 0);
 	ASSERT(memIsDisjoint2(buf, count, state, beltBDE_keep()));
+	// цикл по порциям блоков
+	while(count >= 16 * BELT_BLOCK_N)
+	{
+		for (i = 0; i < BELT_BLOCK_N; ++i)
+		{
+			beltBlockMulCU32(st->s);
+			beltBlockCopy(st->ss + 4 * i, st->s);
+		}
+		u32From(st->blocks, buf, 16 * BELT_BLOCK_N);
+		memXor2(st->blocks, st->ss, 16 * BELT_BLOCK_N);
+		beltBlockEncrN(st->blocks, BELT_BLOCK_N, st->key);
+		memXor2(st->blocks, st->ss, 16 * BELT_BLOCK_N);
+		u32To(buf, 16 * BELT_BLOCK_N, st->blocks);
+		buf = (octet*)buf + 16 * BELT_BLOCK_N;
+		count -= 16 * BELT_BLOCK_N;
+	}
 	// цикл по блокам
 	while(count >= 16)
 	{
@@ -67,8 +86,25 @@ void beltBDEStepE(void* buf, size_t count, void* state)
 void beltBDEStepD(void* buf, size_t count, void* state)
 {
 	belt_bde_st* st = (belt_bde_st*)state;
+	size_t i;
 	ASSERT(count % 16 == 0);
 	ASSERT(memIsDisjoint2(buf, count, state, beltBDE_keep()));
+	// цикл по порциям блоков
+	while(count >= 16 * BELT_BLOCK_N)
+	{
+		for (i = 0; i < BELT_BLOCK_N; ++i)
+		{
+			beltBlockMulCU32(st->s);
+			beltBlockCopy(st->ss + 4 * i, st->s);
+		}
+		u32From(st->blocks, buf, 16 * BELT_BLOCK_N);
+		memXor2(st->blocks, st->ss, 16 * BELT_BLOCK_N);
+		beltBlockDecrN(st->blocks, BELT_BLOCK_N, st->key);
+		memXor2(st->blocks, st->ss, 16 * BELT_BLOCK_N);
+		u32To(buf, 16 * BELT_BLOCK_N, st->blocks);
+		buf = (octet*)buf + 16 * BELT_BLOCK_N;
+		count -= 16 * BELT_BLOCK_N;
+	}
 	// цикл по блокам
 	while(count >= 16)
 	{
@@ -131,3 +167,109 @@ err_t beltBDEDecr(void* dest, const void* src, size_t count,
 	blobClose(state);
 	return ERR_OK;
 }
+
+/*
+*******************************************************************************
+Пакетная обработка секторов
+
+Сектор с номером pos (от начала пакета) обрабатывается на синхропосылке 
+iv + pos, где iv интерпретируется как 128-битовое число, записанное 
+октетами от младшего к старшему. Начальные значения s для BELT_BLOCK_N 
+секторов определяются одним вызовом beltBlockEncrN(). Блоки внутри 
+сектора обрабатываются порциями в beltBDEStepE() / beltBDEStepD(). 
+Фрагменты пакета (целые числа секторов) обрабатываются в нескольких 
+потоках (см. beltMTStep()).
+*******************************************************************************
+*/
+
+typedef struct
+{
+	belt_bde_st bde[1];				/*< состояние BDE */
+	u32 iv[4];						/*< синхропосылка первого сектора */
+	u32 ivs[4 * BELT_BLOCK_N];		/*< порция синхропосылок */
+	size_t size;					/*< размер сектора */
+} belt_bde_sectors_st;
+
+static void beltBDESectorsStep(void* buf, size_t count, size_t pos, 
+	void* state, void (*step)(void*, size_t, void*))
+{
+	belt_bde_sectors_st* st = (belt_bde_sectors_st*)state;
+	size_t n, i;
+	ASSERT(count % st->size == 0);
+	for (; count; count -= n * st->size, pos += n)
+	{
+		n = MIN2(count / st->size, BELT_BLOCK_N);
+		// зашифровать синхропосылки
+		for (i = 0; i < n; ++i)
+		{
+			beltBlockCopy(st->ivs + 4 * i, st->iv);
+			beltBlockAddU32(st->ivs + 4 * i, pos + i);
+		}
+		beltBlockEncrN(st->ivs, n, st->bde->key);
+		// обработать секторы
+		for (i = 0; i < n; ++i)
+		{
+			beltBlockCopy(st->bde->s, st->ivs + 4 * i);
+			step(buf, st->size, st->bde);
+			buf = (octet*)buf + st->size;
+		}
+	}
+}
+
+static void beltBDESectorsStepE(void* buf, size_t count, size_t pos, 
+	void* state)
+{
+	beltBDESectorsStep(buf, count, pos, state, beltBDEStepE);
+}
+
+static void beltBDESectorsStepD(void* buf, size_t count, size_t pos, 
+	void* state)
+{
+	beltBDESectorsStep(buf, count, pos, state, beltBDEStepD);
+}
+
+static err_t beltBDESectors(void* dest, const void* src, size_t size, 
+	size_t n, const octet key[], size_t len, const octet iv[16], 
+	size_t nthreads, belt_mt_step_i step)
+{
+	belt_bde_sectors_st* st;
+	err_t code;
+	// проверить входные данные
+	if (size % 16 != 0 || size < 16 || n == 0 || n > SIZE_MAX / size ||
+		len != 16 && len != 24 && len != 32 ||
+		nthreads == 0 ||
+		!memIsValid(src, size * n) ||
+		!memIsValid(key, len) ||
+		!memIsValid(iv, 16) ||
+		!memIsValid(dest, size * n))
+		return ERR_BAD_INPUT;
+	// создать состояние
+	st = (belt_bde_sectors_st*)blobCreate(sizeof(belt_bde_sectors_st));
+	if (st == 0)
+		return ERR_OUTOFMEMORY;
+	// обработать секторы
+	beltKeyExpand2(st->bde->key, key, len);
+	u32From(st->iv, iv, 16);
+	st->size = size;
+	code = beltMTStep(dest, src, size * n, size, step, st, 
+		sizeof(belt_bde_sectors_st), nthreads);
+	// завершить
+	blobClose(st);
+	return code;
+}
+
+err_t beltBDEEncrSectors(void* dest, const void* src, size_t size, 
+	size_t n, const octet key[], size_t len, const octet iv[16], 
+	size_t nthreads)
+{
+	return beltBDESectors(dest, src, size, n, key, len, iv, nthreads, 
+		beltBDESectorsStepE);
+}
+
+err_t beltBDEDecrSectors(void* dest, const void* src, size_t size, 
+	size_t n, const octet key[], size_t len, const octet iv[16], 
+	size_t nthreads)
+{
+	return beltBDESectors(dest, src, size, n, key, len, iv, nthreads, 
+		beltBDESectorsStepD);
+}
@@ -4,7 +4,7 @@
 \brief STB 34.101.31 (belt): block encryption
 \project bee2 [cryptographic library]
 \created 2012.12.18
-\version 2026.03.15
+\version 2026.10.16
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
@@ -13,6 +13,7 @@
 #include "bee2/core/mem.h"
 #include "bee2/core/u32.h"
 #include "bee2/core/util.h"
+#include "belt_lcl.h"
 
 /*
 *******************************************************************************
@@ -108,6 +109,10 @@ void beltKeyExpand2(u32 key_[8], const octet key[], size_t len)
 /*
 *******************************************************************************
 Расширенные H-блоки
+
+Таблица beltH<r> содержит значения H-блока, расширенные до 32 битов и
+циклически сдвинутые влево на r позиций. Таблицы используются также 
+в векторной реализации (belt_block_avx2.c).
 *******************************************************************************
 */
 
@@ -118,7 +123,7 @@ void beltKeyExpand2(u32 key_[8], const octet key[], size_t len)
 	HEx(i, r), HEx(j, r), HEx(k, r), HEx(l, r),\
 	HEx(m, r), HEx(n, r), HEx(o, r), HEx(p, r)
 
-static const u32 H5[256] = {
+const u32 beltH5[256] = {
 	HEx16(B1,94,BA,C8,0A,08,F5,3B,36,6D,00,8E,58,4A,5D,E4, 5),
 	HEx16(85,04,FA,9D,1B,B6,C7,AC,25,2E,72,C2,02,FD,CE,0D, 5),
 	HEx16(5B,E3,D6,12,17,B9,61,81,FE,67,86,AD,71,6B,89,0B, 5),
@@ -137,7 +142,7 @@ static const u32 H5[256] = {
 	HEx16(D4,EF,D9,B4,3A,62,28,75,91,14,10,EA,77,6C,DA,1D, 5),
 };
 
-static const u32 H13[256] = {
+const u32 beltH13[256] = {
 	HEx16(B1,94,BA,C8,0A,08,F5,3B,36,6D,00,8E,58,4A,5D,E4, 13),
 	HEx16(85,04,FA,9D,1B,B6,C7,AC,25,2E,72,C2,02,FD,CE,0D, 13),
 	HEx16(5B,E3,D6,12,17,B9,61,81,FE,67,86,AD,71,6B,89,0B, 13),
@@ -156,7 +161,7 @@ static const u32 H13[256] = {
 	HEx16(D4,EF,D9,B4,3A,62,28,75,91,14,10,EA,77,6C,DA,1D, 13),
 };
 
-static const u32 H21[256] = {
+const u32 beltH21[256] = {
 	HEx16(B1,94,BA,C8,0A,08,F5,3B,36,6D,00,8E,58,4A,5D,E4, 21),
 	HEx16(85,04,FA,9D,1B,B6,C7,AC,25,2E,72,C2,02,FD,CE,0D, 21),
 	HEx16(5B,E3,D6,12,17,B9,61,81,FE,67,86,AD,71,6B,89,0B, 21),
@@ -175,7 +180,7 @@ static const u32 H21[256] = {
 	HEx16(D4,EF,D9,B4,3A,62,28,75,91,14,10,EA,77,6C,DA,1D, 21),
 };
 
-static const u32 H29[256] = {
+const u32 beltH29[256] = {
 	HEx16(B1,94,BA,C8,0A,08,F5,3B,36,6D,00,8E,58,4A,5D,E4, 29),
 	HEx16(85,04,FA,9D,1B,B6,C7,AC,25,2E,72,C2,02,FD,CE,0D, 29),
 	HEx16(5B,E3,D6,12,17,B9,61,81,FE,67,86,AD,71,6B,89,0B, 29),
@@ -196,8 +201,8 @@ static const u32 H29[256] = {
 
 #ifndef SAFE_FAST
 	#define beltHPrefetch()\
-		memPrefetch(H5, 256 * 4), memPrefetch(H13, 256 * 4),\
-		memPrefetch(H21, 256 * 4), memPrefetch(H29, 256 * 4)
+		memPrefetch(beltH5, 256 * 4), memPrefetch(beltH13, 256 * 4),\
+		memPrefetch(beltH21, 256 * 4), memPrefetch(beltH29, 256 * 4)
 #else
 	#define beltHPrefetch() 
 #endif
@@ -208,11 +213,14 @@ G-блоки
 *******************************************************************************
 */
 #define G5(x)\
-	H5[(x) & 255] ^ H13[(x) >> 8 & 255] ^ H21[(x) >> 16 & 255] ^ H29[(x) >> 24]
+	beltH5[(x) & 255] ^ beltH13[(x) >> 8 & 255] ^\
+	beltH21[(x) >> 16 & 255] ^ beltH29[(x) >> 24]
 #define G13(x)\
-	H13[(x) & 255] ^ H21[(x) >> 8 & 255] ^ H29[(x) >> 16 & 255] ^ H5[(x) >> 24]
+	beltH13[(x) & 255] ^ beltH21[(x) >> 8 & 255] ^\
+	beltH29[(x) >> 16 & 255] ^ beltH5[(x) >> 24]
 #define G21(x)\
-	H21[(x) & 255] ^ H29[(x) >> 8 & 255] ^ H5[(x) >> 16 & 255] ^ H13[(x) >> 24]
+	beltH21[(x) & 255] ^ beltH29[(x) >> 8 & 255] ^\
+	beltH5[(x) >> 16 & 255] ^ beltH13[(x) >> 24]
 
 /*
 *******************************************************************************
@@ -371,3 +379,214 @@ void beltBlockDecr3(u32* a, u32* b, u32* c, u32* d, const u32 key[8])
 	beltHPrefetch();
 	D(a, b, c, d, key);
 }
+
+/*
+*******************************************************************************
+Многоблочное шифрование
+
+Если поддерживается AVX2, то блоки сначала обрабатываются восьмерками
+векторными функциями (см. belt_block_avx2.c).
+
+Четверка независимых блоков обрабатывается с чередованием тактов: сначала 
+такт 1 выполняется для всех блоков, затем такт 2 и т.д. Вычисления над 
+разными блоками не зависят друг от друга, и процессор может совмещать 
+обращения к таблицам H-блоков, не дожидаясь результатов предыдущих обращений.
+
+Слова блоков четверки хранятся в локальных переменных a0, b0, c0, d0,...,
+a3, b3, c3, d3. Макрос R4 реализует один такт для всех блоков четверки.
+Перестановки регистров и окончательные перестановки такие же, как в 
+макросах E и D: после зашифрования блок имеет вид (b, d, a, c), 
+после расшифрования -- (c, a, d, b).
+
+Функция beltBlockEncrNK() зашифровывает блоки на разных ключах: i-й блок 
+зашифровывается на ключе key + 8 * i. В четверках блоков используется 
+макрос R4K, который отличается от R4 тем, что j-й блок четверки 
+зашифровывается на ключе K + 8 * j. Оставшаяся пара блоков обрабатывается 
+с чередованием тактов макросом R2K. Пара блоков на разных ключах 
+зашифровывается при каждом сжатии belt-compress (см. belt_compr.c).
+*******************************************************************************
+*/
+#define R4(a, b, c, d, K, i, subkey)\
+	R((&a##0), (&b##0), (&c##0), (&d##0), K, i, subkey);\
+	R((&a##1), (&b##1), (&c##1), (&d##1), K, i, subkey);\
+	R((&a##2), (&b##2), (&c##2), (&d##2), K, i, subkey);\
+	R((&a##3), (&b##3), (&c##3), (&d##3), K, i, subkey);\
+
+#define E4(K)\
+	R4(a, b, c, d, K, 1, subkey_e);\
+	R4(b, d, a, c, K, 2, subkey_e);\
+	R4(d, c, b, a, K, 3, subkey_e);\
+	R4(c, a, d, b, K, 4, subkey_e);\
+	R4(a, b, c, d, K, 5, subkey_e);\
+	R4(b, d, a, c, K, 6, subkey_e);\
+	R4(d, c, b, a, K, 7, subkey_e);\
+	R4(c, a, d, b, K, 8, subkey_e);\
+
+#define D4(K)\
+	R4(a, b, c, d, K, 8, subkey_d);\
+	R4(c, a, d, b, K, 7, subkey_d);\
+	R4(d, c, b, a, K, 6, subkey_d);\
+	R4(b, d, a, c, K, 5, subkey_d);\
+	R4(a, b, c, d, K, 4, subkey_d);\
+	R4(c, a, d, b, K, 3, subkey_d);\
+	R4(d, c, b, a, K, 2, subkey_d);\
+	R4(b, d, a, c, K, 1, subkey_d);\
+
+#define R4K(a, b, c, d, K, i, subkey)\
+	R((&a##0), (&b##0), (&c##0), (&d##0), (K), i, subkey);\
+	R((&a##1), (&b##1), (&c##1), (&d##1), (K + 8), i, subkey);\
+	R((&a##2), (&b##2), (&c##2), (&d##2), (K + 16), i, subkey);\
+	R((&a##3), (&b##3), (&c##3), (&d##3), (K + 24), i, subkey);\
+
+#define E4K(K)\
+	R4K(a, b, c, d, K, 1, subkey_e);\
+	R4K(b, d, a, c, K, 2, subkey_e);\
+	R4K(d, c, b, a, K, 3, subkey_e);\
+	R4K(c, a, d, b, K, 4, subkey_e);\
+	R4K(a, b, c, d, K, 5, subkey_e);\
+	R4K(b, d, a, c, K, 6, subkey_e);\
+	R4K(d, c, b, a, K, 7, subkey_e);\
+	R4K(c, a, d, b, K, 8, subkey_e);\
+
+#define R2K(a, b, c, d, K, i, subkey)\
+	R((&a##0), (&b##0), (&c##0), (&d##0), (K), i, subkey);\
+	R((&a##1), (&b##1), (&c##1), (&d##1), (K + 8), i, subkey);\
+
+#define E2K(K)\
+	R2K(a, b, c, d, K, 1, subkey_e);\
+	R2K(b, d, a, c, K, 2, subkey_e);\
+	R2K(d, c, b, a, K, 3, subkey_e);\
+	R2K(c, a, d, b, K, 4, subkey_e);\
+	R2K(a, b, c, d, K, 5, subkey_e);\
+	R2K(b, d, a, c, K, 6, subkey_e);\
+	R2K(d, c, b, a, K, 7, subkey_e);\
+	R2K(c, a, d, b, K, 8, subkey_e);\
+
+#define Load4(block)\
+	a0 = (block)[0], b0 = (block)[1], c0 = (block)[2], d0 = (block)[3],\
+	a1 = (block)[4], b1 = (block)[5], c1 = (block)[6], d1 = (block)[7],\
+	a2 = (block)[8], b2 = (block)[9], c2 = (block)[10], d2 = (block)[11],\
+	a3 = (block)[12], b3 = (block)[13], c3 = (block)[14], d3 = (block)[15]
+
+#define Store4(block, a, b, c, d)\
+	(block)[0] = a##0, (block)[1] = b##0,\
+	(block)[2] = c##0, (block)[3] = d##0,\
+	(block)[4] = a##1, (block)[5] = b##1,\
+	(block)[6] = c##1, (block)[7] = d##1,\
+	(block)[8] = a##2, (block)[9] = b##2,\
+	(block)[10] = c##2, (block)[11] = d##2,\
+	(block)[12] = a##3, (block)[13] = b##3,\
+	(block)[14] = c##3, (block)[15] = d##3
+
+static void beltBlockEncr4(u32 block[16], const u32 key[8])
+{
+	u32 a0, b0, c0, d0, a1, b1, c1, d1;
+	u32 a2, b2, c2, d2, a3, b3, c3, d3;
+	Load4(block);
+	E4(key);
+	Store4(block, b, d, a, c);
+}
+
+static void beltBlockDecr4(u32 block[16], const u32 key[8])
+{
+	u32 a0, b0, c0, d0, a1, b1, c1, d1;
+	u32 a2, b2, c2, d2, a3, b3, c3, d3;
+	Load4(block);
+	D4(key);
+	Store4(block, c, a, d, b);
+}
+
+static void beltBlockEncrPairK(u32 block[8], const u32 key[16])
+{
+	u32 a0, b0, c0, d0, a1, b1, c1, d1;
+	a0 = block[0], b0 = block[1], c0 = block[2], d0 = block[3];
+	a1 = block[4], b1 = block[5], c1 = block[6], d1 = block[7];
+	E2K(key);
+	block[0] = b0, block[1] = d0, block[2] = a0, block[3] = c0;
+	block[4] = b1, block[5] = d1, block[6] = a1, block[7] = c1;
+}
+
+static void beltBlockEncr4K(u32 block[16], const u32 key[32])
+{
+	u32 a0, b0, c0, d0, a1, b1, c1, d1;
+	u32 a2, b2, c2, d2, a3, b3, c3, d3;
+	Load4(block);
+	E4K(key);
+	Store4(block, b, d, a, c);
+}
+
+void beltBlockEncrN(u32 block[], size_t n, const u32 key[8])
+{
+	ASSERT(memIsValid(block, 16 * n));
+	ASSERT(memIsDisjoint2(block, 16 * n, key, 32));
+	beltHPrefetch();
+#ifdef BELT_AVX2
+	if (n >= 8 && beltBlockAVX2IsAvail())
+		for (; n >= 8; n -= 8, block += 32)
+			beltBlockEncr8_avx2(block, key);
+#endif
+	for (; n >= 4; n -= 4, block += 16)
+		beltBlockEncr4(block, key);
+	for (; n; --n, block += 4)
+	{
+		E((block + 0), (block + 1), (block + 2), (block + 3), key);
+	}
+}
+
+void beltBlockDecrN(u32 block[], size_t n, const u32 key[8])
+{
+	ASSERT(memIsValid(block, 16 * n));
+	ASSERT(memIsDisjoint2(block, 16 * n, key, 32));
+	beltHPrefetch();
+#ifdef BELT_AVX2
+	if (n >= 8 && beltBlockAVX2IsAvail())
+		for (; n >= 8; n -= 8, block += 32)
+			beltBlockDecr8_avx2(block, key);
+#endif
+	for (; n >= 4; n -= 4, block += 16)
+		beltBlockDecr4(block, key);
+	for (; n; --n, block += 4)
+	{
+		D((block + 0), (block + 1), (block + 2), (block + 3), key);
+	}
+}
+
+void beltBlockEncrNK(u32 block[], size_t n, const u32 key[])
+{
+	ASSERT(memIsValid(block, 16 * n));
+	ASSERT(memIsDisjoint2(block, 16 * n, key, 32 * n));
+	beltHPrefetch();
+#ifdef BELT_AVX2
+	if (n >= 8 && beltBlockAVX2IsAvail())
+		for (; n >= 8; n -= 8, block += 32, key += 64)
+			beltBlockEncr8K_avx2(block, key);
+#endif
+	for (; n >= 4; n -= 4, block += 16, key += 32)
+		beltBlockEncr4K(block, key);
+	if (n >= 2)
+		beltBlockEncrPairK(block, key), n -= 2, block += 8, key += 16;
+	for (; n; --n, block += 4, key += 8)
+	{
+		E((block + 0), (block + 1), (block + 2), (block + 3), key);
+	}
+}
+
+/*
+*******************************************************************************
+Подготовленный ключ
+*******************************************************************************
+*/
+
+size_t beltKey_keep()
+{
+	return sizeof(belt_key_st);
+}
+
+void beltKeyStart(void* ks, const octet key[], size_t len)
+{
+	belt_key_st* st = (belt_key_st*)ks;
+	ASSERT(memIsValid(ks, beltKey_keep()));
+	beltKeyExpand2(st->key, key, len);
+	beltBlockSetZero(st->r);
+	beltBlockEncr2(st->r, st->key);
+}
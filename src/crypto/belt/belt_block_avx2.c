@@ -0,0 +1,242 @@
+/*
+*******************************************************************************
+\file belt_block_avx2.c
+\brief STB 34.101.31 (belt): block encryption optimized for AVX2
+\project bee2 [cryptographic library]
+\created 2026.10.15
+\version 2026.10.16
+\copyright The Bee2 authors
+\license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
+*******************************************************************************
+*/
+
+#include "bee2/core/cpu.h"
+#include "bee2/core/mem.h"
+#include "bee2/core/util.h"
+#include "belt_lcl.h"
+
+#ifdef BELT_AVX2
+
+#include <immintrin.h>
+
+/*
+*******************************************************************************
+Проверка поддержки AVX2
+
+Поддержка определяется модулем cpu (см. cpuHas()). Кроме поддержки 
+инструкций AVX2 процессором, там проверяется, что операционная система 
+сохраняет 256-битовые регистры при переключении задач.
+*******************************************************************************
+*/
+
+bool_t beltBlockAVX2IsAvail()
+{
+	return cpuHas(CPU_AVX2);
+}
+
+/*
+*******************************************************************************
+Сокращения для используемых intrinsic
+
+Нотация: W (прописные буквы) -- 256-разрядное слово из восьми u32-слов.
+*******************************************************************************
+*/
+
+#define LOADU(s) _mm256_loadu_si256((__m256i const *)(s))
+#define STOREU(s, W) _mm256_storeu_si256((__m256i *)(s), (W))
+#define ZEROALL _mm256_zeroall()
+
+#define S8(w) _mm256_set1_epi32((int)(w))
+#define X8(W1, W2) _mm256_xor_si256(W1, W2)
+#define A8(W1, W2) _mm256_and_si256(W1, W2)
+#define ADD8(W1, W2) _mm256_add_epi32(W1, W2)
+#define SUB8(W1, W2) _mm256_sub_epi32(W1, W2)
+#define SR8(W, r) _mm256_srli_epi32(W, r)
+#define GATHER8(T, I) _mm256_i32gather_epi32((const int*)(T), I, 4)
+
+/*
+*******************************************************************************
+Восемь блоков
+
+Восемь форматированных блоков [32]u32 транспонируются: i-е слова блоков
+собираются в 256-разрядном слове. После этого такты belt выполняются
+одновременно над всеми блоками. Подстановки G реализуются выборками
+(gather) из таблиц beltH<r>.
+
+При транспонировании блоки располагаются в 32-битовых частях W в порядке
+0, 2, 4, 6, 1, 3, 5, 7. Обратное транспонирование восстанавливает
+исходный порядок.
+
+Макросы R8, E8, D8 повторяют макросы R, E, D из belt_block.c.
+Перестановки регистров и окончательные перестановки (abcd -> bdac при
+зашифровании и abcd -> cadb при расшифровании) реализуются перестановкой
+параметров.
+*******************************************************************************
+*/
+
+#define Transpose8(W0, W1, W2, W3, U0, U1, U2, U3)\
+	U0 = _mm256_unpacklo_epi32(W0, W1);\
+	U1 = _mm256_unpackhi_epi32(W0, W1);\
+	U2 = _mm256_unpacklo_epi32(W2, W3);\
+	U3 = _mm256_unpackhi_epi32(W2, W3);\
+	W0 = _mm256_unpacklo_epi64(U0, U2);\
+	W1 = _mm256_unpackhi_epi64(U0, U2);\
+	W2 = _mm256_unpacklo_epi64(U1, U3);\
+	W3 = _mm256_unpackhi_epi64(U1, U3)
+
+#define Untranspose8(W0, W1, W2, W3, U0, U1, U2, U3)\
+	U0 = _mm256_unpacklo_epi32(W0, W1);\
+	U1 = _mm256_unpacklo_epi32(W2, W3);\
+	U2 = _mm256_unpackhi_epi32(W0, W1);\
+	U3 = _mm256_unpackhi_epi32(W2, W3);\
+	W0 = _mm256_unpacklo_epi64(U0, U1);\
+	W1 = _mm256_unpackhi_epi64(U0, U1);\
+	W2 = _mm256_unpacklo_epi64(U2, U3);\
+	W3 = _mm256_unpackhi_epi64(U2, U3)
+
+#define G8(W, H0, H1, H2, H3)\
+	X8(X8(GATHER8(H0, A8(W, M)), GATHER8(H1, A8(SR8(W, 8), M))),\
+		X8(GATHER8(H2, A8(SR8(W, 16), M)), GATHER8(H3, SR8(W, 24))))
+
+#define G5(W) G8(W, beltH5, beltH13, beltH21, beltH29)
+#define G13(W) G8(W, beltH13, beltH21, beltH29, beltH5)
+#define G21(W) G8(W, beltH21, beltH29, beltH5, beltH13)
+
+#define R8(a, b, c, d, K, i, subkey)\
+	b = X8(b, G5(ADD8(a, subkey(K, i, 0))));\
+	c = X8(c, G21(ADD8(d, subkey(K, i, 1))));\
+	a = SUB8(a, G13(ADD8(b, subkey(K, i, 2))));\
+	c = ADD8(c, b);\
+	b = ADD8(b, X8(G21(ADD8(c, subkey(K, i, 3))), S8(i)));\
+	c = SUB8(c, b);\
+	d = ADD8(d, G13(ADD8(c, subkey(K, i, 4))));\
+	b = X8(b, G21(ADD8(a, subkey(K, i, 5))));\
+	c = X8(c, G5(ADD8(d, subkey(K, i, 6))));\
+
+#define subkey_e(K, i, j) K[(7 * (i) - 7 + (j)) % 8]
+#define subkey_d(K, i, j) K[(7 * (i) - 1 - (j)) % 8]
+
+#define E8(a, b, c, d, K)\
+	R8(a, b, c, d, K, 1, subkey_e);\
+	R8(b, d, a, c, K, 2, subkey_e);\
+	R8(d, c, b, a, K, 3, subkey_e);\
+	R8(c, a, d, b, K, 4, subkey_e);\
+	R8(a, b, c, d, K, 5, subkey_e);\
+	R8(b, d, a, c, K, 6, subkey_e);\
+	R8(d, c, b, a, K, 7, subkey_e);\
+	R8(c, a, d, b, K, 8, subkey_e);\
+
+#define D8(a, b, c, d, K)\
+	R8(a, b, c, d, K, 8, subkey_d);\
+	R8(c, a, d, b, K, 7, subkey_d);\
+	R8(d, c, b, a, K, 6, subkey_d);\
+	R8(b, d, a, c, K, 5, subkey_d);\
+	R8(a, b, c, d, K, 4, subkey_d);\
+	R8(c, a, d, b, K, 3, subkey_d);\
+	R8(d, c, b, a, K, 2, subkey_d);\
+	R8(b, d, a, c, K, 1, subkey_d);\
+
+BELT_AVX2_TARGET
+void beltBlockEncr8_avx2(u32 block[32], const u32 key[8])
+{
+	__m256i a, b, c, d;
+	__m256i U0, U1, U2, U3;
+	__m256i K[8];
+	__m256i M;
+	size_t i;
+	// подготовить ключ и маску
+	for (i = 0; i < 8; ++i)
+		K[i] = S8(key[i]);
+	M = S8(255);
+	// загрузить и транспонировать блоки
+	a = LOADU(block), b = LOADU(block + 8);
+	c = LOADU(block + 16), d = LOADU(block + 24);
+	Transpose8(a, b, c, d, U0, U1, U2, U3);
+	// зашифровать
+	E8(a, b, c, d, K);
+	// транспонировать и выгрузить блоки
+	Untranspose8(b, d, a, c, U0, U1, U2, U3);
+	STOREU(block, b), STOREU(block + 8, d);
+	STOREU(block + 16, a), STOREU(block + 24, c);
+	// очистить регистры и ключ
+	ZEROALL;
+	memWipe(K, sizeof(K));
+}
+
+BELT_AVX2_TARGET
+void beltBlockDecr8_avx2(u32 block[32], const u32 key[8])
+{
+	__m256i a, b, c, d;
+	__m256i U0, U1, U2, U3;
+	__m256i K[8];
+	__m256i M;
+	size_t i;
+	// подготовить ключ и маску
+	for (i = 0; i < 8; ++i)
+		K[i] = S8(key[i]);
+	M = S8(255);
+	// загрузить и транспонировать блоки
+	a = LOADU(block), b = LOADU(block + 8);
+	c = LOADU(block + 16), d = LOADU(block + 24);
+	Transpose8(a, b, c, d, U0, U1, U2, U3);
+	// расшифровать
+	D8(a, b, c, d, K);
+	// транспонировать и выгрузить блоки
+	Untranspose8(c, a, d, b, U0, U1, U2, U3);
+	STOREU(block, c), STOREU(block + 8, a);
+	STOREU(block + 16, d), STOREU(block + 24, b);
+	// очистить регистры и ключ
+	ZEROALL;
+	memWipe(K, sizeof(K));
+}
+
+/*
+*******************************************************************************
+Восемь блоков на восьми ключах
+
+Ключи [8]u32 транспонируются так же, как блоки: сначала обрабатываются 
+первые половины ключей (слова 0-3), затем вторые (слова 4-7). Половины 
+ключей с номерами 2i и 2i + 1 объединяются в одном 256-разрядном слове 
+(_mm256_permute2x128_si256()), после чего применяется Transpose8. 
+В результате j-е слова ключей располагаются в K[j] в том же порядке, 
+что и слова блоков.
+*******************************************************************************
+*/
+
+#define LO2(W1, W2) _mm256_permute2x128_si256(W1, W2, 0x20)
+#define HI2(W1, W2) _mm256_permute2x128_si256(W1, W2, 0x31)
+
+BELT_AVX2_TARGET
+void beltBlockEncr8K_avx2(u32 block[32], const u32 key[64])
+{
+	__m256i a, b, c, d;
+	__m256i U0, U1, U2, U3;
+	__m256i K[8];
+	__m256i M;
+	size_t i;
+	// загрузить ключи
+	for (i = 0; i < 4; ++i)
+	{
+		a = LOADU(key + 16 * i), b = LOADU(key + 16 * i + 8);
+		K[i] = LO2(a, b), K[i + 4] = HI2(a, b);
+	}
+	// транспонировать ключи
+	Transpose8(K[0], K[1], K[2], K[3], U0, U1, U2, U3);
+	Transpose8(K[4], K[5], K[6], K[7], U0, U1, U2, U3);
+	M = S8(255);
+	// загрузить и транспонировать блоки
+	a = LOADU(block), b = LOADU(block + 8);
+	c = LOADU(block + 16), d = LOADU(block + 24);
+	Transpose8(a, b, c, d, U0, U1, U2, U3);
+	// зашифровать
+	E8(a, b, c, d, K);
+	// транспонировать и выгрузить блоки
+	Untranspose8(b, d, a, c, U0, U1, U2, U3);
+	STOREU(block, b), STOREU(block + 8, d);
+	STOREU(block + 16, a), STOREU(block + 24, c);
+	// очистить регистры и ключи
+	ZEROALL;
+	memWipe(K, sizeof(K));
+}
+
+#endif /* BELT_AVX2 */
@@ -4,7 +4,7 @@
 \brief STB 34.101.31 (belt): CBC encryption
 \project bee2 [cryptographic library]
 \created 2012.12.18
-\version 2025.10.02
+\version 2026.10.16
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
@@ -13,6 +13,7 @@
 #include "bee2/core/blob.h"
 #include "bee2/core/err.h"
 #include "bee2/core/mem.h"
+#include "bee2/core/u32.h"
 #include "bee2/core/util.h"
 #include "bee2/crypto/belt.h"
 #include "belt_lcl.h"
@@ -72,6 +73,7 @@ typedef struct
 	u32 key[8];			/*< форматированный ключ */
 	octet block[16];	/*< вспомогательный блок */
 	octet block1[16];	/*< второй вспомогательный блок */
+	u32 blocks[4 * BELT_BLOCK_N];	/*< порция блоков */
 } belt_cbc_st;
 
 size_t beltCBC_keep()
@@ -88,6 +90,15 @@ void beltCBCStart(void* state, const octet key[], size_t len,
 	beltBlockCopy(st->block, iv);
 }
 
+void beltCBCStartK(void* state, const void* ks, const octet iv[16])
+{
+	belt_cbc_st* st = (belt_cbc_st*)state;
+	ASSERT(memIsDisjoint2(iv, 16, state, beltCBC_keep()));
+	ASSERT(memIsValid(ks, beltKey_keep()));
+	memCopy(st->key, ((const belt_key_st*)ks)->key, 32);
+	beltBlockCopy(st->block, iv);
+}
+
 void beltCBCStepE(void* buf, size_t count, void* state)
 {
 	belt_cbc_st* st = (belt_cbc_st*)state;
@@ -118,6 +129,20 @@ void beltCBCStepD(void* buf, size_t count, void* state)
 	belt_cbc_st* st = (belt_cbc_st*)state;
 	ASSERT(count >= 16);
 	ASSERT(memIsDisjoint2(buf, count, state, beltCBC_keep()));
+	// цикл по порциям блоков (последний полный блок не захватывается, 
+	// если за ним следует неполный)
+	while(count >= 16 * BELT_BLOCK_N + 16 || count == 16 * BELT_BLOCK_N)
+	{
+		u32From(st->blocks, buf, 16 * BELT_BLOCK_N);
+		beltBlockDecrN(st->blocks, BELT_BLOCK_N, st->key);
+		u32To(st->blocks, 16 * BELT_BLOCK_N, st->blocks);
+		beltBlockXor2(st->blocks, st->block);
+		memXor2(st->blocks + 4, buf, 16 * BELT_BLOCK_N - 16);
+		beltBlockCopy(st->block, (octet*)buf + 16 * BELT_BLOCK_N - 16);
+		memCopy(buf, st->blocks, 16 * BELT_BLOCK_N);
+		buf = (octet*)buf + 16 * BELT_BLOCK_N;
+		count -= 16 * BELT_BLOCK_N;
+	}
 	// цикл по полным блокам
 	while(count >= 32 || count == 16)
 	{
@@ -142,6 +167,86 @@ void beltCBCStepD(void* buf, size_t count, void* state)
 	}
 }
 
+/*
+*******************************************************************************
+Зашифрование нескольких потоков в режиме CBC
+
+Зашифрования внутри потока выполняются последовательно, а зашифрования 
+разных потоков независимы. Поэтому потоки размещаются в BELT_BLOCK_N 
+ячейках, и очередные блоки потоков из всех занятых ячеек зашифровываются 
+одним обращением к beltBlockEncrNK(). Ключ потока копируется в массив 
+ключей один раз -- при занятии ячейки. Поток освобождает ячейку, когда 
+у него остается 0 октетов или от 17 до 31 октета (последний полный блок 
+и неполный блок). Во втором случае выполняется кража блока 
+(beltCBCStepE()). Освободившуюся ячейку занимает следующий поток.
+*******************************************************************************
+*/
+
+void beltCBCStepEMulti(void* buf[], const size_t count[], void* state[], 
+	size_t n)
+{
+	u32 keys[8 * BELT_BLOCK_N];
+	u32 blocks[4 * BELT_BLOCK_N];
+	belt_cbc_st* sts[BELT_BLOCK_N];
+	octet* bufs[BELT_BLOCK_N];
+	size_t counts[BELT_BLOCK_N];
+	size_t next, m, j;
+	ASSERT(memIsValid(buf, n * sizeof(void*)));
+	ASSERT(memIsValid(count, n * sizeof(size_t)));
+	ASSERT(memIsValid(state, n * sizeof(void*)));
+	for (next = m = 0;;)
+	{
+		// занять свободные ячейки
+		for (; m < BELT_BLOCK_N && next < n; ++next)
+		{
+			ASSERT(count[next] == 0 || count[next] >= 16);
+			ASSERT(memIsDisjoint2(buf[next], count[next], 
+				state[next], beltCBC_keep()));
+			if (count[next] == 16 || count[next] >= 32)
+			{
+				sts[m] = (belt_cbc_st*)state[next];
+				bufs[m] = (octet*)buf[next];
+				counts[m] = count[next];
+				memCopy(keys + 8 * m, sts[m]->key, 32);
+				++m;
+			}
+			else if (count[next])
+				beltCBCStepE(buf[next], count[next], state[next]);
+		}
+		// все потоки обработаны?
+		if (m == 0)
+			break;
+		// зашифровать очередные блоки
+		for (j = 0; j < m; ++j)
+		{
+			beltBlockXor2(sts[j]->block, bufs[j]);
+			u32From(blocks + 4 * j, sts[j]->block, 16);
+		}
+		beltBlockEncrNK(blocks, m, keys);
+		for (j = 0; j < m; ++j)
+		{
+			u32To(sts[j]->block, 16, blocks + 4 * j);
+			beltBlockCopy(bufs[j], sts[j]->block);
+			bufs[j] += 16, counts[j] -= 16;
+		}
+		// освободить ячейки
+		for (j = m; j--;)
+		{
+			if (counts[j] == 16 || counts[j] >= 32)
+				continue;
+			if (counts[j])
+				beltCBCStepE(bufs[j], counts[j], sts[j]);
+			if (j < --m)
+			{
+				sts[j] = sts[m], bufs[j] = bufs[m], counts[j] = counts[m];
+				memCopy(keys + 8 * j, keys + 8 * m, 32);
+			}
+		}
+	}
+	memWipe(keys, sizeof(keys));
+	memWipe(blocks, sizeof(blocks));
+}
+
 err_t beltCBCEncr(void* dest, const void* src, size_t count,
 	const octet key[], size_t len, const octet iv[16])
 {
@@ -4,7 +4,7 @@
 \brief STB 34.101.31 (belt): CFB encryption
 \project bee2 [cryptographic library]
 \created 2012.12.18
-\version 2020.03.24
+\version 2026.10.16
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
@@ -13,6 +13,7 @@
 #include "bee2/core/blob.h"
 #include "bee2/core/err.h"
 #include "bee2/core/mem.h"
+#include "bee2/core/u32.h"
 #include "bee2/core/util.h"
 #include "bee2/crypto/belt.h"
 #include "belt_lcl.h"
@@ -26,6 +27,7 @@ typedef struct
 {
 	u32 key[8];			/*< форматированный ключ */
 	octet block[16];	/*< блок гаммы */
+	u32 blocks[4 * BELT_BLOCK_N];	/*< порция блоков гаммы */
 	size_t reserved;	/*< резерв октетов гаммы */
 } belt_cfb_st;
 
@@ -44,6 +46,16 @@ void beltCFBStart(void* state, const octet key[], size_t len,
 	st->reserved = 0;
 }
 
+void beltCFBStartK(void* state, const void* ks, const octet iv[16])
+{
+	belt_cfb_st* st = (belt_cfb_st*)state;
+	ASSERT(memIsDisjoint2(iv, 16, state, beltCFB_keep()));
+	ASSERT(memIsValid(ks, beltKey_keep()));
+	memCopy(st->key, ((const belt_key_st*)ks)->key, 32);
+	beltBlockCopy(st->block, iv);
+	st->reserved = 0;
+}
+
 void beltCFBStepE(void* buf, size_t count, void* state)
 {
 	belt_cfb_st* st = (belt_cfb_st*)state;
@@ -103,6 +115,18 @@ void beltCFBStepD(void* buf, size_t count, void* state)
 		buf = (octet*)buf + st->reserved;
 		st->reserved = 0;
 	}
+	// цикл по порциям блоков
+	while (count >= 16 * BELT_BLOCK_N)
+	{
+		u32From(st->blocks, st->block, 16);
+		u32From(st->blocks + 4, buf, 16 * BELT_BLOCK_N - 16);
+		beltBlockEncrN(st->blocks, BELT_BLOCK_N, st->key);
+		u32To(st->blocks, 16 * BELT_BLOCK_N, st->blocks);
+		beltBlockCopy(st->block, (octet*)buf + 16 * BELT_BLOCK_N - 16);
+		memXor2(buf, st->blocks, 16 * BELT_BLOCK_N);
+		buf = (octet*)buf + 16 * BELT_BLOCK_N;
+		count -= 16 * BELT_BLOCK_N;
+	}
 	// цикл по полным блокам
 	while (count >= 16)
 	{
@@ -4,7 +4,7 @@
 \brief STB 34.101.31 (belt): CHE (Ctr-Hash-Encrypt) authenticated encryption
 \project bee2 [cryptographic library]
 \created 2020.03.20
-\version 2025.10.02
+\version 2026.10.16
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
@@ -13,6 +13,7 @@
 #include "bee2/core/blob.h"
 #include "bee2/core/err.h"
 #include "bee2/core/mem.h"
+#include "bee2/core/u32.h"
 #include "bee2/core/util.h"
 #include "bee2/crypto/belt.h"
 #include "bee2/math/ww.h"
@@ -28,35 +29,34 @@ typedef struct
 {
 	u32 key[8];				/*< форматированный ключ */
 	u32 s[4];				/*< переменная s */
-	word r[W_OF_B(128)];	/*< переменная r */
+	belt_poly_st poly[1];	/*< умножение на r */
 	word t[W_OF_B(128)];	/*< переменная t */
 	word t1[W_OF_B(128)];	/*< копия t/имитовставка */
 	word len[W_OF_B(128)];	/*< обработано открытых || критических данных */
 	octet block[16];		/*< блок аутентифицируемых данных */
 	octet block1[16];		/*< блок гаммы */
+	u32 blocks[4 * BELT_BLOCK_N];	/*< порция блоков гаммы */
 	size_t filled;			/*< накоплено октетов в block */
 	size_t reserved;		/*< резерв октетов гаммы */
-	mem_align_t stack[];	/*< стек умножения */
 } belt_che_st;
 
 size_t beltCHE_keep()
 {
-	return sizeof(belt_che_st) + beltPolyMul_deep();
+	return sizeof(belt_che_st);
 }
 
-void beltCHEStart(void* state, const octet key[], size_t len, 
-	const octet iv[16])
+static void beltCHEStart_internal(void* state, const octet iv[16])
 {
 	belt_che_st* st = (belt_che_st*)state;
-	ASSERT(memIsDisjoint2(iv, 16, state, beltCHE_keep()));
-	// разобрать key и iv
-	beltKeyExpand2(st->key, key, len);
-	beltBlockCopy(st->r, iv);
-	beltBlockEncr((octet*)st->r, st->key);
-	u32From(st->s, st->r, 16);
+	// разобрать iv
+	beltBlockCopy(st->t1, iv);
+	beltBlockEncr((octet*)st->t1, st->key);
+	u32From(st->s, st->t1, 16);
 #if (OCTET_ORDER == BIG_ENDIAN)
-	beltBlockRevW(st->r);
+	beltBlockRevW(st->t1);
 #endif
+	// подготовить умножение на r (r -- в t1)
+	beltPolyStart(st->poly, st->t1);
 	// подготовить t
 	wwFrom(st->t, beltH(), 16);
 	// обнулить счетчики
@@ -65,9 +65,28 @@ void beltCHEStart(void* state, const octet key[], size_t len,
 	st->filled = 0;
 }
 
+void beltCHEStart(void* state, const octet key[], size_t len, 
+	const octet iv[16])
+{
+	belt_che_st* st = (belt_che_st*)state;
+	ASSERT(memIsDisjoint2(iv, 16, state, beltCHE_keep()));
+	beltKeyExpand2(st->key, key, len);
+	beltCHEStart_internal(state, iv);
+}
+
+void beltCHEStartK(void* state, const void* ks, const octet iv[16])
+{
+	belt_che_st* st = (belt_che_st*)state;
+	ASSERT(memIsDisjoint2(iv, 16, state, beltCHE_keep()));
+	ASSERT(memIsValid(ks, beltKey_keep()));
+	memCopy(st->key, ((const belt_key_st*)ks)->key, 32);
+	beltCHEStart_internal(state, iv);
+}
+
 void beltCHEStepE(void* buf, size_t count, void* state)
 {
 	belt_che_st* st = (belt_che_st*)state;
+	size_t i;
 	ASSERT(memIsDisjoint2(buf, count, state, beltCHE_keep()));
 	// есть резерв гаммы?
 	if (st->reserved)
@@ -83,6 +102,22 @@ void beltCHEStepE(void* buf, size_t count, void* state)
 		buf = (octet*)buf + st->reserved;
 		st->reserved = 0;
 	}
+	// цикл по порциям блоков
+	while (count >= 16 * BELT_BLOCK_N)
+	{
+		for (i = 0; i < BELT_BLOCK_N; ++i)
+		{
+			beltBlockMulCU32(st->s), st->s[0] ^= 0x00000001;
+			beltBlockCopy(st->blocks + 4 * i, st->s);
+		}
+		beltBlockEncrN(st->blocks, BELT_BLOCK_N, st->key);
+#if (OCTET_ORDER == BIG_ENDIAN)
+		u32Rev2(st->blocks, 4 * BELT_BLOCK_N);
+#endif
+		memXor2(buf, st->blocks, 16 * BELT_BLOCK_N);
+		buf = (octet*)buf + 16 * BELT_BLOCK_N;
+		count -= 16 * BELT_BLOCK_N;
+	}
 	// цикл по полным блокам
 	while (count >= 16)
 	{
@@ -136,21 +171,13 @@ void beltCHEStepI(const void* buf, size_t count, void* state)
 		beltBlockRevW(st->block);
 #endif
 		beltBlockXor2(st->t, st->block);
-		beltPolyMul(st->t, st->t, st->r, st->stack);
+		beltPolyMulR(st->t, st->poly);
 		st->filled = 0;
 	}
 	// цикл по полным блокам
-	while (count >= 16)
-	{
-		beltBlockCopy(st->block, buf);
-#if (OCTET_ORDER == BIG_ENDIAN)
-		beltBlockRevW(st->block);
-#endif
-		beltBlockXor2(st->t, st->block);
-		beltPolyMul(st->t, st->t, st->r, st->stack);
-		buf = (const octet*)buf + 16;
-		count -= 16;
-	}
+	beltPolyStepA(st->t, buf, count - count % 16, st->poly);
+	buf = (const octet*)buf + count - count % 16;
+	count %= 16;
 	// неполный блок?
 	if (count)
 		memCopy(st->block, buf, st->filled = count);
@@ -169,7 +196,7 @@ void beltCHEStepA(const void* buf, size_t count, void* state)
 		beltBlockRevW(st->block);
 #endif
 		beltBlockXor2(st->t, st->block);
-		beltPolyMul(st->t, st->t, st->r, st->stack);
+		beltPolyMulR(st->t, st->poly);
 		st->filled = 0;
 	}
 	// обновить длину
@@ -190,21 +217,13 @@ void beltCHEStepA(const void* buf, size_t count, void* state)
 		beltBlockRevW(st->block);
 #endif
 		beltBlockXor2(st->t, st->block);
-		beltPolyMul(st->t, st->t, st->r, st->stack);
+		beltPolyMulR(st->t, st->poly);
 		st->filled = 0;
 	}
 	// цикл по полным блокам
-	while (count >= 16)
-	{
-		beltBlockCopy(st->block, buf);
-#if (OCTET_ORDER == BIG_ENDIAN)
-		beltBlockRevW(st->block);
-#endif
-		beltBlockXor2(st->t, st->block);
-		beltPolyMul(st->t, st->t, st->r, st->stack);
-		buf = (const octet*)buf + 16;
-		count -= 16;
-	}
+	beltPolyStepA(st->t, buf, count - count % 16, st->poly);
+	buf = (const octet*)buf + count - count % 16;
+	count %= 16;
 	// неполный блок?
 	if (count)
 		memCopy(st->block, buf, st->filled = count);
@@ -215,6 +234,32 @@ void beltCHEStepD(void* buf, size_t count, void* state)
 	beltCHEStepE(buf, count, state);
 }
 
+void beltCHEStepEA(void* buf, size_t count, void* state)
+{
+	size_t c;
+	ASSERT(memIsDisjoint2(buf, count, state, beltCHE_keep()));
+	for (; count; count -= c)
+	{
+		c = MIN2(count, BELT_EA_SIZE);
+		beltCHEStepE(buf, c, state);
+		beltCHEStepA(buf, c, state);
+		buf = (octet*)buf + c;
+	}
+}
+
+void beltCHEStepAD(void* buf, size_t count, void* state)
+{
+	size_t c;
+	ASSERT(memIsDisjoint2(buf, count, state, beltCHE_keep()));
+	for (; count; count -= c)
+	{
+		c = MIN2(count, BELT_EA_SIZE);
+		beltCHEStepA(buf, c, state);
+		beltCHEStepD(buf, c, state);
+		buf = (octet*)buf + c;
+	}
+}
+
 static void beltCHEStepG_internal(void* state)
 {
 	belt_che_st* st = (belt_che_st*)state;
@@ -225,13 +270,13 @@ static void beltCHEStepG_internal(void* state)
 		memSetZero(st->block + st->filled, 16 - st->filled);
 		wwFrom(st->t1, st->block, 16);
 		beltBlockXor2(st->t1, st->t);
-		beltPolyMul(st->t1, st->t1, st->r, st->stack);
+		beltPolyMulR(st->t1, st->poly);
 	}
 	else
 		memCopy(st->t1, st->t, 16);
 	// обработать блок длины
 	beltBlockXor2(st->t1, st->len);
-	beltPolyMul(st->t1, st->t1, st->r, st->stack);
+	beltPolyMulR(st->t1, st->poly);
 #if (OCTET_ORDER == BIG_ENDIAN)
 	beltBlockRevW(st->t1);
 #endif
@@ -276,8 +321,7 @@ err_t beltCHEWrap(void* dest, octet mac[8], const void* src1, size_t count1,
 	beltCHEStart(state, key, len, iv);
 	beltCHEStepI(src2, count2, state);
 	memMove(dest, src1, count1);
-	beltCHEStepE(dest, count1, state);
-	beltCHEStepA(dest, count1, state);
+	beltCHEStepEA(dest, count1, state);
 	beltCHEStepG(mac, state);
 	// завершить
 	blobClose(state);
@@ -305,14 +349,32 @@ err_t beltCHEUnwrap(void* dest, const void* src1, size_t count1,
 	// снять защиту
 	beltCHEStart(state, key, len, iv);
 	beltCHEStepI(src2, count2, state);
-	beltCHEStepA(src1, count1, state);
-	if (!beltCHEStepV(mac, state))
+	// dest не пересекается с входными данными?
+	// совместить проверку имитовставки и расшифрование
+	if (memIsDisjoint2(dest, count1, src1, count1) &&
+		memIsDisjoint2(dest, count1, src2, count2) &&
+		memIsDisjoint2(dest, count1, mac, 8))
 	{
-		blobClose(state);
-		return ERR_BAD_MAC;
+		memCopy(dest, src1, count1);
+		beltCHEStepAD(dest, count1, state);
+		if (!beltCHEStepV(mac, state))
+		{
+			memSetZero(dest, count1);
+			blobClose(state);
+			return ERR_BAD_MAC;
+		}
+	}
+	else
+	{
+		beltCHEStepA(src1, count1, state);
+		if (!beltCHEStepV(mac, state))
+		{
+			blobClose(state);
+			return ERR_BAD_MAC;
+		}
+		memMove(dest, src1, count1);
+		beltCHEStepD(dest, count1, state);
 	}
-	memMove(dest, src1, count1);
-	beltCHEStepD(dest, count1, state);
 	// завершить
 	blobClose(state);
 	return ERR_OK;
@@ -4,7 +4,7 @@
 \brief STB 34.101.31 (belt): compression
 \project bee2 [cryptographic library]
 \created 2012.12.18
-\version 2025.09.24
+\version 2026.10.16
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
@@ -21,47 +21,50 @@
 
 h и X разбиваются на половинки:
 	[8]h = [4]h0 || [4]h1, [8]X = [4]X0 || [4]X1.
+
+Второе и третье зашифрования (X0 на ключе S || h1, X1 на ключе ~S || h0) 
+не зависят друг от друга. Они выполняются совместно, с чередованием 
+тактов, функцией beltBlockEncrNK(). Ключи размещаются в стеке подряд:
+	[16]buf = [4]buf0 || [4]buf1 || [4]buf2 || [4]buf3,
+	buf01 == K1 = S || h1, buf23 == K2 = ~S || h0.
+Зашифровываемые блоки X0 и X1 предварительно копируются в h.
 *******************************************************************************
 */
 
 void beltCompr(u32 h[8], const u32 X[8], void* stack)
 {
 	u32* buf;
-	// [12]buf = [4]buf0 || [4]buf1 || [4]buf2
+	// [16]buf = [4]buf0 || [4]buf1 || [4]buf2 || [4]buf3
 	ASSERT(memIsAligned(stack, 4));
 	buf = (u32*)stack;
 	// буферы не пересекаются?
-	ASSERT(memIsDisjoint3(h, 32, X, 32, buf, 48));
+	ASSERT(memIsDisjoint3(h, 32, X, 32, buf, 64));
 	// buf0, buf1 <- h0 + h1
 	beltBlockXor(buf, h, h + 4);
 	beltBlockCopy(buf + 4, buf);
 	// buf0 <- beltBlock(buf0, X) + buf1
 	beltBlockEncr2(buf, X);
 	beltBlockXor2(buf, buf + 4);
-	// buf2 <- h0
-	beltBlockCopy(buf + 8, h);
-	// buf1 <- h1 [buf01 == K1]
+	// buf1 <- h1, buf2 <- ~buf0, buf3 <- h0 [buf01 == K1, buf23 == K2]
 	beltBlockCopy(buf + 4, h + 4);
-	// h0 <- beltBlock(X0, buf01) + X0
+	beltBlockNeg(buf + 8, buf);
+	beltBlockCopy(buf + 12, h);
+	// h0 <- beltBlock(X0, buf01) + X0, h1 <- beltBlock(X1, buf23) + X1
 	beltBlockCopy(h, X);
-	beltBlockEncr2(h, buf);
-	beltBlockXor2(h, X);
-	// buf1 <- ~buf0 [buf12 == K2]
-	beltBlockNeg(buf + 4, buf);
-	// h1 <- beltBlock(X1, buf12) + X1
 	beltBlockCopy(h + 4, X + 4);
-	beltBlockEncr2(h + 4, buf + 4);
+	beltBlockEncrNK(h, 2, buf);
+	beltBlockXor2(h, X);
 	beltBlockXor2(h + 4, X + 4);
 }
 
 void beltCompr2(u32 s[4], u32 h[8], const u32 X[8], void* stack)
 {
 	u32* buf;
-	// [12]buf = [4]buf0 || [4]buf1 || [4]buf2
+	// [16]buf = [4]buf0 || [4]buf1 || [4]buf2 || [4]buf3
 	ASSERT(memIsAligned(stack, 4));
 	buf = (u32*)stack;
 	// буферы не пересекаются?
-	ASSERT(memIsDisjoint4(s, 16, h, 32, X, 32, buf, 48));
+	ASSERT(memIsDisjoint4(s, 16, h, 32, X, 32, buf, 64));
 	// buf0, buf1 <- h0 + h1
 	beltBlockXor(buf, h, h + 4);
 	beltBlockCopy(buf + 4, buf);
@@ -70,23 +73,96 @@ void beltCompr2(u32 s[4], u32 h[8], const u32 X[8], void* stack)
 	beltBlockXor2(buf, buf + 4);
 	// s <- s ^ buf0
 	beltBlockXor2(s, buf);
-	// buf2 <- h0
-	beltBlockCopy(buf + 8, h);
-	// buf1 <- h1 [buf01 == K1]
+	// buf1 <- h1, buf2 <- ~buf0, buf3 <- h0 [buf01 == K1, buf23 == K2]
 	beltBlockCopy(buf + 4, h + 4);
-	// h0 <- beltBlock(X0, buf01) + X0
+	beltBlockNeg(buf + 8, buf);
+	beltBlockCopy(buf + 12, h);
+	// h0 <- beltBlock(X0, buf01) + X0, h1 <- beltBlock(X1, buf23) + X1
 	beltBlockCopy(h, X);
-	beltBlockEncr2(h, buf);
-	beltBlockXor2(h, X);
-	// buf1 <- ~buf0 [buf12 == K2]
-	beltBlockNeg(buf + 4, buf);
-	// h1 <- beltBlock(X1, buf12) + X1
 	beltBlockCopy(h + 4, X + 4);
-	beltBlockEncr2(h + 4, buf + 4);
+	beltBlockEncrNK(h, 2, buf);
+	beltBlockXor2(h, X);
 	beltBlockXor2(h + 4, X + 4);
 }
 
 size_t beltCompr_deep()
 {
-	return 12 * 4;
+	return 16 * 4;
+}
+
+/*
+*******************************************************************************
+Многопотоковое сжатие
+
+Функция beltCompr2N() выполняет n <= BELT_BLOCK_N независимых сжатий: 
+i-й буфер h[i] || X[i] сжимается до h[i], и, если s != 0, внутренняя 
+переменная S добавляется к s[i].
+
+Каждое сжатие состоит из трех зашифрований. Первое зашифрование 
+(на ключе X) выполняется для всех n сжатий за одно обращение 
+к beltBlockEncrNK(). Второе и третье зашифрования (на ключах S || h1 и 
+~S || h0) не зависят друг от друга и выполняются для всех n сжатий 
+за еще одно обращение.
+
+Стек: 
+	[4 * BELT_BLOCK_N]blocks || [8 * BELT_BLOCK_N]keys ||
+	[8 * BELT_BLOCK_N]blocks2 || [16 * BELT_BLOCK_N]keys2.
+*******************************************************************************
+*/
+
+void beltCompr2N(u32* s[], u32* h[], const u32* X[], size_t n, void* stack)
+{
+	u32* blocks;
+	u32* keys;
+	u32* blocks2;
+	u32* keys2;
+	size_t i;
+	ASSERT(n <= BELT_BLOCK_N);
+	ASSERT(memIsAligned(stack, 4));
+	// разметить стек
+	blocks = (u32*)stack;
+	keys = blocks + 4 * BELT_BLOCK_N;
+	blocks2 = keys + 8 * BELT_BLOCK_N;
+	keys2 = blocks2 + 8 * BELT_BLOCK_N;
+	// blocks_i <- h0_i + h1_i, keys_i <- X_i
+	for (i = 0; i < n; ++i)
+	{
+		ASSERT(memIsDisjoint2(h[i], 32, X[i], 32));
+		ASSERT(s == 0 || memIsDisjoint3(s[i], 16, h[i], 32, X[i], 32));
+		beltBlockXor(blocks + 4 * i, h[i], h[i] + 4);
+		beltBlockCopy(keys + 8 * i, X[i]);
+		beltBlockCopy(keys + 8 * i + 4, X[i] + 4);
+	}
+	// blocks_i <- beltBlock(blocks_i, keys_i)
+	beltBlockEncrNK(blocks, n, keys);
+	for (i = 0; i < n; ++i)
+	{
+		// S_i <- blocks_i + h0_i + h1_i
+		beltBlockXor2(blocks + 4 * i, h[i]);
+		beltBlockXor2(blocks + 4 * i, h[i] + 4);
+		// s_i <- s_i ^ S_i
+		if (s)
+			beltBlockXor2(s[i], blocks + 4 * i);
+		// keys2_{2i} <- S_i || h1_i, keys2_{2i+1} <- ~S_i || h0_i
+		beltBlockCopy(keys2 + 16 * i, blocks + 4 * i);
+		beltBlockCopy(keys2 + 16 * i + 4, h[i] + 4);
+		beltBlockNeg(keys2 + 16 * i + 8, blocks + 4 * i);
+		beltBlockCopy(keys2 + 16 * i + 12, h[i]);
+		// blocks2_{2i} <- X0_i, blocks2_{2i+1} <- X1_i
+		beltBlockCopy(blocks2 + 8 * i, X[i]);
+		beltBlockCopy(blocks2 + 8 * i + 4, X[i] + 4);
+	}
+	// blocks2_j <- beltBlock(blocks2_j, keys2_j)
+	beltBlockEncrNK(blocks2, 2 * n, keys2);
+	// h0_i <- blocks2_{2i} + X0_i, h1_i <- blocks2_{2i+1} + X1_i
+	for (i = 0; i < n; ++i)
+	{
+		beltBlockXor(h[i], blocks2 + 8 * i, X[i]);
+		beltBlockXor(h[i] + 4, blocks2 + 8 * i + 4, X[i] + 4);
+	}
+}
+
+size_t beltCompr2N_deep()
+{
+	return 36 * 4 * BELT_BLOCK_N;
 }
@@ -4,7 +4,7 @@
 \brief STB 34.101.31 (belt): CTR encryption
 \project bee2 [cryptographic library]
 \created 2012.12.18
-\version 2025.10.02
+\version 2026.10.16
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
@@ -34,7 +34,6 @@ static void beltBlockIncU32(u32 block[4])
 	CLEAN(carry);
 }
 
-
 /*
 *******************************************************************************
 Шифрование в режиме CTR
@@ -44,6 +43,15 @@ static void beltBlockIncU32(u32 block[4])
 не используется реверс октетов даже на платформах BIG_ENDIAN.
 Реверс применяется только перед использованием зашифрованного счетчика
 в качестве гаммы.
+
+Начальное значение счетчика (зашифрованная синхропосылка) сохраняется 
+в ctr0. При переходе к блоку с номером pos счетчик устанавливается 
+равным ctr0 + pos: следующий блок гаммы будет выработан по ctr0 + pos + 1, 
+как и при последовательной обработке.
+
+Полные блоки гаммы вырабатываются порциями по BELT_BLOCK_N блоков: 
+очередные значения счетчика собираются в буфере blocks и зашифровываются 
+функцией beltBlockEncrN().
 *******************************************************************************
 */
 
@@ -58,14 +66,37 @@ void beltCTRStart(void* state, const octet key[], size_t len,
 	belt_ctr_st* st = (belt_ctr_st*)state;
 	ASSERT(memIsDisjoint2(iv, 16, state, beltCTR_keep()));
 	beltKeyExpand2(st->key, key, len);
-	u32From(st->ctr, iv, 16);
-	beltBlockEncr2(st->ctr, st->key);
+	u32From(st->ctr0, iv, 16);
+	beltBlockEncr2(st->ctr0, st->key);
+	beltBlockCopy(st->ctr, st->ctr0);
+	st->reserved = 0;
+}
+
+void beltCTRStartK(void* state, const void* ks, const octet iv[16])
+{
+	belt_ctr_st* st = (belt_ctr_st*)state;
+	ASSERT(memIsDisjoint2(iv, 16, state, beltCTR_keep()));
+	ASSERT(memIsValid(ks, beltKey_keep()));
+	memCopy(st->key, ((const belt_key_st*)ks)->key, 32);
+	u32From(st->ctr0, iv, 16);
+	beltBlockEncr2(st->ctr0, st->key);
+	beltBlockCopy(st->ctr, st->ctr0);
+	st->reserved = 0;
+}
+
+void beltCTRSeek(void* state, size_t pos)
+{
+	belt_ctr_st* st = (belt_ctr_st*)state;
+	ASSERT(memIsValid(state, beltCTR_keep()));
+	beltBlockCopy(st->ctr, st->ctr0);
+	beltBlockAddU32(st->ctr, pos);
 	st->reserved = 0;
 }
 
 void beltCTRStepE(void* buf, size_t count, void* state)
 {
 	belt_ctr_st* st = (belt_ctr_st*)state;
+	size_t i;
 	ASSERT(memIsDisjoint2(buf, count, state, beltCTR_keep()));
 	// есть резерв гаммы?
 	if (st->reserved)
@@ -81,6 +112,22 @@ void beltCTRStepE(void* buf, size_t count, void* state)
 		buf = (octet*)buf + st->reserved;
 		st->reserved = 0;
 	}
+	// цикл по порциям блоков
+	while (count >= 16 * BELT_BLOCK_N)
+	{
+		for (i = 0; i < BELT_BLOCK_N; ++i)
+		{
+			beltBlockIncU32(st->ctr);
+			beltBlockCopy(st->blocks + 4 * i, st->ctr);
+		}
+		beltBlockEncrN(st->blocks, BELT_BLOCK_N, st->key);
+#if (OCTET_ORDER == BIG_ENDIAN)
+		u32Rev2(st->blocks, 4 * BELT_BLOCK_N);
+#endif
+		memXor2(buf, st->blocks, 16 * BELT_BLOCK_N);
+		buf = (octet*)buf + 16 * BELT_BLOCK_N;
+		count -= 16 * BELT_BLOCK_N;
+	}
 	// цикл по полным блокам
 	while (count >= 16)
 	{
@@ -133,3 +180,44 @@ err_t beltCTR(void* dest, const void* src, size_t count,
 	blobClose(state);
 	return ERR_OK;
 }
+
+/*
+*******************************************************************************
+Многопоточное шифрование в режиме CTR
+
+Каждый фрагмент шифруется на копии состояния, настроенной на первый блок 
+фрагмента с помощью beltCTRSeek().
+*******************************************************************************
+*/
+
+static void beltCTRStepMT(void* buf, size_t count, size_t pos, void* state)
+{
+	beltCTRSeek(state, pos);
+	beltCTRStepE(buf, count, state);
+}
+
+err_t beltCTRParallel(void* dest, const void* src, size_t count,
+	const octet key[], size_t len, const octet iv[16], size_t nthreads)
+{
+	err_t code;
+	void* state;
+	// проверить входные данные
+	if (len != 16 && len != 24 && len != 32 ||
+		nthreads == 0 ||
+		!memIsValid(src, count) ||
+		!memIsValid(key, len) ||
+		!memIsValid(iv, 16) ||
+		!memIsValid(dest, count))
+		return ERR_BAD_INPUT;
+	// создать состояние
+	state = blobCreate(beltCTR_keep());
+	if (state == 0)
+		return ERR_OUTOFMEMORY;
+	// зашифровать
+	beltCTRStart(state, key, len, iv);
+	code = beltMTStep(dest, src, count, 16, beltCTRStepMT, state, 
+		beltCTR_keep(), nthreads);
+	// завершить
+	blobClose(state);
+	return code;
+}
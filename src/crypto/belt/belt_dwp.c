@@ -4,7 +4,7 @@
 \brief STB 34.101.31 (belt): DWP (datawrap = data encryption + authentication)
 \project bee2 [cryptographic library]
 \created 2012.12.18
-\version 2025.10.01
+\version 2026.10.16
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
@@ -27,41 +27,54 @@
 typedef struct
 {
 	belt_ctr_st ctr[1];		/*< состояние функций CTR */
-	word r[W_OF_B(128)];	/*< переменная r */
+	belt_poly_st poly[1];	/*< умножение на r */
 	word t[W_OF_B(128)];	/*< переменная t */
 	word t1[W_OF_B(128)];	/*< копия t/имитовставка */
 	word len[W_OF_B(128)];	/*< обработано открытых || критических данных */
 	octet block[16];		/*< блок данных */
 	size_t filled;			/*< накоплено октетов в блоке */
-	mem_align_t stack[];	/*< стек умножения */
 } belt_dwp_st;
 
 size_t beltDWP_keep()
 {
-	return sizeof(belt_dwp_st) + beltPolyMul_deep();
+	return sizeof(belt_dwp_st);
 }
 
-void beltDWPStart(void* state, const octet key[], size_t len, 
-	const octet iv[16])
+static void beltDWPStart_internal(void* state)
 {
 	belt_dwp_st* st = (belt_dwp_st*)state;
-	ASSERT(memIsDisjoint2(iv, 16, state, beltDWP_keep()));
-	// настроить CTR
-	beltCTRStart(st->ctr, key, len, iv);
-	// установить r, s
-	beltBlockCopy(st->r, st->ctr->ctr);
-	ASSERT(memIsAligned(st->r, 4));
-	beltBlockEncr2((u32*)st->r, st->ctr->key);
+	// установить r (в t1), подготовить умножение на r
+	beltBlockCopy(st->t1, st->ctr->ctr);
+	ASSERT(memIsAligned(st->t1, 4));
+	beltBlockEncr2((u32*)st->t1, st->ctr->key);
 #if (OCTET_ORDER == BIG_ENDIAN && B_PER_W != 32)
-	beltBlockRevU32(st->r);
-	beltBlockRevW(st->r);
+	beltBlockRevU32(st->t1);
+	beltBlockRevW(st->t1);
 #endif
+	beltPolyStart(st->poly, st->t1);
 	wwFrom(st->t, beltH(), 16);
 	// обнулить счетчики
 	memSetZero(st->len, sizeof(st->len));
 	st->filled = 0;
 }
 
+void beltDWPStart(void* state, const octet key[], size_t len, 
+	const octet iv[16])
+{
+	belt_dwp_st* st = (belt_dwp_st*)state;
+	ASSERT(memIsDisjoint2(iv, 16, state, beltDWP_keep()));
+	beltCTRStart(st->ctr, key, len, iv);
+	beltDWPStart_internal(state);
+}
+
+void beltDWPStartK(void* state, const void* ks, const octet iv[16])
+{
+	belt_dwp_st* st = (belt_dwp_st*)state;
+	ASSERT(memIsDisjoint2(iv, 16, state, beltDWP_keep()));
+	beltCTRStartK(st->ctr, ks, iv);
+	beltDWPStart_internal(state);
+}
+
 void beltDWPStepE(void* buf, size_t count, void* state)
 {
 	beltCTRStepE(buf, count, state);
@@ -91,21 +104,13 @@ void beltDWPStepI(const void* buf, size_t count, void* state)
 		beltBlockRevW(st->block);
 #endif
 		beltBlockXor2(st->t, st->block);
-		beltPolyMul(st->t, st->t, st->r, st->stack);
+		beltPolyMulR(st->t, st->poly);
 		st->filled = 0;
 	}
 	// цикл по полным блокам
-	while (count >= 16)
-	{
-		beltBlockCopy(st->block, buf);
-#if (OCTET_ORDER == BIG_ENDIAN)
-		beltBlockRevW(st->block);
-#endif
-		beltBlockXor2(st->t, st->block);
-		beltPolyMul(st->t, st->t, st->r, st->stack);
-		buf = (const octet*)buf + 16;
-		count -= 16;
-	}
+	beltPolyStepA(st->t, buf, count - count % 16, st->poly);
+	buf = (const octet*)buf + count - count % 16;
+	count %= 16;
 	// неполный блок?
 	if (count)
 		memCopy(st->block, buf, st->filled = count);
@@ -124,7 +129,7 @@ void beltDWPStepA(const void* buf, size_t count, void* state)
 		beltBlockRevW(st->block);
 #endif
 		beltBlockXor2(st->t, st->block);
-		beltPolyMul(st->t, st->t, st->r, st->stack);
+		beltPolyMulR(st->t, st->poly);
 		st->filled = 0;
 	}
 	// обновить длину
@@ -145,21 +150,13 @@ void beltDWPStepA(const void* buf, size_t count, void* state)
 		beltBlockRevW(st->block);
 #endif
 		beltBlockXor2(st->t, st->block);
-		beltPolyMul(st->t, st->t, st->r, st->stack);
+		beltPolyMulR(st->t, st->poly);
 		st->filled = 0;
 	}
 	// цикл по полным блокам
-	while (count >= 16)
-	{
-		beltBlockCopy(st->block, buf);
-#if (OCTET_ORDER == BIG_ENDIAN)
-		beltBlockRevW(st->block);
-#endif
-		beltBlockXor2(st->t, st->block);
-		beltPolyMul(st->t, st->t, st->r, st->stack);
-		buf = (const octet*)buf + 16;
-		count -= 16;
-	}
+	beltPolyStepA(st->t, buf, count - count % 16, st->poly);
+	buf = (const octet*)buf + count - count % 16;
+	count %= 16;
 	// неполный блок?
 	if (count)
 		memCopy(st->block, buf, st->filled = count);
@@ -170,6 +167,32 @@ void beltDWPStepD(void* buf, size_t count, void* state)
 	beltCTRStepD(buf, count, state);
 }
 
+void beltDWPStepEA(void* buf, size_t count, void* state)
+{
+	size_t c;
+	ASSERT(memIsDisjoint2(buf, count, state, beltDWP_keep()));
+	for (; count; count -= c)
+	{
+		c = MIN2(count, BELT_EA_SIZE);
+		beltDWPStepE(buf, c, state);
+		beltDWPStepA(buf, c, state);
+		buf = (octet*)buf + c;
+	}
+}
+
+void beltDWPStepAD(void* buf, size_t count, void* state)
+{
+	size_t c;
+	ASSERT(memIsDisjoint2(buf, count, state, beltDWP_keep()));
+	for (; count; count -= c)
+	{
+		c = MIN2(count, BELT_EA_SIZE);
+		beltDWPStepA(buf, c, state);
+		beltDWPStepD(buf, c, state);
+		buf = (octet*)buf + c;
+	}
+}
+
 static void beltDWPStepG_internal(void* state)
 {
 	belt_dwp_st* st = (belt_dwp_st*)state;
@@ -180,13 +203,13 @@ static void beltDWPStepG_internal(void* state)
 		memSetZero(st->block + st->filled, 16 - st->filled);
 		wwFrom(st->t1, st->block, 16);
 		beltBlockXor2(st->t1, st->t);
-		beltPolyMul(st->t1, st->t1, st->r, st->stack);
+		beltPolyMulR(st->t1, st->poly);
 	}
 	else
 		memCopy(st->t1, st->t, 16);
 	// обработать блок длины
 	beltBlockXor2(st->t1, st->len);
-	beltPolyMul(st->t1, st->t1, st->r, st->stack);
+	beltPolyMulR(st->t1, st->poly);
 #if (OCTET_ORDER == BIG_ENDIAN)
 	beltBlockRevW(st->t1);
 #endif
@@ -231,8 +254,7 @@ err_t beltDWPWrap(void* dest, octet mac[8], const void* src1, size_t count1,
 	beltDWPStart(state, key, len, iv);
 	beltDWPStepI(src2, count2, state);
 	memMove(dest, src1, count1);
-	beltDWPStepE(dest, count1, state);
-	beltDWPStepA(dest, count1, state);
+	beltDWPStepEA(dest, count1, state);
 	beltDWPStepG(mac, state);
 	// завершить
 	blobClose(state);
@@ -260,14 +282,32 @@ err_t beltDWPUnwrap(void* dest, const void* src1, size_t count1,
 	// снять защиту
 	beltDWPStart(state, key, len, iv);
 	beltDWPStepI(src2, count2, state);
-	beltDWPStepA(src1, count1, state);
-	if (!beltDWPStepV(mac, state))
+	// dest не пересекается с входными данными?
+	// совместить проверку имитовставки и расшифрование
+	if (memIsDisjoint2(dest, count1, src1, count1) &&
+		memIsDisjoint2(dest, count1, src2, count2) &&
+		memIsDisjoint2(dest, count1, mac, 8))
+	{
+		memCopy(dest, src1, count1);
+		beltDWPStepAD(dest, count1, state);
+		if (!beltDWPStepV(mac, state))
+		{
+			memSetZero(dest, count1);
+			blobClose(state);
+			return ERR_BAD_MAC;
+		}
+	}
+	else
 	{
-		blobClose(state);
-		return ERR_BAD_MAC;
+		beltDWPStepA(src1, count1, state);
+		if (!beltDWPStepV(mac, state))
+		{
+			blobClose(state);
+			return ERR_BAD_MAC;
+		}
+		memMove(dest, src1, count1);
+		beltDWPStepD(dest, count1, state);
 	}
-	memMove(dest, src1, count1);
-	beltDWPStepD(dest, count1, state);
 	// завершить
 	blobClose(state);
 	return ERR_OK;
@@ -4,7 +4,7 @@
 \brief STB 34.101.31 (belt): ECB encryption
 \project bee2 [cryptographic library]
 \created 2012.12.18
-\version 2025.10.02
+\version 2026.10.16
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
@@ -13,6 +13,7 @@
 #include "bee2/core/blob.h"
 #include "bee2/core/err.h"
 #include "bee2/core/mem.h"
+#include "bee2/core/u32.h"
 #include "bee2/core/util.h"
 #include "bee2/crypto/belt.h"
 #include "belt_lcl.h"
@@ -45,6 +46,7 @@ typedef struct
 {
 	u32 key[8];			/*< форматированный ключ */
 	octet block[16];	/*< вспомогательный блок */
+	u32 blocks[4 * BELT_BLOCK_N];	/*< порция блоков */
 } belt_ecb_st;
 
 size_t beltECB_keep()
@@ -59,11 +61,28 @@ void beltECBStart(void* state, const octet key[], size_t len)
 	beltKeyExpand2(st->key, key, len);
 }
 
+void beltECBStartK(void* state, const void* ks)
+{
+	belt_ecb_st* st = (belt_ecb_st*)state;
+	ASSERT(memIsValid(state, beltECB_keep()));
+	ASSERT(memIsValid(ks, beltKey_keep()));
+	memCopy(st->key, ((const belt_key_st*)ks)->key, 32);
+}
+
 void beltECBStepE(void* buf, size_t count, void* state)
 {
 	belt_ecb_st* st = (belt_ecb_st*)state;
 	ASSERT(count >= 16);
 	ASSERT(memIsDisjoint2(buf, count, state, beltECB_keep()));
+	// цикл по порциям блоков
+	while(count >= 16 * BELT_BLOCK_N)
+	{
+		u32From(st->blocks, buf, 16 * BELT_BLOCK_N);
+		beltBlockEncrN(st->blocks, BELT_BLOCK_N, st->key);
+		u32To(buf, 16 * BELT_BLOCK_N, st->blocks);
+		buf = (octet*)buf + 16 * BELT_BLOCK_N;
+		count -= 16 * BELT_BLOCK_N;
+	}
 	// цикл по полным блокам
 	while(count >= 16)
 	{
@@ -89,6 +108,15 @@ void beltECBStepD(void* buf, size_t count, void* state)
 	belt_ecb_st* st = (belt_ecb_st*)state;
 	ASSERT(count >= 16);
 	ASSERT(memIsDisjoint2(buf, count, state, beltECB_keep()));
+	// цикл по порциям блоков
+	while(count >= 16 * BELT_BLOCK_N)
+	{
+		u32From(st->blocks, buf, 16 * BELT_BLOCK_N);
+		beltBlockDecrN(st->blocks, BELT_BLOCK_N, st->key);
+		u32To(buf, 16 * BELT_BLOCK_N, st->blocks);
+		buf = (octet*)buf + 16 * BELT_BLOCK_N;
+		count -= 16 * BELT_BLOCK_N;
+	}
 	// цикл по полным блокам
 	while(count >= 16)
 	{
@@ -157,3 +185,74 @@ err_t beltECBDecr(void* dest, const void* src, size_t count,
 	return ERR_OK;
 }
 
+/*
+*******************************************************************************
+Многопоточное шифрование в режиме ECB
+
+Фрагменты содержат не менее BELT_MT_MIN >= 32 октетов, поэтому кража 
+блока возможна только в последнем фрагменте и выполняется так же, как 
+при однопоточной обработке.
+*******************************************************************************
+*/
+
+static void beltECBStepEMT(void* buf, size_t count, size_t pos, void* state)
+{
+	beltECBStepE(buf, count, state);
+}
+
+static void beltECBStepDMT(void* buf, size_t count, size_t pos, void* state)
+{
+	beltECBStepD(buf, count, state);
+}
+
+err_t beltECBEncrParallel(void* dest, const void* src, size_t count,
+	const octet key[], size_t len, size_t nthreads)
+{
+	err_t code;
+	void* state;
+	// проверить входные данные
+	if (count < 16 ||
+		len != 16 && len != 24 && len != 32 ||
+		nthreads == 0 ||
+		!memIsValid(src, count) ||
+		!memIsValid(key, len) ||
+		!memIsValid(dest, count))
+		return ERR_BAD_INPUT;
+	// создать состояние
+	state = blobCreate(beltECB_keep());
+	if (state == 0)
+		return ERR_OUTOFMEMORY;
+	// зашифровать
+	beltECBStart(state, key, len);
+	code = beltMTStep(dest, src, count, 16, beltECBStepEMT, state, 
+		beltECB_keep(), nthreads);
+	// завершить
+	blobClose(state);
+	return code;
+}
+
+err_t beltECBDecrParallel(void* dest, const void* src, size_t count,
+	const octet key[], size_t len, size_t nthreads)
+{
+	err_t code;
+	void* state;
+	// проверить входные данные
+	if (count < 16 ||
+		len != 16 && len != 24 && len != 32 ||
+		nthreads == 0 ||
+		!memIsValid(src, count) ||
+		!memIsValid(key, len) ||
+		!memIsValid(dest, count))
+		return ERR_BAD_INPUT;
+	// создать состояние
+	state = blobCreate(beltECB_keep());
+	if (state == 0)
+		return ERR_OUTOFMEMORY;
+	// расшифровать
+	beltECBStart(state, key, len);
+	code = beltMTStep(dest, src, count, 16, beltECBStepDMT, state, 
+		beltECB_keep(), nthreads);
+	// завершить
+	blobClose(state);
+	return code;
+}
@@ -4,7 +4,7 @@
 \brief STB 34.101.31 (belt): FMT (format preserving encryption)
 \project bee2 [cryptographic library]
 \created 2017.09.28
-\version 2025.10.02
+\version 2026.10.16
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
@@ -474,3 +474,191 @@ err_t beltFMTDecr(u16 dest[], u32 mod, const u16 src[], size_t count,
 	blobClose(state);
 	return ERR_OK;
 }
+
+/*
+*******************************************************************************
+Пакетное шифрование с сохранением формата
+
+Пакет состоит из n строк одинаковой длины count. Все строки 
+зашифровываются (расшифровываются) на одном состоянии FMT: ключ 
+расширяется, а число блоков b1, b2 определяется один раз. Строка 
+с номером pos (от начала пакета) обрабатывается на синхропосылке 
+iv + 16 * pos (или на нулевой синхропосылке, если iv == 0).
+
+Если b1 == b2 == 1 (например, mod == 10 и count <= 38), то на каждом 
+такте каждая половинка строки вместе с 4 октетами beltH() и 4 октетами 
+синхропосылки укладывается в один блок belt. Тогда строки обрабатываются 
+группами из BELT_BLOCK_N строк: соответствующие половинки всех строк 
+группы зашифровываются одним обращением к beltBlockEncrN(). Иначе строки 
+обрабатываются по одной функциями beltFMTStepE() / beltFMTStepD().
+
+Фрагменты пакета (целые числа строк, не менее BELT_FMT_MT_MIN строк во 
+фрагменте) обрабатываются в нескольких потоках (см. beltMTStep2()).
+*******************************************************************************
+*/
+
+#define BELT_FMT_MT_MIN 64
+
+typedef struct
+{
+	const octet* iv;		/*< синхропосылки (или 0) */
+	size_t count;			/*< длина строк */
+	word bins[W_OF_O(16 * BELT_BLOCK_N)];	/*< порция блоков */
+	octet ivs[24 * BELT_BLOCK_N];	/*< формат || синхропосылка || формат */
+	mem_align_t fmt[];		/*< состояние FMT */
+} belt_fmt_batch_st;
+
+static size_t beltFMTBatch_keep(u32 mod, size_t count)
+{
+	return sizeof(belt_fmt_batch_st) + beltFMT_keep(mod, count);
+}
+
+static void beltFMTHalfN(u16 buf[], size_t n, size_t i, bool_t right, 
+	bool_t add, belt_fmt_batch_st* bt)
+{
+	belt_fmt_st* st = (belt_fmt_st*)bt->fmt;
+	size_t src_pos, src_len, dest_pos, dest_len, j;
+	octet* bin;
+	ASSERT(st->b1 == 1 && st->b2 == 1);
+	ASSERT(n <= BELT_BLOCK_N);
+	// правая половинка зашифровывается и добавляется к левой?
+	if (right)
+		src_pos = st->n1, src_len = st->n2, dest_pos = 0, dest_len = st->n1;
+	else
+		src_pos = 0, src_len = st->n1, dest_pos = st->n1, dest_len = st->n2;
+	// bin_j <- str2bin(src_j) || beltH() || iv_j
+	for (j = 0; j < n; ++j)
+	{
+		bin = (octet*)bt->bins + 16 * j;
+		beltStr2Bin(bin, 1, st->mod, buf + bt->count * j + src_pos, src_len);
+		memCopy(bin + 8, beltH() + 8 * i + (right ? 0 : 4), 4);
+		memCopy(bin + 12, bt->ivs + 24 * j + 8 * i + (right ? 0 : 4), 4);
+		u32From((u32*)bin, bin, 16);
+	}
+	// зашифровать
+	beltBlockEncrN((u32*)bt->bins, n, st->wbl->key);
+	// dest_j <- dest_j +- bin2str(bin_j)
+	for (j = 0; j < n; ++j)
+	{
+		bin = (octet*)bt->bins + 16 * j;
+		u32To(bin, 16, (u32*)bin);
+		if (add)
+			beltBin2StrAdd(st->mod, buf + bt->count * j + dest_pos, 
+				dest_len, bin, 2);
+		else
+			beltBin2StrSub(st->mod, buf + bt->count * j + dest_pos, 
+				dest_len, bin, 2);
+	}
+}
+
+static void beltFMTBatchStep(void* buf, size_t count, size_t pos, 
+	void* state, bool_t decr)
+{
+	belt_fmt_batch_st* bt = (belt_fmt_batch_st*)state;
+	belt_fmt_st* st = (belt_fmt_st*)bt->fmt;
+	u16* str = (u16*)buf;
+	size_t n, i, j;
+	ASSERT(count % (2 * bt->count) == 0);
+	n = count / (2 * bt->count);
+	// обработать строки по одной
+	if (st->b1 != 1 || st->b2 != 1)
+	{
+		for (; n--; ++pos, str += bt->count)
+			if (decr)
+				beltFMTStepD(str, bt->iv ? bt->iv + 16 * pos : 0, st);
+			else
+				beltFMTStepE(str, bt->iv ? bt->iv + 16 * pos : 0, st);
+		return;
+	}
+	// обработать группы строк
+	for (; n; n -= j, pos += j, str += bt->count * j)
+	{
+		j = MIN2(n, BELT_BLOCK_N);
+		// подготовить синхропосылки
+		for (i = 0; i < j; ++i)
+		{
+			memCopy(bt->ivs + 24 * i, st->iv, 4);
+			if (bt->iv)
+				memCopy(bt->ivs + 24 * i + 4, bt->iv + 16 * (pos + i), 16);
+			else
+				memSetZero(bt->ivs + 24 * i + 4, 16);
+			memCopy(bt->ivs + 24 * i + 20, st->iv, 4);
+		}
+		// такты
+		if (decr)
+			for (i = 3; i--;)
+			{
+				beltFMTHalfN(str, j, i, FALSE, FALSE, bt);
+				beltFMTHalfN(str, j, i, TRUE, FALSE, bt);
+			}
+		else
+			for (i = 0; i < 3; ++i)
+			{
+				beltFMTHalfN(str, j, i, TRUE, TRUE, bt);
+				beltFMTHalfN(str, j, i, FALSE, TRUE, bt);
+			}
+	}
+}
+
+static void beltFMTBatchStepE(void* buf, size_t count, size_t pos, 
+	void* state)
+{
+	beltFMTBatchStep(buf, count, pos, state, FALSE);
+}
+
+static void beltFMTBatchStepD(void* buf, size_t count, size_t pos, 
+	void* state)
+{
+	beltFMTBatchStep(buf, count, pos, state, TRUE);
+}
+
+static err_t beltFMTBatch(u16 dest[], u32 mod, const u16 src[], 
+	size_t count, size_t n, const octet key[], size_t len, 
+	const octet iv[], size_t nthreads, belt_mt_step_i step)
+{
+	belt_fmt_batch_st* bt;
+	err_t code;
+	// проверить входные данные
+	if (mod < 2 || mod > 65536 || count < 2 ||
+		n == 0 || n > SIZE_MAX / 2 / count || n > SIZE_MAX / 16 ||
+		len != 16 && len != 24 && len != 32 ||
+		nthreads == 0 ||
+		!memIsValid(src, 2 * count * n) ||
+		!memIsNullOrValid(iv, 16 * n) ||
+		!memIsValid(key, len) ||
+		!memIsValid(dest, 2 * count * n) ||
+		iv && !memIsDisjoint2(dest, 2 * count * n, iv, 16 * n))
+		return ERR_BAD_INPUT;
+	if (count > 600)
+		return ERR_NOT_IMPLEMENTED;
+	// создать состояние
+	bt = (belt_fmt_batch_st*)blobCreate(beltFMTBatch_keep(mod, count));
+	if (bt == 0)
+		return ERR_OUTOFMEMORY;
+	// обработать строки
+	beltFMTStart(bt->fmt, mod, count, key, len);
+	bt->iv = iv;
+	bt->count = count;
+	code = beltMTStep2(dest, src, 2 * count * n, 2 * count, 
+		2 * count * BELT_FMT_MT_MIN, step, bt, 
+		beltFMTBatch_keep(mod, count), nthreads);
+	// завершить
+	blobClose(bt);
+	return code;
+}
+
+err_t beltFMTEncrBatch(u16 dest[], u32 mod, const u16 src[], size_t count,
+	size_t n, const octet key[], size_t len, const octet iv[], 
+	size_t nthreads)
+{
+	return beltFMTBatch(dest, mod, src, count, n, key, len, iv, nthreads, 
+		beltFMTBatchStepE);
+}
+
+err_t beltFMTDecrBatch(u16 dest[], u32 mod, const u16 src[], size_t count,
+	size_t n, const octet key[], size_t len, const octet iv[], 
+	size_t nthreads)
+{
+	return beltFMTBatch(dest, mod, src, count, n, key, len, iv, nthreads, 
+		beltFMTBatchStepD);
+}
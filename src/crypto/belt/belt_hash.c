@@ -4,7 +4,7 @@
 \brief STB 34.101.31 (belt): hashing
 \project bee2 [cryptographic library]
 \created 2012.12.18
-\version 2025.10.01
+\version 2026.10.16
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
@@ -188,3 +188,208 @@ err_t beltHash(octet hash[32], const void* src, size_t count)
 	blobClose(state);
 	return ERR_OK;
 }
+
+/*
+*******************************************************************************
+Хэширование нескольких сообщений
+
+Состояние каждого сообщения (belt_hash_lane) повторяет belt_hash_st, 
+но не содержит стека. Поля buf и count используются только внутри 
+beltHashMultiStepH(): в них хранится необработанная часть фрагмента.
+
+Сжатия выполняются порциями до BELT_BLOCK_N сообщений функцией 
+beltCompr2N(). В порцию включаются сообщения, для которых накоплен полный 
+блок. Сообщения просматриваются по кругу, начиная с позиции, на которой 
+остановился предыдущий просмотр. Поэтому порции остаются полными, пока 
+полные блоки есть хотя бы у BELT_BLOCK_N сообщений.
+
+Стек beltCompr2N() размещается в состоянии после состояний сообщений.
+*******************************************************************************
+*/
+
+typedef struct {
+	u32 ls[8];				/*< блок [4]len || [4]s */
+	u32 s1[4];				/*< копия переменной s */
+	u32 h[8];				/*< переменная h */
+	u32 h1[8];				/*< копия переменной h */
+	octet block[32];		/*< блок данных */
+	size_t filled;			/*< накоплено октетов в блоке */
+	const octet* buf;		/*< необработанные данные */
+	size_t count;			/*< число октетов необработанных данных */
+} belt_hash_lane;
+
+typedef struct {
+	size_t n;				/*< число сообщений */
+	mem_align_t data[];		/*< [n]belt_hash_lane || стек beltCompr2N */
+} belt_hash_multi_st;
+
+size_t beltHashMulti_keep(size_t n)
+{
+	return sizeof(belt_hash_multi_st) + n * sizeof(belt_hash_lane) + 
+		beltCompr2N_deep();
+}
+
+void beltHashMultiStart(void* state, size_t n)
+{
+	belt_hash_multi_st* st = (belt_hash_multi_st*)state;
+	belt_hash_lane* lanes = (belt_hash_lane*)st->data;
+	size_t i;
+	ASSERT(memIsValid(state, beltHashMulti_keep(n)));
+	st->n = n;
+	for (i = 0; i < n; ++i)
+	{
+		// len || s <- 0
+		beltBlockSetZero(lanes[i].ls);
+		beltBlockSetZero(lanes[i].ls + 4);
+		// h <- B194...0D
+		u32From(lanes[i].h, beltH(), 32);
+		// нет накопленнных данных
+		lanes[i].filled = 0;
+	}
+}
+
+void beltHashMultiStepH(const void* buf[], const size_t count[], void* state)
+{
+	belt_hash_multi_st* st = (belt_hash_multi_st*)state;
+	belt_hash_lane* lanes = (belt_hash_lane*)st->data;
+	u32* s[BELT_BLOCK_N];
+	u32* h[BELT_BLOCK_N];
+	const u32* X[BELT_BLOCK_N];
+	size_t pos, i, m;
+	ASSERT(memIsValid(state, sizeof(belt_hash_multi_st)));
+	ASSERT(memIsValid(state, beltHashMulti_keep(st->n)));
+	ASSERT(memIsValid(buf, st->n * sizeof(const void*)));
+	ASSERT(memIsValid(count, st->n * sizeof(size_t)));
+	// обновить длины и запомнить фрагменты
+	for (i = 0; i < st->n; ++i)
+	{
+		ASSERT(memIsDisjoint2(buf[i], count[i], 
+			state, beltHashMulti_keep(st->n)));
+		beltBlockAddBitSizeU32(lanes[i].ls, count[i]);
+		lanes[i].buf = (const octet*)buf[i];
+		lanes[i].count = count[i];
+	}
+	// цикл по порциям полных блоков
+	for (pos = 0;;)
+	{
+		// собрать порцию
+		for (i = m = 0; i < st->n && m < BELT_BLOCK_N; 
+			++i, pos = (pos + 1) % st->n)
+		{
+			belt_hash_lane* lane = lanes + pos;
+			size_t t = 32 - lane->filled;
+			if (lane->count < t)
+				continue;
+			memCopy(lane->block + lane->filled, lane->buf, t);
+			lane->buf += t, lane->count -= t, lane->filled = 0;
+#if (OCTET_ORDER == BIG_ENDIAN)
+			beltBlockRevU32(lane->block);
+			beltBlockRevU32(lane->block + 16);
+#endif
+			ASSERT(memIsAligned(lane->block, 4));
+			s[m] = lane->ls + 4, h[m] = lane->h;
+			X[m++] = (const u32*)lane->block;
+		}
+		// нет полных блоков?
+		if (m == 0)
+			break;
+		// сжать
+		beltCompr2N(s, h, X, m, lanes + st->n);
+	}
+	// сохранить неполные блоки
+	for (i = 0; i < st->n; ++i)
+	{
+		belt_hash_lane* lane = lanes + i;
+		ASSERT(lane->filled + lane->count < 32);
+		memCopy(lane->block + lane->filled, lane->buf, lane->count);
+		lane->filled += lane->count;
+		lane->buf = 0, lane->count = 0;
+	}
+}
+
+void beltHashMultiStepG(octet hash[], void* state)
+{
+	belt_hash_multi_st* st = (belt_hash_multi_st*)state;
+	belt_hash_lane* lanes = (belt_hash_lane*)st->data;
+	u32* s[BELT_BLOCK_N];
+	u32* h[BELT_BLOCK_N];
+	const u32* X[BELT_BLOCK_N];
+	size_t i, m;
+	ASSERT(memIsValid(state, sizeof(belt_hash_multi_st)));
+	ASSERT(memIsValid(state, beltHashMulti_keep(st->n)));
+	ASSERT(memIsValid(hash, 32 * st->n));
+	// создать копии вторых частей ls и h
+	for (i = 0; i < st->n; ++i)
+	{
+		beltBlockCopy(lanes[i].s1, lanes[i].ls + 4);
+		beltBlockCopy(lanes[i].h1, lanes[i].h);
+		beltBlockCopy(lanes[i].h1 + 4, lanes[i].h + 4);
+	}
+	// обработать неполные блоки
+	for (i = m = 0; i < st->n; ++i)
+	{
+		belt_hash_lane* lane = lanes + i;
+		if (!lane->filled)
+			continue;
+		memSetZero(lane->block + lane->filled, 32 - lane->filled);
+#if (OCTET_ORDER == BIG_ENDIAN)
+		beltBlockRevU32(lane->block);
+		beltBlockRevU32(lane->block + 16);
+#endif
+		ASSERT(memIsAligned(lane->block, 4));
+		s[m] = lane->ls + 4, h[m] = lane->h1;
+		X[m++] = (const u32*)lane->block;
+		if (m == BELT_BLOCK_N)
+			beltCompr2N(s, h, X, m, lanes + st->n), m = 0;
+	}
+	if (m)
+		beltCompr2N(s, h, X, m, lanes + st->n);
+	// обработать последние блоки
+	for (i = m = 0; i < st->n; ++i)
+	{
+		h[m] = lanes[i].h1, X[m++] = lanes[i].ls;
+		if (m == BELT_BLOCK_N)
+			beltCompr2N(0, h, X, m, lanes + st->n), m = 0;
+	}
+	if (m)
+		beltCompr2N(0, h, X, m, lanes + st->n);
+	// выгрузить хэш-значения и восстановить состояния
+	for (i = 0; i < st->n; ++i)
+	{
+		u32To(hash + 32 * i, 32, lanes[i].h1);
+		beltBlockCopy(lanes[i].ls + 4, lanes[i].s1);
+#if (OCTET_ORDER == BIG_ENDIAN)
+		if (lanes[i].filled)
+		{
+			beltBlockRevU32(lanes[i].block + 16);
+			beltBlockRevU32(lanes[i].block);
+		}
+#endif
+	}
+}
+
+err_t beltHashMulti(octet hash[], const void* src[], const size_t count[], 
+	size_t n)
+{
+	void* state;
+	size_t i;
+	// проверить входные данные
+	if (!memIsValid(src, n * sizeof(const void*)) ||
+		!memIsValid(count, n * sizeof(size_t)) ||
+		!memIsValid(hash, 32 * n))
+		return ERR_BAD_INPUT;
+	for (i = 0; i < n; ++i)
+		if (!memIsValid(src[i], count[i]))
+			return ERR_BAD_INPUT;
+	// создать состояние
+	state = blobCreate(beltHashMulti_keep(n));
+	if (state == 0)
+		return ERR_OUTOFMEMORY;
+	// вычислить хэш-значения
+	beltHashMultiStart(state, n);
+	beltHashMultiStepH(src, count, state);
+	beltHashMultiStepG(hash, state);
+	// завершить
+	blobClose(state);
+	return ERR_OK;
+}
@@ -4,7 +4,7 @@
 \brief STB 34.101.31 (belt): HMAC message authentication
 \project bee2 [cryptographic library]
 \created 2012.12.18
-\version 2025.10.01
+\version 2026.10.16
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
@@ -21,6 +21,13 @@
 /*
 *******************************************************************************
 Ключезависимое хэширование (HMAC)
+
+После обработки блоков key ^ ipad и key ^ opad в beltHMACStart() 
+переменные внутреннего хэширования сохраняются в полях ls_in0, h_in0. 
+Функция beltHMACRestart() восстанавливает эти переменные и тем самым 
+начинает вычисление новой имитовставки без повторной обработки ключа. 
+Переменные внешнего хэширования в beltHMACStepG() не изменяются 
+и поэтому не сохраняются.
 *******************************************************************************
 */
 typedef struct
@@ -28,6 +35,8 @@ typedef struct
 	u32 ls_in[8];			/*< блок [4]len || [4]s внутреннего хэширования */
 	u32 h_in[8];			/*< переменная h внутреннего хэширования */
 	u32 h1_in[8];			/*< копия переменной h внутреннего хэширования */
+	u32 ls_in0[8];			/*< ls_in после обработки key ^ ipad */
+	u32 h_in0[8];			/*< h_in после обработки key ^ ipad */
 	u32 ls_out[8];			/*< блок [4]len || [4]s внешнего хэширования */
 	u32 h_out[8];			/*< переменная h внешнего хэширования */
 	u32 h1_out[8];			/*< копия переменной h внешнего хэширования */
@@ -102,6 +111,9 @@ void beltHMACStart(void* state, const octet key[], size_t len)
 	ASSERT(memIsAligned(st->block, 4));
 	beltCompr2(st->ls_in + 4, st->h_in, (u32*)st->block, st->stack);
 	st->filled = 0;
+	// сохранить состояние внутреннего хэширования
+	memCopy(st->ls_in0, st->ls_in, sizeof(st->ls_in));
+	memCopy(st->h_in0, st->h_in, sizeof(st->h_in));
 	// сформировать key ^ opad [0x36 ^ 0x5C == 0x6A]
 	for (; len--; )
 		st->block[len] ^= 0x6A;
@@ -114,6 +126,28 @@ void beltHMACStart(void* state, const octet key[], size_t len)
 	beltCompr2(st->ls_out + 4, st->h_out, (u32*)st->block, st->stack);
 }
 
+void beltHMACRestart(void* state)
+{
+	belt_hmac_st* st = (belt_hmac_st*)state;
+	ASSERT(memIsValid(state, beltHMAC_keep()));
+	memCopy(st->ls_in, st->ls_in0, sizeof(st->ls_in));
+	memCopy(st->h_in, st->h_in0, sizeof(st->h_in));
+	st->filled = 0;
+}
+
+void beltHMACPads(u32 s_in[4], u32 h_in[8], u32 s_out[4], u32 h_out[8],
+	const void* state)
+{
+	const belt_hmac_st* st = (const belt_hmac_st*)state;
+	ASSERT(memIsValid(state, beltHMAC_keep()));
+	beltBlockCopy(s_in, st->ls_in0 + 4);
+	beltBlockCopy(h_in, st->h_in0);
+	beltBlockCopy(h_in + 4, st->h_in0 + 4);
+	beltBlockCopy(s_out, st->ls_out + 4);
+	beltBlockCopy(h_out, st->h_out);
+	beltBlockCopy(h_out + 4, st->h_out + 4);
+}
+
 void beltHMACStepA(const void* buf, size_t count, void* state)
 {
 	belt_hmac_st* st = (belt_hmac_st*)state;
@@ -4,7 +4,7 @@
 \brief STB 34.101.31 (belt): KWP (keywrap = key encryption + authentication)
 \project bee2 [cryptographic library]
 \created 2012.12.18
-\version 2025.09.15
+\version 2026.10.16
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
@@ -13,7 +13,9 @@
 #include "bee2/core/blob.h"
 #include "bee2/core/err.h"
 #include "bee2/core/mem.h"
+#include "bee2/core/util.h"
 #include "bee2/crypto/belt.h"
+#include "belt_lcl.h"
 
 /*
 *******************************************************************************
@@ -89,3 +91,188 @@ err_t beltKWPUnwrap(octet dest[], const octet src[], size_t count,
 	blobClose(state);
 	return ERR_OK;
 }
+
+/*
+*******************************************************************************
+Пакетная обработка ключей
+
+Все ключи пакета обрабатываются на одном состоянии KWP: ключ защиты 
+расширяется один раз. Ключ с номером pos (от начала пакета) 
+обрабатывается с заголовком header + 16 * pos (или с нулевым заголовком, 
+если header == 0). Ключи обрабатываются группами из BELT_BLOCK_N ключей 
+функциями beltWBLStepEN() и beltWBLStepD2N(): зашифрования belt-block 
+разных ключей выполняются совместно.
+
+Фрагменты пакета (не менее BELT_KWP_MT_MIN ключей) обрабатываются в 
+нескольких потоках (см. beltMTStep2()). Поскольку длины защищаемых и 
+защищенных ключей различаются, функции beltMTStep2() передается только 
+выходной буфер dest, а входные ключи считываются из буфера src 
+непосредственно в потоках. Поэтому буферы src и dest не должны 
+пересекаться.
+
+При снятии защиты результат проверки каждого ключа записывается 
+в массив rets. Ошибка в одном ключе не прерывает обработку пакета: 
+соответствующий фрагмент dest обнуляется, а обработка продолжается.
+*******************************************************************************
+*/
+
+#define BELT_KWP_MT_MIN 64
+
+typedef struct
+{
+	const octet* src;		/*< входные ключи */
+	size_t count;			/*< длина входных ключей */
+	const octet* header;	/*< заголовки (или 0) */
+	err_t* rets;			/*< коды ошибок */
+	octet headers2[16 * BELT_BLOCK_N];	/*< снятые заголовки */
+	mem_align_t kwp[];		/*< состояние KWP */
+} belt_kwp_batch_st;
+
+static size_t beltKWPBatch_keep()
+{
+	return sizeof(belt_kwp_batch_st) + beltKWP_keep();
+}
+
+static void beltKWPWrapBatchStep(void* buf, size_t count, size_t pos, 
+	void* state)
+{
+	belt_kwp_batch_st* st = (belt_kwp_batch_st*)state;
+	const size_t size = st->count + 16;
+	void* bufs[BELT_BLOCK_N];
+	size_t n, m, j;
+	ASSERT(count % size == 0);
+	for (n = count / size; n; n -= m, pos += m)
+	{
+		m = MIN2(n, BELT_BLOCK_N);
+		// [count]src || header
+		for (j = 0; j < m; ++j)
+		{
+			bufs[j] = buf, buf = (octet*)buf + size;
+			memCopy(bufs[j], st->src + st->count * (pos + j), st->count);
+			if (st->header)
+				memCopy((octet*)bufs[j] + st->count, 
+					st->header + 16 * (pos + j), 16);
+			else
+				memSetZero((octet*)bufs[j] + st->count, 16);
+		}
+		// зашифровать
+		beltWBLStepEN(bufs, m, size, ((belt_wbl_st*)st->kwp)->key);
+	}
+}
+
+static void beltKWPUnwrapBatchStep(void* buf, size_t count, size_t pos, 
+	void* state)
+{
+	belt_kwp_batch_st* st = (belt_kwp_batch_st*)state;
+	const size_t size = st->count - 16;
+	void* bufs[BELT_BLOCK_N];
+	void* headers[BELT_BLOCK_N];
+	size_t n, m, j;
+	ASSERT(count % size == 0);
+	for (n = count / size; n; n -= m, pos += m)
+	{
+		m = MIN2(n, BELT_BLOCK_N);
+		// [count - 16]src, [16]header2
+		for (j = 0; j < m; ++j)
+		{
+			const octet* src = st->src + st->count * (pos + j);
+			bufs[j] = buf, buf = (octet*)buf + size;
+			headers[j] = st->headers2 + 16 * j;
+			memCopy(bufs[j], src, size);
+			memCopy(headers[j], src + size, 16);
+		}
+		// расшифровать
+		beltWBLStepD2N(bufs, headers, m, st->count, 
+			((belt_wbl_st*)st->kwp)->key);
+		// проверить заголовки
+		for (j = 0; j < m; ++j)
+			if (st->header && 
+					!memEq(st->header + 16 * (pos + j), headers[j], 16) ||
+				st->header == 0 && !memIsZero(headers[j], 16))
+			{
+				memSetZero(bufs[j], size);
+				st->rets[pos + j] = ERR_BAD_KEYTOKEN;
+			}
+			else
+				st->rets[pos + j] = ERR_OK;
+	}
+}
+
+err_t beltKWPWrapBatch(octet dest[], const octet src[], size_t count,
+	size_t n, const octet header[], const octet key[], size_t len, 
+	size_t nthreads)
+{
+	belt_kwp_batch_st* st;
+	err_t code;
+	// проверить входные данные
+	if (count < 16 || n == 0 || 
+		count > SIZE_MAX - 16 || n > SIZE_MAX / (count + 16) ||
+		len != 16 && len != 24 && len != 32 ||
+		nthreads == 0 ||
+		!memIsValid(src, count * n) ||
+		!memIsNullOrValid(header, 16 * n) ||
+		!memIsValid(key, len) ||
+		!memIsValid(dest, (count + 16) * n) ||
+		!memIsDisjoint2(src, count * n, dest, (count + 16) * n) ||
+		header && !memIsDisjoint2(header, 16 * n, dest, (count + 16) * n))
+		return ERR_BAD_INPUT;
+	// создать состояние
+	st = (belt_kwp_batch_st*)blobCreate(beltKWPBatch_keep());
+	if (st == 0)
+		return ERR_OUTOFMEMORY;
+	// установить защиту
+	beltKWPStart(st->kwp, key, len);
+	st->src = src, st->count = count, st->header = header;
+	code = beltMTStep2(dest, dest, (count + 16) * n, count + 16, 
+		(count + 16) * BELT_KWP_MT_MIN, beltKWPWrapBatchStep, st, 
+		beltKWPBatch_keep(), nthreads);
+	// завершить
+	blobClose(st);
+	return code;
+}
+
+err_t beltKWPUnwrapBatch(octet dest[], err_t rets[], const octet src[], 
+	size_t count, size_t n, const octet header[], const octet key[], 
+	size_t len, size_t nthreads)
+{
+	belt_kwp_batch_st* st;
+	err_t code;
+	size_t i;
+	// проверить входные данные
+	if (count < 32 || n == 0 || n > SIZE_MAX / count ||
+		n > SIZE_MAX / sizeof(err_t) ||
+		len != 16 && len != 24 && len != 32 ||
+		nthreads == 0 ||
+		!memIsValid(src, count * n) ||
+		!memIsNullOrValid(header, 16 * n) ||
+		!memIsValid(key, len) ||
+		!memIsValid(dest, (count - 16) * n) ||
+		!memIsValid(rets, sizeof(err_t) * n) ||
+		!memIsDisjoint2(src, count * n, dest, (count - 16) * n) ||
+		!memIsDisjoint2(rets, sizeof(err_t) * n, dest, (count - 16) * n) ||
+		!memIsDisjoint2(rets, sizeof(err_t) * n, src, count * n) ||
+		header && !memIsDisjoint2(header, 16 * n, dest, (count - 16) * n) ||
+		header && !memIsDisjoint2(header, 16 * n, rets, sizeof(err_t) * n))
+		return ERR_BAD_INPUT;
+	// создать состояние
+	st = (belt_kwp_batch_st*)blobCreate(beltKWPBatch_keep());
+	if (st == 0)
+		return ERR_OUTOFMEMORY;
+	// снять защиту
+	beltKWPStart(st->kwp, key, len);
+	st->src = src, st->count = count, st->header = header, st->rets = rets;
+	code = beltMTStep2(dest, dest, (count - 16) * n, count - 16, 
+		(count - 16) * BELT_KWP_MT_MIN, beltKWPUnwrapBatchStep, st, 
+		beltKWPBatch_keep(), nthreads);
+	// завершить
+	blobClose(st);
+	// проверить результаты
+	if (code != ERR_OK)
+		for (i = 0; i < n; ++i)
+			rets[i] = code;
+	else
+		for (i = 0; code == ERR_OK && i < n; ++i)
+			if (rets[i] != ERR_OK)
+				code = ERR_BAD_KEYTOKEN;
+	return code;
+}
@@ -4,12 +4,16 @@
 \brief STB 34.101.31 (belt): local functions
 \project bee2 [cryptographic library]
 \created 2012.12.18
-\version 2025.10.02
+\version 2026.10.16
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
 */
 
+#include "bee2/core/blob.h"
+#include "bee2/core/err.h"
+#include "bee2/core/mem.h"
+#include "bee2/core/mt.h"
 #include "bee2/core/util.h"
 #include "bee2/math/pp.h"
 #include "bee2/math/ww.h"
@@ -88,6 +92,29 @@ void beltHalfBlockAddBitSizeW(word block[W_OF_B(64)], size_t count)
 	CLEAN(carry);
 }
 
+/*
+*******************************************************************************
+Сложение с числом блоков
+
+\remark Сдвиг pos >>= 16, pos >>= 16 корректен при любой разрядности size_t.
+*******************************************************************************
+*/
+
+void beltBlockAddU32(u32 block[4], size_t pos)
+{
+	register u32 carry = 0;
+	register u32 t;
+	size_t i;
+	for (i = 0; i < 4; ++i)
+	{
+		t = (u32)pos;
+		block[i] += carry, carry = wordLess(block[i], carry);
+		block[i] += t, carry |= wordLess(block[i], t);
+		pos >>= 16, pos >>= 16;
+	}
+	CLEAN2(carry, t);
+}
+
 /*
 *******************************************************************************
 Умножение на многочлен C(x) = x mod (x^128 + x^7 + x^2 + x + 1)
@@ -109,33 +136,177 @@ void beltBlockMulCU32(u32 block[4])
 
 /*
 *******************************************************************************
-Умножение c(x) <- a(x) * b(x) mod (x^128 + x^7 + x^2 + x + 1)
+Умножение в GF(2^128)
+
+Умножение t <- t * r в beltPolyMul() выполняется с помощью ppMul() 
+с последующей редукцией ppRedBelt(). Стек ppMul() размещается в локальном 
+буфере: при n = W_OF_B(128) его глубина не превышает 23 слов 
+(см. профилировку в pp_mul.c).
+
+\safe beltPolyMul() наследует регулярность ppMul(): обращения к таблице 
+кратных t определяются тетрадами r, но таблица размещается в стеке 
+и занимает не более 2 кэш-линий.
 *******************************************************************************
 */
 
-#define beltPolyMul_local(n)\
-/* prod */		O_OF_W(2 * n)
-
-void beltPolyMul(word c[], const word a[], const word b[], void* stack)
+static void beltPolyMul(word t[W_OF_B(128)], const word r[W_OF_B(128)])
 {
 	const size_t n = W_OF_B(128);
-	word* prod;			/* [2 * n] */
-	// разметить стек
-	memSlice(stack,
-		beltPolyMul_local(n), SIZE_0, SIZE_MAX,
-		&prod, &stack);
-	// умножить
-	ppMul(prod, a, n, b, n, stack);
-	// привести по модулю
+	word prod[2 * W_OF_B(128)];
+	word stack[24];
+	ASSERT(ppMul_deep(n, n) <= sizeof(stack));
+	ppMul(prod, t, n, r, n, stack);
 	ppRedBelt(prod);
-	wwCopy(c, prod, n);
+	wwCopy(t, prod, n);
+	memWipe(prod, sizeof(prod));
+	memWipe(stack, sizeof(stack));
 }
 
-size_t beltPolyMul_deep()
+void beltPolyStart(belt_poly_st* p, const word r[W_OF_B(128)])
 {
 	const size_t n = W_OF_B(128);
-	return memSliceSize(
-		beltPolyMul_local(n),
-		ppMul_deep(n, n),
-		SIZE_MAX);
+	size_t i;
+	ASSERT(memIsValid(p, sizeof(belt_poly_st)));
+	ASSERT(wwIsValid(r, n));
+	// R[j] = r^{j + 1}
+	wwCopy(p->R[0], r, n);
+	for (i = 1; i < 4; ++i)
+		wwCopy(p->R[i], p->R[i - 1], n), beltPolyMul(p->R[i], p->R[0]);
+}
+
+void beltPolyMulR(word t[W_OF_B(128)], const belt_poly_st* p)
+{
+	ASSERT(memIsValid(p, sizeof(belt_poly_st)));
+	ASSERT(wwIsValid(t, W_OF_B(128)));
+#ifdef BELT_PCLMUL
+	if (beltPolyPCLMULIsAvail())
+	{
+		beltPolyMulR_pclmul(t, p);
+		return;
+	}
+#endif
+	beltPolyMul(t, p->R[0]);
+}
+
+void beltPolyStepA(word t[W_OF_B(128)], const void* buf, size_t count, 
+	const belt_poly_st* p)
+{
+	const size_t n = W_OF_B(128);
+	word x[W_OF_B(128)];
+	ASSERT(count % 16 == 0);
+	ASSERT(memIsValid(buf, count));
+	ASSERT(memIsValid(p, sizeof(belt_poly_st)));
+	ASSERT(wwIsValid(t, n));
+#ifdef BELT_PCLMUL
+	if (beltPolyPCLMULIsAvail())
+	{
+		beltPolyStepA_pclmul(t, buf, count, p);
+		return;
+	}
+#endif
+	for (; count; count -= 16)
+	{
+		wwFrom(x, buf, 16);
+		wwXor2(t, x, n);
+		beltPolyMul(t, p->R[0]);
+		buf = (const octet*)buf + 16;
+	}
+	memWipe(x, sizeof(x));
+}
+
+/*
+*******************************************************************************
+Многопоточная обработка
+
+Задания потоков (структуры belt_mt_job) и копии состояния размещаются 
+в одном блобе. Блоб очищается при закрытии, что гарантирует уничтожение 
+копий ключей.
+
+Фрагмент i содержит элементы с номерами от pos_i = i * (n / k) + min(i, n % k) 
+до pos_{i + 1} - 1, где n -- число полных элементов, k -- число фрагментов. 
+Такое вычисление границ исключает переполнения.
+*******************************************************************************
+*/
+
+typedef struct
+{
+	belt_mt_step_i step;	/*< функция обработки */
+	void* buf;				/*< фрагмент */
+	const void* src;		/*< исходные данные фрагмента (или 0) */
+	size_t count;			/*< число октетов фрагмента */
+	size_t pos;				/*< номер первого элемента фрагмента */
+	void* state;			/*< состояние */
+	mt_thrd_t thrd;			/*< поток */
+	bool_t created;			/*< поток создан? */
+} belt_mt_job;
+
+static void beltMTJob(void* arg)
+{
+	belt_mt_job* job = (belt_mt_job*)arg;
+	if (job->src)
+		memCopy(job->buf, job->src, job->count);
+	job->step(job->buf, job->count, job->pos, job->state);
+}
+
+err_t beltMTStep2(void* dest, const void* src, size_t count, size_t size,
+	size_t min, belt_mt_step_i step, const void* state, size_t keep, 
+	size_t nthreads)
+{
+	size_t n, k, i;
+	blob_t mem;
+	belt_mt_job* jobs;
+	ASSERT(memIsValid(src, count));
+	ASSERT(memIsValid(dest, count));
+	ASSERT(memIsValid(state, keep));
+	ASSERT(size > 0 && min > 0 && nthreads > 0);
+	// определить число фрагментов
+	k = count / min;
+	if (k > nthreads)
+		k = nthreads;
+	if (k == 0)
+		k = 1;
+	// буферы пересекаются? переписать данные заранее
+	if (src == dest)
+		src = 0;
+	else if (!memIsDisjoint2(src, count, dest, count))
+		memMove(dest, src, count), src = 0;
+	// подготовить задания
+	mem = blobCreate(k * (sizeof(belt_mt_job) + keep));
+	if (mem == 0)
+		return ERR_OUTOFMEMORY;
+	jobs = (belt_mt_job*)mem;
+	n = count / size;
+	for (i = 0; i < k; ++i)
+	{
+		jobs[i].step = step;
+		jobs[i].pos = i * (n / k) + MIN2(i, n % k);
+		jobs[i].buf = (octet*)dest + size * jobs[i].pos;
+		jobs[i].src = src ? (const octet*)src + size * jobs[i].pos : 0;
+		jobs[i].state = (octet*)(jobs + k) + i * keep;
+		memCopy(jobs[i].state, state, keep);
+		if (i > 0)
+			jobs[i - 1].count = size * (jobs[i].pos - jobs[i - 1].pos);
+	}
+	jobs[k - 1].count = count - size * jobs[k - 1].pos;
+	// запустить потоки
+	for (i = 1; i < k; ++i)
+		jobs[i].created = mtThrdCreate(&jobs[i].thrd, beltMTJob, jobs + i);
+	// обработать первый фрагмент
+	beltMTJob(jobs);
+	// дождаться завершения потоков
+	for (i = 1; i < k; ++i)
+		if (jobs[i].created)
+			mtThrdJoin(&jobs[i].thrd);
+		else
+			beltMTJob(jobs + i);
+	// завершить
+	blobClose(mem);
+	return ERR_OK;
+}
+
+err_t beltMTStep(void* dest, const void* src, size_t count, size_t size,
+	belt_mt_step_i step, const void* state, size_t keep, size_t nthreads)
+{
+	return beltMTStep2(dest, src, count, size, BELT_MT_MIN, step, state, 
+		keep, nthreads);
 }
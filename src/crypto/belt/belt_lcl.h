@@ -4,7 +4,7 @@
 \brief STB 34.101.31 (belt): local definitions
 \project bee2 [cryptographic library]
 \created 2012.12.18
-\version 2025.10.02
+\version 2026.10.16
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
@@ -123,9 +123,168 @@ void beltBlockAddBitSizeU32(u32 block[4], size_t count);
 /*	\brief block <- block + 8 * count */
 void beltHalfBlockAddBitSizeW(word block[W_OF_B(64)], size_t count);
 
+/*	\brief block <- block + pos */
+void beltBlockAddU32(u32 block[4], size_t pos);
+
 /*	\brief block(x) <- block(x) * x mod (x^128 + x^7 + x^2 + x + 1) */
 void beltBlockMulCU32(u32 block[4]);
 
+/*
+*******************************************************************************
+Расширенные H-блоки
+
+Таблица beltH<r> содержит значения H-блока, расширенные до 32 битов и 
+циклически сдвинутые влево на r позиций.
+*******************************************************************************
+*/
+
+extern const u32 beltH5[256];
+extern const u32 beltH13[256];
+extern const u32 beltH21[256];
+extern const u32 beltH29[256];
+
+/*
+*******************************************************************************
+Многоблочное шифрование
+
+Функции beltBlockEncrN() и beltBlockDecrN() зашифровывают и расшифровывают
+последовательность из n форматированных блоков [4 * n]u32 на форматированном 
+ключе key. Функция beltBlockEncrNK() зашифровывает последовательность 
+из n форматированных блоков на n ключах: i-й блок зашифровывается на ключе 
+key + 8 * i. Эта функция используется при параллельном хэшировании 
+нескольких сообщений.
+
+На платформах x86 и x64 поддержка AVX2 проверяется во время выполнения 
+(beltBlockAVX2IsAvail()). Если AVX2 поддерживается, то блоки 
+обрабатываются восьмерками векторными функциями beltBlockEncr8_avx2() и 
+beltBlockDecr8_avx2() (см. belt_block_avx2.c). Оставшиеся блоки, 
+а также все блоки на других платформах, обрабатываются четверками 
+с чередованием тактов (см. belt_block.c).
+
+Векторные функции компилируются без глобальных флагов: в GCC и Clang для 
+них указывается атрибут target("avx2") (BELT_AVX2_TARGET), в MSVC 
+intrinsic AVX2 доступны всегда.
+
+В режимах, где блоки шифруются независимо (ECB, CTR, BDE, зашифрование 
+гаммы в CHE, расшифрование в CBC и CFB), данные обрабатываются порциями 
+из BELT_BLOCK_N блоков. Для порций в состояниях режимов предусмотрены 
+буферы [4 * BELT_BLOCK_N]u32.
+*******************************************************************************
+*/
+
+#define BELT_BLOCK_N 8
+
+void beltBlockEncrN(u32 block[], size_t n, const u32 key[8]);
+void beltBlockDecrN(u32 block[], size_t n, const u32 key[8]);
+void beltBlockEncrNK(u32 block[], size_t n, const u32 key[]);
+
+#if (defined(__GNUC__) || defined(__clang__)) &&\
+	(defined(__i386__) || defined(__x86_64__))
+	#define BELT_AVX2
+	#define BELT_AVX2_TARGET __attribute__((target("avx2")))
+#elif defined(_MSC_VER) && _MSC_VER >= 1700 &&\
+	(defined(_M_IX86) || defined(_M_X64))
+	#define BELT_AVX2
+	#define BELT_AVX2_TARGET
+#endif
+
+#ifdef BELT_AVX2
+bool_t beltBlockAVX2IsAvail();
+void beltBlockEncr8_avx2(u32 block[32], const u32 key[8]);
+void beltBlockDecr8_avx2(u32 block[32], const u32 key[8]);
+void beltBlockEncr8K_avx2(u32 block[32], const u32 key[64]);
+#endif
+
+/*
+*******************************************************************************
+Многопотоковое сжатие
+
+Функция beltCompr2N() выполняет n <= BELT_BLOCK_N независимых сжатий 
+h[i] || X[i] -> h[i] с добавлением внутренних переменных S к s[i] 
+(если s != 0). Зашифрования разных сжатий выполняются совместно 
+функцией beltBlockEncrNK(). Функция используется при хэшировании 
+нескольких сообщений (beltHashMulti).
+*******************************************************************************
+*/
+
+void beltCompr2N(u32* s[], u32* h[], const u32* X[], size_t n, void* stack);
+size_t beltCompr2N_deep();
+
+/*
+*******************************************************************************
+Предвычисленные переменные HMAC
+
+Функция beltHMACPads() извлекает из состояния state, подготовленного 
+beltHMACStart(), переменные s_in, h_in внутреннего хэширования после 
+обработки блока key ^ ipad и переменные s_out, h_out внешнего хэширования 
+после обработки блока key ^ opad. Функция используется, когда вычисления 
+HMAC выполняются вне belt_hmac.c (в beltPBKDF2Multi()).
+*******************************************************************************
+*/
+
+void beltHMACPads(u32 s_in[4], u32 h_in[8], u32 s_out[4], u32 h_out[8],
+	const void* state);
+
+/*
+*******************************************************************************
+Многопоточная обработка
+
+Функция beltMTStep() переписывает данные из буфера [count]src в буфер 
+[count]dest и обрабатывает dest в нескольких потоках.
+
+Буфер dest разбивается на фрагменты, границы которых кратны size (size -- 
+размер обрабатываемых элементов: 16 для блоков, размер сектора для 
+секторов). Неполный последний элемент входит в последний фрагмент. 
+Фрагмент, который начинается с элемента pos и содержит count1 октетов, 
+обрабатывается вызовом 
+	step(dest + size * pos, count1, pos, state1),
+где state1 -- копия состояния [keep]state, своя для каждого фрагмента.
+Фрагменты имеют длину не менее BELT_MT_MIN октетов, а их число не 
+превосходит nthreads. Первый фрагмент обрабатывается в вызывающем потоке. 
+Если поток для обработки очередного фрагмента создать не удалось, 
+то фрагмент также обрабатывается в вызывающем потоке.
+
+Если буферы src и dest не пересекаются или совпадают, то копирование 
+данных выполняется в потоках пофрагментно. Иначе данные переписываются 
+заранее в вызывающем потоке.
+
+Функция возвращает ERR_OUTOFMEMORY, если не удалось выделить память 
+для копий состояния, и ERR_OK в противном случае.
+
+Функция beltMTStep2() отличается от beltMTStep() тем, что минимальная 
+длина фрагмента задается параметром min. Функция используется, когда 
+обработка одного элемента трудоемка (например, в beltPBKDF2Multi()) и 
+распараллеливать нужно даже короткие буферы.
+*******************************************************************************
+*/
+
+#define BELT_MT_MIN 65536
+
+typedef void (*belt_mt_step_i)(
+	void* buf,			/*!< [in,out] фрагмент */
+	size_t count,		/*!< [in] число октетов фрагмента */
+	size_t pos,			/*!< [in] номер первого элемента фрагмента */
+	void* state			/*!< [in,out] состояние */
+);
+
+err_t beltMTStep(void* dest, const void* src, size_t count, size_t size,
+	belt_mt_step_i step, const void* state, size_t keep, size_t nthreads);
+err_t beltMTStep2(void* dest, const void* src, size_t count, size_t size,
+	size_t min, belt_mt_step_i step, const void* state, size_t keep, 
+	size_t nthreads);
+
+/*
+*******************************************************************************
+Подготовленный ключ
+*******************************************************************************
+*/
+
+typedef struct
+{
+	u32 key[8];			/*< форматированный ключ */
+	u32 r[4];			/*< belt-block(0, key) (используется в MAC) */
+} belt_key_st;
+
 /*
 *******************************************************************************
 Состояния CTR и WBL (используются в DWP, KWP и FMT)
@@ -135,8 +294,10 @@ void beltBlockMulCU32(u32 block[4]);
 typedef struct
 {
 	u32 key[8];			/*< форматированный ключ */
+	u32 ctr0[4];		/*< начальное значение счетчика */
 	u32 ctr[4];			/*< счетчик */
 	octet block[16];	/*< блок гаммы */
+	u32 blocks[4 * BELT_BLOCK_N];	/*< порция блоков гаммы */
 	size_t reserved;	/*< резерв октетов гаммы */
 } belt_ctr_st;
 
@@ -150,12 +311,90 @@ typedef struct
 
 /*
 *******************************************************************************
-Вспомогательные функции
+Шифрование нескольких широких блоков
+
+Функция beltWBLStepEN() зашифровывает n <= BELT_BLOCK_N широких блоков 
+[count]buf[i] на ключе key. Результат совпадает с результатом 
+beltWBLStepE() для каждого блока. Функции beltWBLStepD2N() и 
+beltWBLStepDN() аналогичным образом заменяют n обращений к beltWBLStepD2() 
+и beltWBLStepD(). Зашифрования belt-block на каждом такте выполняются для 
+всех широких блоков одним обращением к beltBlockEncrN(). Функции 
+используются при пакетной обработке ключей (beltKWPWrapBatch(), 
+beltKWPUnwrapBatch()) и секторов (beltSDEEncrSectors(), 
+beltSDEDecrSectors()).
+*******************************************************************************
+*/
+
+void beltWBLStepEN(void* buf[], size_t n, size_t count, const u32 key[8]);
+void beltWBLStepD2N(void* buf1[], void* buf2[], size_t n, size_t count, 
+	const u32 key[8]);
+void beltWBLStepDN(void* buf[], size_t n, size_t count, const u32 key[8]);
+
+/*
+*******************************************************************************
+Умножение в GF(2^128) (используется в DWP и CHE)
+
+Элементы поля GF(2^128) = F_2[x] / (x^128 + x^7 + x^2 + x + 1) 
+представляются массивами [W_OF_B(128)]word: коэффициент при x^i -- это 
+i-й бит массива.
+
+Функция beltPolyStart() подготавливает в структуре belt_poly_st данные 
+для умножения на фиксированный элемент r: степени R[j] = r^{j + 1}, 
+j = 0, 1, 2, 3.
+
+Функция beltPolyMulR() умножает t на r. Функция beltPolyStepA() 
+обрабатывает [count]buf, count кратно 16: для каждого блока X буфера 
+выполняется t <- (t + X) * r.
+
+На платформах x86 и x64 поддержка инструкции PCLMULQDQ проверяется во время 
+выполнения (beltPolyPCLMULIsAvail()). Если инструкция поддерживается, то 
+умножения выполняются с помощью PCLMULQDQ (см. belt_poly_pclmul.c), причем 
+в beltPolyStepA() четверки блоков X1, X2, X3, X4 обрабатываются с одним 
+приведением по модулю:
+	t <- (t + X1) * r^4 + X2 * r^3 + X3 * r^2 + X4 * r.
+Иначе используется умножение ppMul() с редукцией ppRedBelt().
+*******************************************************************************
+*/
+
+typedef struct
+{
+	word R[4][W_OF_B(128)];		/*< R[j] = r^{j + 1} */
+} belt_poly_st;
+
+void beltPolyStart(belt_poly_st* p, const word r[W_OF_B(128)]);
+void beltPolyMulR(word t[W_OF_B(128)], const belt_poly_st* p);
+void beltPolyStepA(word t[W_OF_B(128)], const void* buf, size_t count, 
+	const belt_poly_st* p);
+
+#if defined(BELT_AVX2) && !defined(_MSC_VER)
+	#define BELT_PCLMUL
+	#define BELT_PCLMUL_TARGET __attribute__((target("pclmul,sse2")))
+#elif defined(BELT_AVX2)
+	#define BELT_PCLMUL
+	#define BELT_PCLMUL_TARGET
+#endif
+
+#ifdef BELT_PCLMUL
+bool_t beltPolyPCLMULIsAvail();
+void beltPolyMulR_pclmul(word t[W_OF_B(128)], const belt_poly_st* p);
+void beltPolyStepA_pclmul(word t[W_OF_B(128)], const void* buf, 
+	size_t count, const belt_poly_st* p);
+#endif
+
+/*
+*******************************************************************************
+Совмещенные шифрование и имитозащита (DWP и CHE)
+
+В функциях beltDWPStepEA(), beltDWPStepAD(), beltCHEStepEA(), 
+beltCHEStepAD() данные обрабатываются порциями из BELT_EA_SIZE октетов: 
+порция зашифровывается (расшифровывается) и сразу же, пока находится 
+в кэше, обрабатывается при вычислении имитовставки. Размер порции кратен 
+числу октетов, которые обрабатываются за один вызов beltBlockEncrN() 
+в CTR и за одно приведение в beltPolyStepA().
 *******************************************************************************
 */
 
-void beltPolyMul(word c[], const word a[], const word b[], void* stack);
-size_t beltPolyMul_deep();
+#define BELT_EA_SIZE 1024
 
 #ifdef __cplusplus
 } /* extern "C" */
@@ -4,7 +4,7 @@
 \brief STB 34.101.31 (belt): MAC (message authentication)
 \project bee2 [cryptographic library]
 \created 2012.12.18
-\version 2020.03.24
+\version 2026.10.16
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
@@ -55,6 +55,18 @@ void beltMACStart(void* state, const octet key[], size_t len)
 	st->filled = 0;
 }
 
+void beltMACStartK(void* state, const void* ks)
+{
+	belt_mac_st* st = (belt_mac_st*)state;
+	const belt_key_st* k = (const belt_key_st*)ks;
+	ASSERT(memIsValid(state, beltMAC_keep()));
+	ASSERT(memIsValid(ks, beltKey_keep()));
+	memCopy(st->key, k->key, 32);
+	beltBlockSetZero(st->s);
+	beltBlockCopy(st->r, k->r);
+	st->filled = 0;
+}
+
 void beltMACStepA(const void* buf, size_t count, void* state)
 {
 	belt_mac_st* st = (belt_mac_st*)state;
@@ -98,6 +110,103 @@ void beltMACStepA(const void* buf, size_t count, void* state)
 	}
 }
 
+/*
+*******************************************************************************
+Имитозащита нескольких потоков
+
+Потоки обрабатываются так же, как в beltCBCStepEMulti(): они размещаются 
+в BELT_BLOCK_N ячейках, и имитовставки s потоков из всех занятых ячеек 
+зашифровываются одним обращением к beltBlockEncrNK().
+
+Сначала в блоке потока накапливаются 16 октетов. Затем, пока у потока 
+остаются необработанные данные, блок добавляется к s, s зашифровывается, 
+а в блок загружаются следующие (не более 16) октеты данных. Последний 
+блок, как и в beltMACStepA(), остается необработанным.
+*******************************************************************************
+*/
+
+void beltMACStepAMulti(const void* buf[], const size_t count[], 
+	void* state[], size_t n)
+{
+	u32 keys[8 * BELT_BLOCK_N];
+	u32 blocks[4 * BELT_BLOCK_N];
+	belt_mac_st* sts[BELT_BLOCK_N];
+	const octet* bufs[BELT_BLOCK_N];
+	size_t counts[BELT_BLOCK_N];
+	size_t next, m, j;
+	ASSERT(memIsValid(buf, n * sizeof(const void*)));
+	ASSERT(memIsValid(count, n * sizeof(size_t)));
+	ASSERT(memIsValid(state, n * sizeof(void*)));
+	for (next = m = 0;;)
+	{
+		// занять свободные ячейки
+		for (; m < BELT_BLOCK_N && next < n; ++next)
+		{
+			belt_mac_st* st = (belt_mac_st*)state[next];
+			const octet* b = (const octet*)buf[next];
+			size_t c = count[next];
+			ASSERT(memIsDisjoint2(b, c, st, beltMAC_keep()));
+			// накопить полный блок
+			if (st->filled < 16)
+			{
+				if (c <= 16 - st->filled)
+				{
+					memCopy(st->block + st->filled, b, c);
+					st->filled += c;
+					continue;
+				}
+				memCopy(st->block + st->filled, b, 16 - st->filled);
+				c -= 16 - st->filled, b += 16 - st->filled;
+				st->filled = 16;
+			}
+			if (c == 0)
+				continue;
+			sts[m] = st, bufs[m] = b, counts[m] = c;
+			memCopy(keys + 8 * m, st->key, 32);
+			++m;
+		}
+		// все потоки обработаны?
+		if (m == 0)
+			break;
+		// s <- beltBlock(s + block), block <- следующие октеты
+		for (j = 0; j < m; ++j)
+		{
+#if (OCTET_ORDER == BIG_ENDIAN)
+			beltBlockRevU32(sts[j]->block);
+#endif
+			beltBlockXor(blocks + 4 * j, sts[j]->s, sts[j]->block);
+		}
+		beltBlockEncrNK(blocks, m, keys);
+		for (j = 0; j < m; ++j)
+		{
+			beltBlockCopy(sts[j]->s, blocks + 4 * j);
+			if (counts[j] >= 16)
+			{
+				beltBlockCopy(sts[j]->block, bufs[j]);
+				bufs[j] += 16, counts[j] -= 16;
+			}
+			else
+			{
+				memCopy(sts[j]->block, bufs[j], counts[j]);
+				sts[j]->filled = counts[j], counts[j] = 0;
+			}
+		}
+		// освободить ячейки
+		for (j = m; j--;)
+		{
+			if (counts[j])
+				continue;
+			if (j < --m)
+			{
+				sts[j] = sts[m], bufs[j] = bufs[m], counts[j] = counts[m];
+				memCopy(keys + 8 * j, keys + 8 * m, 32);
+			}
+		}
+	}
+	memWipe(keys, sizeof(keys));
+	memWipe(blocks, sizeof(blocks));
+}
+
 static void beltMACStepG_internal(void* state)
 {
 	belt_mac_st* st = (belt_mac_st*)state;
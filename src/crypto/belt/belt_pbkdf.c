@@ -4,7 +4,7 @@
 \brief STB 34.101.31 (belt): PBKDF (password-based key derivation)
 \project bee2 [cryptographic library]
 \created 2012.12.18
-\version 2025.10.01
+\version 2026.10.16
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
@@ -13,7 +13,10 @@
 #include "bee2/core/blob.h"
 #include "bee2/core/err.h"
 #include "bee2/core/mem.h"
+#include "bee2/core/u32.h"
+#include "bee2/core/util.h"
 #include "bee2/crypto/belt.h"
+#include "belt_lcl.h"
 
 /*
 *******************************************************************************
@@ -26,8 +29,7 @@ err_t beltPBKDF2(octet key[32], const octet pwd[], size_t pwd_len,
 {
 	void* state;
 	octet* t;			/* [32] */
-	void* hmac_state;	/* [beltHMAC_keep()] состояние после обработки pwd */
-	void* hmac_state1;	/* [beltHMAC_keep()] рабочая копия hmac_state */
+	void* hmac_state;	/* [beltHMAC_keep()] состояние HMAC */
 	// проверить входные данные
 	if (iter == 0 ||
 		!memIsValid(pwd, pwd_len) ||
@@ -38,28 +40,188 @@ err_t beltPBKDF2(octet key[32], const octet pwd[], size_t pwd_len,
 	state = blobCreate2(
 		(size_t)32,
 		beltHMAC_keep(),
-		beltHMAC_keep(),
 		SIZE_MAX,
-		&t, &hmac_state, &hmac_state1);
+		&t, &hmac_state);
 	if (state == 0)
 		return ERR_OUTOFMEMORY;
 	// key <- HMAC(pwd, salt || 00000001)
 	beltHMACStart(hmac_state, pwd, pwd_len);
-	memCopy(hmac_state1, hmac_state, beltHMAC_keep());
-	beltHMACStepA(salt, salt_len, hmac_state1);
+	beltHMACStepA(salt, salt_len, hmac_state);
 	key[0] = key[1] = key[2] = key[3] = 0, key[3] = 1;
-	beltHMACStepA(key, 4, hmac_state1);
-	beltHMACStepG(key, hmac_state1);
+	beltHMACStepA(key, 4, hmac_state);
+	beltHMACStepG(key, hmac_state);
 	// пересчитать key
 	memCopy(t, key, 32);
 	while (--iter)
 	{
-		memCopy(hmac_state1, hmac_state, beltHMAC_keep());
-		beltHMACStepA(t, 32, hmac_state1);
-		beltHMACStepG(t, hmac_state1);
+		beltHMACRestart(hmac_state);
+		beltHMACStepA(t, 32, hmac_state);
+		beltHMACStepG(t, hmac_state);
 		memXor2(key, t, 32);
 	}
 	// завершить
 	blobClose(state);
 	return ERR_OK;
 }
+
+/*
+*******************************************************************************
+Построение ключей по нескольким паролям
+
+Каждому паролю соответствует полоса (belt_pbkdf_lane). В полосе хранятся 
+переменные s, h внутреннего и внешнего хэширования после обработки блоков 
+pwd ^ ipad и pwd ^ opad (см. beltHMACPads()), текущее значение t 
+и накопленный ключ key.
+
+Пересчет t <- beltHMAC(pwd, t) сводится к четырем сжатиям: два сжатия 
+внутреннего хэширования (блок t и блок длины) и два сжатия внешнего 
+(хэш-значение внутреннего хэширования и блок длины). В обоих случаях 
+хэшируется ровно два блока, поэтому блоки длины одинаковы. Сжатия 
+выполняются для порций из BELT_BLOCK_N полос функцией beltCompr2N().
+
+Полосы делятся между потоками функцией beltMTStep2(). Фрагменты содержат 
+не менее BELT_BLOCK_N полос.
+*******************************************************************************
+*/
+
+typedef struct
+{
+	u32 s_in[4];		/*< переменная s после обработки pwd ^ ipad */
+	u32 h_in[8];		/*< переменная h после обработки pwd ^ ipad */
+	u32 s_out[4];		/*< переменная s после обработки pwd ^ opad */
+	u32 h_out[8];		/*< переменная h после обработки pwd ^ opad */
+	u32 ls[8];			/*< блок [4]len || [4]s */
+	u32 h[8];			/*< переменная h */
+	u32 t[8];			/*< текущее значение */
+	u32 key[8];			/*< накопленный ключ */
+} belt_pbkdf_lane;
+
+typedef struct
+{
+	size_t iter;		/*< число итераций */
+	octet u[32];		/*< первое значение t */
+	mem_align_t stack[];	/*< стек beltCompr2N */
+} belt_pbkdf_multi_st;
+
+static size_t beltPBKDF2Multi_keep()
+{
+	return sizeof(belt_pbkdf_multi_st) + beltCompr2N_deep();
+}
+
+static void beltPBKDF2MultiStep(void* buf, size_t count, size_t pos, 
+	void* state)
+{
+	belt_pbkdf_multi_st* st = (belt_pbkdf_multi_st*)state;
+	belt_pbkdf_lane* lanes = (belt_pbkdf_lane*)buf;
+	u32* s[BELT_BLOCK_N];
+	u32* h[BELT_BLOCK_N];
+	const u32* X[BELT_BLOCK_N];
+	size_t n, m, iter, i;
+	ASSERT(count % sizeof(belt_pbkdf_lane) == 0);
+	ASSERT(memIsValid(state, beltPBKDF2Multi_keep()));
+	for (n = count / sizeof(belt_pbkdf_lane); n; n -= m, lanes += m)
+	{
+		m = MIN2(n, BELT_BLOCK_N);
+		for (i = 0; i < m; ++i)
+			s[i] = lanes[i].ls + 4, h[i] = lanes[i].h;
+		for (iter = st->iter; --iter;)
+		{
+			// h <- beltHash(pwd ^ ipad || t)
+			for (i = 0; i < m; ++i)
+			{
+				beltBlockCopy(lanes[i].ls + 4, lanes[i].s_in);
+				beltBlockCopy(lanes[i].h, lanes[i].h_in);
+				beltBlockCopy(lanes[i].h + 4, lanes[i].h_in + 4);
+				X[i] = lanes[i].t;
+			}
+			beltCompr2N(s, h, X, m, st->stack);
+			for (i = 0; i < m; ++i)
+				X[i] = lanes[i].ls;
+			beltCompr2N(0, h, X, m, st->stack);
+			// t <- beltHash(pwd ^ opad || h)
+			for (i = 0; i < m; ++i)
+			{
+				beltBlockCopy(lanes[i].t, lanes[i].h);
+				beltBlockCopy(lanes[i].t + 4, lanes[i].h + 4);
+				beltBlockCopy(lanes[i].ls + 4, lanes[i].s_out);
+				beltBlockCopy(lanes[i].h, lanes[i].h_out);
+				beltBlockCopy(lanes[i].h + 4, lanes[i].h_out + 4);
+				X[i] = lanes[i].t;
+			}
+			beltCompr2N(s, h, X, m, st->stack);
+			for (i = 0; i < m; ++i)
+				X[i] = lanes[i].ls;
+			beltCompr2N(0, h, X, m, st->stack);
+			// key <- key ^ t
+			for (i = 0; i < m; ++i)
+			{
+				beltBlockCopy(lanes[i].t, lanes[i].h);
+				beltBlockCopy(lanes[i].t + 4, lanes[i].h + 4);
+				beltBlockXor2(lanes[i].key, lanes[i].t);
+				beltBlockXor2(lanes[i].key + 4, lanes[i].t + 4);
+			}
+		}
+	}
+}
+
+err_t beltPBKDF2Multi(octet key[], const octet* pwd[], 
+	const size_t pwd_len[], size_t iter, const octet* salt[], 
+	const size_t salt_len[], size_t n, size_t nthreads)
+{
+	void* state;
+	belt_pbkdf_lane* lanes;		/* [n] */
+	belt_pbkdf_multi_st* st;	/* [beltPBKDF2Multi_keep()] */
+	void* hmac_state;			/* [beltHMAC_keep()] */
+	size_t i;
+	err_t code;
+	// проверить входные данные
+	if (iter == 0 || nthreads == 0 ||
+		n == 0 || n > SIZE_MAX / sizeof(belt_pbkdf_lane) ||
+		!memIsValid(pwd, n * sizeof(const octet*)) ||
+		!memIsValid(pwd_len, n * sizeof(size_t)) ||
+		!memIsValid(salt, n * sizeof(const octet*)) ||
+		!memIsValid(salt_len, n * sizeof(size_t)) ||
+		!memIsValid(key, 32 * n))
+		return ERR_BAD_INPUT;
+	for (i = 0; i < n; ++i)
+		if (!memIsValid(pwd[i], pwd_len[i]) ||
+			!memIsValid(salt[i], salt_len[i]))
+			return ERR_BAD_INPUT;
+	// создать состояние
+	state = blobCreate2(
+		n * sizeof(belt_pbkdf_lane),
+		beltPBKDF2Multi_keep(),
+		beltHMAC_keep(),
+		SIZE_MAX,
+		&lanes, &st, &hmac_state);
+	if (state == 0)
+		return ERR_OUTOFMEMORY;
+	// t_i <- HMAC(pwd_i, salt_i || 00000001)
+	for (i = 0; i < n; ++i)
+	{
+		beltHMACStart(hmac_state, pwd[i], pwd_len[i]);
+		beltHMACStepA(salt[i], salt_len[i], hmac_state);
+		st->u[0] = st->u[1] = st->u[2] = 0, st->u[3] = 1;
+		beltHMACStepA(st->u, 4, hmac_state);
+		beltHMACStepG(st->u, hmac_state);
+		beltHMACPads(lanes[i].s_in, lanes[i].h_in, lanes[i].s_out, 
+			lanes[i].h_out, hmac_state);
+		beltBlockSetZero(lanes[i].ls);
+		beltBlockAddBitSizeU32(lanes[i].ls, 32 * 2);
+		u32From(lanes[i].t, st->u, 32);
+		beltBlockCopy(lanes[i].key, lanes[i].t);
+		beltBlockCopy(lanes[i].key + 4, lanes[i].t + 4);
+	}
+	// пересчитать ключи
+	st->iter = iter;
+	code = beltMTStep2(lanes, lanes, n * sizeof(belt_pbkdf_lane),
+		sizeof(belt_pbkdf_lane), BELT_BLOCK_N * sizeof(belt_pbkdf_lane),
+		beltPBKDF2MultiStep, st, beltPBKDF2Multi_keep(), nthreads);
+	// выгрузить ключи
+	if (code == ERR_OK)
+		for (i = 0; i < n; ++i)
+			u32To(key + 32 * i, 32, lanes[i].key);
+	// завершить
+	blobClose(state);
+	return code;
+}
@@ -0,0 +1,120 @@
+/*
+*******************************************************************************
+\file belt_poly_pclmul.c
+\brief STB 34.101.31 (belt): multiplication in GF(2^128) using PCLMULQDQ
+\project bee2 [cryptographic library]
+\created 2026.10.16
+\version 2026.10.16
+\copyright The Bee2 authors
+\license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
+*******************************************************************************
+*/
+
+#include "bee2/core/cpu.h"
+#include "bee2/core/mem.h"
+#include "bee2/core/util.h"
+#include "belt_lcl.h"
+
+#ifdef BELT_PCLMUL
+
+#include <emmintrin.h>
+#include <wmmintrin.h>
+
+/*
+*******************************************************************************
+Проверка поддержки PCLMULQDQ
+
+Поддержка определяется модулем cpu (см. cpuHas()). Дополнительно 
+проверяется поддержка SSE2 (на платформе x64 она гарантирована).
+*******************************************************************************
+*/
+
+bool_t beltPolyPCLMULIsAvail()
+{
+	return cpuHas(CPU_SSE2 | CPU_PCLMUL);
+}
+
+/*
+*******************************************************************************
+Умножение и приведение
+
+Элемент GF(2^128) загружается в 128-разрядный регистр как есть: на
+платформах x86 и x64 младшие 64 бита регистра содержат коэффициенты
+при x^0,..., x^63.
+
+Макрос MUL добавляет к 256-битовой сумме H || L произведение многочленов
+A и B (четыре умножения 64 x 64). Макрос RED приводит H || L по модулю
+f(x) = x^128 + x^7 + x^2 + x + 1. Пусть H = H1 x^64 + H0, P = x^7 + x^2 +
+x + 1. Тогда H x^128 = H0 P + (H1 P) x^64, а (H1 P) x^64 = Q0 x^64 +
+Q1 x^128 = Q0 x^64 + Q1 P, где Q1 || Q0 = H1 P и deg Q1 < 7.
+*******************************************************************************
+*/
+
+#define LOADU(s) _mm_loadu_si128((__m128i const*)(s))
+#define STOREU(s, W) _mm_storeu_si128((__m128i*)(s), (W))
+#define X2(W1, W2) _mm_xor_si128(W1, W2)
+#define CLMUL(W1, W2, i) _mm_clmulepi64_si128(W1, W2, i)
+
+#define MUL(H, L, A, B)\
+	L = X2(L, CLMUL(A, B, 0x00));\
+	H = X2(H, CLMUL(A, B, 0x11));\
+	M = X2(CLMUL(A, B, 0x01), CLMUL(A, B, 0x10));\
+	L = X2(L, _mm_slli_si128(M, 8));\
+	H = X2(H, _mm_srli_si128(M, 8))
+
+#define RED(Z, H, L)\
+	M = CLMUL(H, P, 0x01);\
+	Z = X2(X2(L, CLMUL(H, P, 0x00)), _mm_slli_si128(M, 8));\
+	Z = X2(Z, CLMUL(_mm_srli_si128(M, 8), P, 0x00))
+
+BELT_PCLMUL_TARGET
+void beltPolyMulR_pclmul(word t[W_OF_B(128)], const belt_poly_st* p)
+{
+	__m128i T, R, H, L, M, P;
+	P = _mm_set_epi32(0, 0, 0, 0x87);
+	T = LOADU(t), R = LOADU(p->R[0]);
+	H = L = _mm_setzero_si128();
+	MUL(H, L, T, R);
+	RED(T, H, L);
+	STOREU(t, T);
+}
+
+BELT_PCLMUL_TARGET
+void beltPolyStepA_pclmul(word t[W_OF_B(128)], const void* buf,
+	size_t count, const belt_poly_st* p)
+{
+	__m128i T, X, H, L, M, P;
+	__m128i R1, R2, R3, R4;
+	ASSERT(count % 16 == 0);
+	P = _mm_set_epi32(0, 0, 0, 0x87);
+	T = LOADU(t);
+	R1 = LOADU(p->R[0]), R2 = LOADU(p->R[1]);
+	R3 = LOADU(p->R[2]), R4 = LOADU(p->R[3]);
+	// t <- (t + X1) r^4 + X2 r^3 + X3 r^2 + X4 r
+	for (; count >= 64; count -= 64)
+	{
+		H = L = _mm_setzero_si128();
+		X = X2(T, LOADU(buf));
+		MUL(H, L, X, R4);
+		X = LOADU((const octet*)buf + 16);
+		MUL(H, L, X, R3);
+		X = LOADU((const octet*)buf + 32);
+		MUL(H, L, X, R2);
+		X = LOADU((const octet*)buf + 48);
+		MUL(H, L, X, R1);
+		RED(T, H, L);
+		buf = (const octet*)buf + 64;
+	}
+	// t <- (t + X) r
+	for (; count; count -= 16)
+	{
+		H = L = _mm_setzero_si128();
+		X = X2(T, LOADU(buf));
+		MUL(H, L, X, R1);
+		RED(T, H, L);
+		buf = (const octet*)buf + 16;
+	}
+	STOREU(t, T);
+}
+
+#endif /* BELT_PCLMUL */
@@ -4,7 +4,7 @@
 \brief STB 34.101.31 (belt): SDE (Sectorwise Disk Encryption)
 \project bee2 [cryptographic library]
 \created 2018.09.01
-\version 2025.04.25
+\version 2026.10.16
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
@@ -119,3 +119,117 @@ err_t beltSDEDecr(void* dest, const void* src, size_t count,
 	blobClose(state);
 	return ERR_OK;
 }
+
+/*
+*******************************************************************************
+Пакетная обработка секторов
+
+Сектор с номером pos (от начала пакета) обрабатывается на синхропосылке 
+iv + pos, где iv интерпретируется как 128-битовое число, записанное 
+октетами от младшего к старшему. Синхропосылки BELT_BLOCK_N секторов 
+зашифровываются одним вызовом beltBlockEncrN(). Эти же секторы 
+обрабатываются в режиме WBL одновременно (см. beltWBLStepEN(), 
+beltWBLStepDN()). Фрагменты пакета (целые числа секторов) обрабатываются 
+в нескольких потоках (см. beltMTStep()).
+*******************************************************************************
+*/
+
+typedef struct
+{
+	belt_sde_st sde[1];				/*< состояние SDE */
+	u32 iv[4];						/*< синхропосылка первого сектора */
+	u32 ivs[4 * BELT_BLOCK_N];		/*< порция синхропосылок */
+	size_t size;					/*< размер сектора */
+} belt_sde_sectors_st;
+
+static void beltSDESectorsStep(void* buf, size_t count, size_t pos, 
+	void* state, void (*step)(void*[], size_t, size_t, const u32[8]))
+{
+	belt_sde_sectors_st* st = (belt_sde_sectors_st*)state;
+	void* bufs[BELT_BLOCK_N];
+	size_t n, i;
+	ASSERT(count % st->size == 0);
+	for (; count; count -= n * st->size, pos += n)
+	{
+		n = MIN2(count / st->size, BELT_BLOCK_N);
+		// зашифровать синхропосылки
+		for (i = 0; i < n; ++i)
+		{
+			beltBlockCopy(st->ivs + 4 * i, st->iv);
+			beltBlockAddU32(st->ivs + 4 * i, pos + i);
+		}
+		beltBlockEncrN(st->ivs, n, st->sde->wbl->key);
+		// каскад XEX
+		for (i = 0; i < n; ++i)
+		{
+			bufs[i] = (octet*)buf + i * st->size;
+			u32To(st->sde->s, 16, st->ivs + 4 * i);
+			beltBlockXor2(bufs[i], st->sde->s);
+		}
+		step(bufs, n, st->size, st->sde->wbl->key);
+		for (i = 0; i < n; ++i)
+		{
+			u32To(st->sde->s, 16, st->ivs + 4 * i);
+			beltBlockXor2(bufs[i], st->sde->s);
+		}
+		buf = (octet*)buf + n * st->size;
+	}
+}
+
+static void beltSDESectorsStepE(void* buf, size_t count, size_t pos, 
+	void* state)
+{
+	beltSDESectorsStep(buf, count, pos, state, beltWBLStepEN);
+}
+
+static void beltSDESectorsStepD(void* buf, size_t count, size_t pos, 
+	void* state)
+{
+	beltSDESectorsStep(buf, count, pos, state, beltWBLStepDN);
+}
+
+static err_t beltSDESectors(void* dest, const void* src, size_t size, 
+	size_t n, const octet key[], size_t len, const octet iv[16], 
+	size_t nthreads, belt_mt_step_i step)
+{
+	belt_sde_sectors_st* st;
+	err_t code;
+	// проверить входные данные
+	if (size % 16 != 0 || size < 32 || n == 0 || n > SIZE_MAX / size ||
+		len != 16 && len != 24 && len != 32 ||
+		nthreads == 0 ||
+		!memIsValid(src, size * n) ||
+		!memIsValid(key, len) ||
+		!memIsValid(iv, 16) ||
+		!memIsValid(dest, size * n))
+		return ERR_BAD_INPUT;
+	// создать состояние
+	st = (belt_sde_sectors_st*)blobCreate(sizeof(belt_sde_sectors_st));
+	if (st == 0)
+		return ERR_OUTOFMEMORY;
+	// обработать секторы
+	beltSDEStart(st->sde, key, len);
+	u32From(st->iv, iv, 16);
+	st->size = size;
+	code = beltMTStep(dest, src, size * n, size, step, st, 
+		sizeof(belt_sde_sectors_st), nthreads);
+	// завершить
+	blobClose(st);
+	return code;
+}
+
+err_t beltSDEEncrSectors(void* dest, const void* src, size_t size, 
+	size_t n, const octet key[], size_t len, const octet iv[16], 
+	size_t nthreads)
+{
+	return beltSDESectors(dest, src, size, n, key, len, iv, nthreads, 
+		beltSDESectorsStepE);
+}
+
+err_t beltSDEDecrSectors(void* dest, const void* src, size_t size, 
+	size_t n, const octet key[], size_t len, const octet iv[16], 
+	size_t nthreads)
+{
+	return beltSDESectors(dest, src, size, n, key, len, iv, nthreads, 
+		beltSDESectorsStepD);
+}
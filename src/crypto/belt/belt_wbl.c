@@ -4,7 +4,7 @@
 \brief STB 34.101.31 (belt): wide block encryption
 \project bee2 [cryptographic library]
 \created 2017.11.03
-\version 2025.05.07
+\version 2026.10.16
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
@@ -34,6 +34,16 @@
 *******************************************************************************
 */
 
+#if (OCTET_ORDER == LITTLE_ENDIAN)
+	#define beltWBLXorRound(block, round)\
+		memXor2(block, &round, O_PER_W)
+#else // BIG_ENDIAN
+	#define beltWBLXorRound(block, round)\
+		round = wordRev(round);\
+		memXor2(block, &round, O_PER_W);\
+		round = wordRev(round)
+#endif // OCTET_ORDER
+
 size_t beltWBL_keep()
 {
 	return sizeof(belt_wbl_st);
@@ -68,13 +78,7 @@ static void beltWBLStepEBase(void* buf, size_t count, void* state)
 		// block <- beltBlockEncr(block) + <round>
 		beltBlockEncr(st->block, st->key);
 		st->round++;
-#if (OCTET_ORDER == LITTLE_ENDIAN)
-		memXor2(st->block, &st->round, O_PER_W);
-#else // BIG_ENDIAN
-		st->round = wordRev(st->round);
-		memXor2(st->block, &st->round, O_PER_W);
-		st->round = wordRev(st->round);
-#endif // OCTET_ORDER
+		beltWBLXorRound(st->block, st->round);
 		// r*_до_сдвига <- r*_до_сдвига + block
 		beltBlockXor2((octet*)buf + count - 32, st->block);
 	}
@@ -85,7 +89,7 @@ static void beltWBLStepEOpt(void* buf, size_t count, void* state)
 {
 	belt_wbl_st* st = (belt_wbl_st*)state;
 	word n = ((word)count + 15) / 16;
-	size_t i;
+	size_t i, j;
 	ASSERT(count >= 32 && count % 16 == 0);
 	ASSERT(memIsDisjoint2(buf, count, state, beltWBL_keep()));
 	// sum <- r1 + ... + r_{n-1}
@@ -95,33 +99,30 @@ static void beltWBLStepEOpt(void* buf, size_t count, void* state)
 	// 2 * n итераций 
 	ASSERT(st->round % (2 * n) == 0);
 	// sum будет записываться по смещению i: 
-	// это блок r1 в начале такта и блок r* в конце)
-	i = 0; 
+	// это блок r1 в начале такта и блок r* в конце);
+	// r* находится по смещению j
+	i = 0, j = count - 16;
 	do
 	{
 		// block <- beltBlockEncr(sum) + <round>
 		beltBlockCopy(st->block, st->sum);
 		beltBlockEncr(st->block, st->key);
 		st->round++;
-#if (OCTET_ORDER == LITTLE_ENDIAN)
-		memXor2(st->block, &st->round, O_PER_W);
-#else // BIG_ENDIAN
-		st->round = wordRev(st->round);
-		memXor2(st->block, &st->round, O_PER_W);
-		st->round = wordRev(st->round);
-#endif // OCTET_ORDER
+		beltWBLXorRound(st->block, st->round);
 		// r* <- r* + block
-		beltBlockXor2((octet*)buf + (i + count - 16) % count, st->block);
+		beltBlockXor2((octet*)buf + j, st->block);
 		// запомнить sum
 		beltBlockCopy(st->block, st->sum);
 		// пересчитать sum: добавить новое слагаемое
-		beltBlockXor2(st->sum, (octet*)buf + (i + count - 16) % count);
+		beltBlockXor2(st->sum, (octet*)buf + j);
 		// пересчитать sum: исключить старое слагаемое
 		beltBlockXor2(st->sum, (octet*)buf + i);
 		// сохранить sum
 		beltBlockCopy((octet*)buf + i, st->block);
 		// вперед
-		i = (i + 16) % count;
+		j = i, i += 16;
+		if (i == count)
+			i = 0;
 	}
 	while (st->round % (2 * n));
 }
@@ -143,13 +144,7 @@ static void beltWBLStepDBase(void* buf, size_t count, void* state)
 		beltBlockCopy(buf, st->block);
 		// block <- beltBlockEncr(block) + <round>
 		beltBlockEncr(st->block, st->key);
-#if (OCTET_ORDER == LITTLE_ENDIAN)
-		memXor2(st->block, &st->round, O_PER_W);
-#else // BIG_ENDIAN
-		st->round = wordRev(st->round);
-		memXor2(st->block, &st->round, O_PER_W);
-		st->round = wordRev(st->round);
-#endif // OCTET_ORDER
+		beltWBLXorRound(st->block, st->round);
 		// r* <- r* + block
 		beltBlockXor2((octet*)buf + count - 16, st->block);
 		// r1 <- r1 + r2 + ... + r_{n-1}
@@ -162,7 +157,7 @@ static void beltWBLStepDOpt(void* buf, size_t count, void* state)
 {
 	belt_wbl_st* st = (belt_wbl_st*)state;
 	word n = ((word)count + 15) / 16;
-	size_t i;
+	size_t i, j;
 	ASSERT(count >= 32 && count % 16 == 0);
 	ASSERT(memIsDisjoint2(buf, count, state, beltWBL_keep()));
 	// sum <- r1 + ... + r_{n-2} (будущая сумма r2 + ... + r_{n-1})
@@ -170,29 +165,25 @@ static void beltWBLStepDOpt(void* buf, size_t count, void* state)
 	for (i = 16; i + 32 < count; i += 16)
 		beltBlockXor2(st->sum, (octet*)buf + i);
 	// 2 * n итераций (sum будет записываться по смещению i: 
-	// это блок r* в начале такта и блок r1 в конце)
-	for (st->round = 2 * n, i = count - 16; st->round; --st->round)
+	// это блок r* в начале такта и блок r1 в конце; 
+	// новый r* находится по смещению j)
+	for (st->round = 2 * n, i = count - 16, j = count - 32; st->round; 
+		--st->round)
 	{
 		// block <- beltBlockEncr(r*) + <round>
 		beltBlockCopy(st->block, (octet*)buf + i);
 		beltBlockEncr(st->block, st->key);
-#if (OCTET_ORDER == LITTLE_ENDIAN)
-		memXor2(st->block, &st->round, O_PER_W);
-#else // BIG_ENDIAN
-		st->round = wordRev(st->round);
-		memXor2(st->block, &st->round, O_PER_W);
-		st->round = wordRev(st->round);
-#endif // OCTET_ORDER
+		beltWBLXorRound(st->block, st->round);
 		// r* <- r* + block
-		beltBlockXor2((octet*)buf + (i + count - 16) % count, st->block);
+		beltBlockXor2((octet*)buf + j, st->block);
 		// r1 <- pre r* + sum
 		beltBlockXor2((octet*)buf + i, st->sum);
 		// пересчитать sum: исключить старое слагаемое
-		beltBlockXor2(st->sum, (octet*)buf + (i + count - 32) % count);
+		beltBlockXor2(st->sum, (octet*)buf + (j ? j : count) - 16);
 		// пересчитать sum: добавить новое слагаемое
 		beltBlockXor2(st->sum, (octet*)buf + i);
 		// назад
-		i = (i + count - 16) % count;
+		i = j, j = (j ? j : count) - 16;
 	}
 }
 
@@ -232,13 +223,7 @@ void beltWBLStepD2(void* buf1, void* buf2, size_t count, void* state)
 		beltBlockCopy(buf1, st->block);
 		// block <- beltBlockEncr(block) + <round>
 		beltBlockEncr(st->block, st->key);
-#if (OCTET_ORDER == LITTLE_ENDIAN)
-		memXor2(st->block, &st->round, O_PER_W);
-#else // BIG_ENDIAN
-		st->round = wordRev(st->round);
-		memXor2(st->block, &st->round, O_PER_W);
-		st->round = wordRev(st->round);
-#endif // OCTET_ORDER
+		beltWBLXorRound(st->block, st->round);
 		// r* <- r* + block
 		beltBlockXor2(buf2, st->block);
 		// r1 <- r1 + r2 + ... + r_{n-1}
@@ -259,3 +244,236 @@ void beltWBLStepR(void* buf, size_t count, void* state)
 		beltWBLStepEBase(buf, count, state) :
 		beltWBLStepEOpt(buf, count, state);
 }
+
+/*
+*******************************************************************************
+Шифрование нескольких широких блоков
+
+Такты beltWBLStepEBase(), beltWBLStepEOpt(), beltWBLStepDOpt() и 
+beltWBLStepD2() выполняются одновременно для всех широких блоков. Блоки, 
+которые подлежат зашифрованию на такте, собираются в массиве blocks и 
+зашифровываются функцией beltBlockEncrN(). Если AVX2 поддерживается, 
+то beltBlockEncrN() обрабатывает BELT_BLOCK_N блоков за одно обращение 
+к beltBlockEncr8_avx2(), и затраты на такт для всех широких блоков 
+сопоставимы с затратами на такт для одного блока.
+
+В функциях Opt суммы блоков sum хранятся в массиве sums, смещения i и j 
+одинаковы для всех широких блоков. Затраты на такт не зависят от длины 
+широкого блока.
+*******************************************************************************
+*/
+
+static void beltWBLStepENBase(void* buf[], size_t n, size_t count, 
+	const u32 key[8])
+{
+	u32 blocks[4 * BELT_BLOCK_N];
+	word round = 0;
+	word k = ((word)count + 15) / 16;
+	size_t i, j;
+	ASSERT(n <= BELT_BLOCK_N);
+	ASSERT(count >= 32);
+	do
+	{
+		for (j = 0; j < n; ++j)
+		{
+			octet* b = (octet*)buf[j];
+			octet* block = (octet*)(blocks + 4 * j);
+			ASSERT(memIsDisjoint2(b, count, blocks, sizeof(blocks)));
+			// block <- r1 + ... + r_{n-1}
+			beltBlockCopy(block, b);
+			for (i = 16; i + 16 < count; i += 16)
+				beltBlockXor2(block, b + i);
+			// r <- ShLo^128(r)
+			memMove(b, b + 16, count - 16);
+			// r* <- block
+			beltBlockCopy(b + count - 16, block);
+			u32From(blocks + 4 * j, block, 16);
+		}
+		// block <- beltBlockEncr(block) + <round>
+		beltBlockEncrN(blocks, n, key);
+		round++;
+		for (j = 0; j < n; ++j)
+		{
+			octet* block = (octet*)(blocks + 4 * j);
+			u32To(block, 16, blocks + 4 * j);
+			beltWBLXorRound(block, round);
+			// r*_до_сдвига <- r*_до_сдвига + block
+			beltBlockXor2((octet*)buf[j] + count - 32, block);
+		}
+	}
+	while (round % (2 * k));
+	memWipe(blocks, sizeof(blocks));
+}
+
+static void beltWBLStepENOpt(void* buf[], size_t n, size_t count, 
+	const u32 key[8])
+{
+	u32 blocks[4 * BELT_BLOCK_N];
+	octet sums[16 * BELT_BLOCK_N];
+	octet block[16];
+	word round = 0;
+	word k = (word)count / 16;
+	size_t i, j, t;
+	ASSERT(n <= BELT_BLOCK_N);
+	ASSERT(count >= 32 && count % 16 == 0);
+	// sums[t] <- r1 + ... + r_{k-1}
+	for (t = 0; t < n; ++t)
+	{
+		octet* b = (octet*)buf[t];
+		ASSERT(memIsDisjoint2(b, count, sums, sizeof(sums)));
+		beltBlockCopy(sums + 16 * t, b);
+		for (i = 16; i + 16 < count; i += 16)
+			beltBlockXor2(sums + 16 * t, b + i);
+	}
+	// 2 * k итераций
+	i = 0, j = count - 16;
+	do
+	{
+		// blocks[t] <- beltBlockEncr(sums[t]) + <round>
+		for (t = 0; t < n; ++t)
+			u32From(blocks + 4 * t, sums + 16 * t, 16);
+		beltBlockEncrN(blocks, n, key);
+		round++;
+		for (t = 0; t < n; ++t)
+		{
+			octet* b = (octet*)buf[t];
+			octet* sum = sums + 16 * t;
+			u32To(block, 16, blocks + 4 * t);
+			beltWBLXorRound(block, round);
+			// r* <- r* + block
+			beltBlockXor2(b + j, block);
+			// пересчитать sum и сохранить прежнюю sum в r1
+			beltBlockCopy(block, sum);
+			beltBlockXor2(sum, b + j);
+			beltBlockXor2(sum, b + i);
+			beltBlockCopy(b + i, block);
+		}
+		// вперед
+		j = i, i += 16;
+		if (i == count)
+			i = 0;
+	}
+	while (round % (2 * k));
+	memWipe(blocks, sizeof(blocks));
+	memWipe(sums, sizeof(sums));
+	memWipe(block, sizeof(block));
+}
+
+void beltWBLStepEN(void* buf[], size_t n, size_t count, const u32 key[8])
+{
+	(count % 16 || count < 64) ? 
+		beltWBLStepENBase(buf, n, count, key) :
+		beltWBLStepENOpt(buf, n, count, key);
+}
+
+void beltWBLStepD2N(void* buf1[], void* buf2[], size_t n, size_t count, 
+	const u32 key[8])
+{
+	u32 blocks[4 * BELT_BLOCK_N];
+	word round;
+	size_t i, j;
+	ASSERT(n <= BELT_BLOCK_N);
+	ASSERT(count >= 32);
+	for (round = 2 * (((word)count + 15) / 16); round; --round)
+	{
+		for (j = 0; j < n; ++j)
+		{
+			octet* b1 = (octet*)buf1[j];
+			octet* block = (octet*)(blocks + 4 * j);
+			ASSERT(memIsDisjoint3(b1, count - 16, buf2[j], 16, 
+				blocks, sizeof(blocks)));
+			// block <- r*
+			beltBlockCopy(block, buf2[j]);
+			// r <- ShHi^128(r)
+			memCopy(buf2[j], b1 + count - 32, 16);
+			memMove(b1 + 16, b1, count - 32);
+			// r1 <- block
+			beltBlockCopy(b1, block);
+			u32From(blocks + 4 * j, block, 16);
+		}
+		// block <- beltBlockEncr(block) + <round>
+		beltBlockEncrN(blocks, n, key);
+		for (j = 0; j < n; ++j)
+		{
+			octet* b1 = (octet*)buf1[j];
+			octet* block = (octet*)(blocks + 4 * j);
+			u32To(block, 16, blocks + 4 * j);
+			beltWBLXorRound(block, round);
+			// r* <- r* + block
+			beltBlockXor2(buf2[j], block);
+			// r1 <- r1 + r2 + ... + r_{n-1}
+			for (i = 16; i + 32 < count; i += 16)
+				beltBlockXor2(b1, b1 + i);
+			if (i + 16 < count)
+			{
+				memXor2(b1, b1 + i, count - 16 - i);
+				memXor2(b1 + count - 16 - i, buf2[j], 32 + i - count);
+			}
+		}
+	}
+	memWipe(blocks, sizeof(blocks));
+}
+
+static void beltWBLStepDNOpt(void* buf[], size_t n, size_t count, 
+	const u32 key[8])
+{
+	u32 blocks[4 * BELT_BLOCK_N];
+	octet sums[16 * BELT_BLOCK_N];
+	octet block[16];
+	word round;
+	size_t i, j, t;
+	ASSERT(n <= BELT_BLOCK_N);
+	ASSERT(count >= 32 && count % 16 == 0);
+	// sums[t] <- r1 + ... + r_{k-2}
+	for (t = 0; t < n; ++t)
+	{
+		octet* b = (octet*)buf[t];
+		ASSERT(memIsDisjoint2(b, count, sums, sizeof(sums)));
+		beltBlockCopy(sums + 16 * t, b);
+		for (i = 16; i + 32 < count; i += 16)
+			beltBlockXor2(sums + 16 * t, b + i);
+	}
+	// 2 * k итераций
+	for (round = 2 * ((word)count / 16), i = count - 16, j = count - 32; 
+		round; --round)
+	{
+		// blocks[t] <- beltBlockEncr(r*)
+		for (t = 0; t < n; ++t)
+			u32From(blocks + 4 * t, (octet*)buf[t] + i, 16);
+		beltBlockEncrN(blocks, n, key);
+		for (t = 0; t < n; ++t)
+		{
+			octet* b = (octet*)buf[t];
+			octet* sum = sums + 16 * t;
+			u32To(block, 16, blocks + 4 * t);
+			beltWBLXorRound(block, round);
+			// r* <- r* + block
+			beltBlockXor2(b + j, block);
+			// r1 <- pre r* + sum
+			beltBlockXor2(b + i, sum);
+			// пересчитать sum
+			beltBlockXor2(sum, b + (j ? j : count) - 16);
+			beltBlockXor2(sum, b + i);
+		}
+		// назад
+		i = j, j = (j ? j : count) - 16;
+	}
+	memWipe(blocks, sizeof(blocks));
+	memWipe(sums, sizeof(sums));
+	memWipe(block, sizeof(block));
+}
+
+void beltWBLStepDN(void* buf[], size_t n, size_t count, const u32 key[8])
+{
+	void* buf2[BELT_BLOCK_N];
+	size_t t;
+	ASSERT(n <= BELT_BLOCK_N);
+	if (count % 16 == 0 && count >= 80)
+		beltWBLStepDNOpt(buf, n, count, key);
+	else
+	{
+		for (t = 0; t < n; ++t)
+			buf2[t] = (octet*)buf[t] + count - 16;
+		beltWBLStepD2N(buf, buf2, n, count, key);
+	}
+}
@@ -4,7 +4,7 @@
 \brief STB 34.101.45 (bign): Bign algorithms with bign-curve512v1 and bash512
 \project bee2 [cryptographic library]
 \created 2026.03.06
-\version 2026.03.08
+\version 2026.10.16
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
@@ -35,10 +35,12 @@ static size_t _once;			/*< триггер однократности */
 static mt_mtx_t _mtx[1];		/*< мьютекс */
 static bool_t _inited;			/*< мьютекс создан? */
 static ec_o* _ec;				/*< кривая */
+static bign_pre_cache* _cache;	/*< кэш предвычислений */
 
 static void bign256Destroy()
 {
 	mtMtxLock(_mtx);
+	bignPreCacheClose(_cache), _cache = 0;
 	bignEcClose(_ec), _ec = 0;
 	mtMtxUnlock(_mtx);
 	mtMtxClose(_mtx);
@@ -80,6 +82,9 @@ static err_t bign256Ec(const ec_o** pec)
 		ERR_CALL_HANDLE(code, mtMtxUnlock(_mtx));
 		// настроить ec->pre
 		_ec->pre = &_pre;
+		// создать кэш (при ошибке кэш не используется)
+		if (bignPreCacheCreate(&_cache, _ec) != ERR_OK)
+			_cache = 0;
 	}
 	// возвратить кривую
 	*pec = _ec;
@@ -174,6 +179,17 @@ err_t bign256Sign2(octet sig[96], const octet hash[64],
 		t_len);
 }
 
+err_t bign256SignBatch(octet sigs[], const octet hashes[], size_t count,
+	const octet privkey[64], gen_i rng, void* rng_state, size_t nthreads)
+{
+	err_t code;
+	const ec_o* ec;
+	code = bign256Ec(&ec);
+	ERR_CALL_CHECK(code);
+	return bignSignBatchEc(sigs, ec, _oid_der, sizeof(_oid_der), hashes, 
+		count, privkey, rng, rng_state, nthreads);
+}
+
 err_t bign256Verify(const octet hash[64], const octet sig[96], 
 	const octet pubkey[128])
 {
@@ -181,7 +197,19 @@ err_t bign256Verify(const octet hash[64], const octet sig[96],
 	const ec_o* ec;
 	code = bign256Ec(&ec);
 	ERR_CALL_CHECK(code);
-	return bignVerifyEc(ec, _oid_der, sizeof(_oid_der), hash, sig, pubkey);
+	return bignVerifyCachedEc(_cache, ec, _oid_der, sizeof(_oid_der), hash, 
+		sig, pubkey);
+}
+
+err_t bign256VerifyBatch(err_t rets[], const octet hashes[], 
+	const octet sigs[], const octet pubkeys[], size_t count, size_t nthreads)
+{
+	err_t code;
+	const ec_o* ec;
+	code = bign256Ec(&ec);
+	ERR_CALL_CHECK(code);
+	return bignVerifyBatchEc(rets, ec, _oid_der, sizeof(_oid_der), hashes, 
+		sigs, pubkeys, count, nthreads);
 }
 
 /*
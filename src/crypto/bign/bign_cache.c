@@ -0,0 +1,236 @@
+/*
+*******************************************************************************
+\file bign_cache.c
+\brief STB 34.101.45 (bign): public key precomputation cache
+\project bee2 [cryptographic library]
+\created 2026.10.16
+\version 2026.10.16
+\copyright The Bee2 authors
+\license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
+*******************************************************************************
+*/
+
+#include "bee2/core/blob.h"
+#include "bee2/core/err.h"
+#include "bee2/core/mem.h"
+#include "bee2/core/mt.h"
+#include "bee2/core/util.h"
+#include "bee2/crypto/belt.h"
+#include "bign_lcl.h"
+
+/*
+*******************************************************************************
+Кэш предвычислений для открытых ключей
+
+Кэш содержит до BIGN_PRE_CACHE_SIZE состояний bignPubkeyPreEc(). При
+добавлении нового состояния в заполненный кэш вытесняется состояние,
+к которому дольше всего не обращались (LRU).
+
+Кривая содержит предвычисленные кратные базовой точки, поэтому 
+в состояниях используются и хранятся только открытые ключи и их кратные 
+(первые bignPubkeyPreQ_keep() октетов состояний).
+
+Построение состояния стоит нескольких проверок подписи. Поэтому состояние
+строится не при первой, а при повторной проверке на данном ключе.
+Отпечатки ключей, которые встретились один раз, запоминаются в очереди
+кандидатов длины BIGN_PRE_CACHE_SIZE. Благодаря этому одноразовые ключи
+не вытесняют из кэша часто используемые.
+
+Ключи ищутся по отпечаткам -- первым словам хэш-значений belt-hash.
+Совпадение отпечатков подтверждается сравнением ключей, которые
+размещаются в начале состояний.
+
+Кэш защищается мьютексом. Хранимые состояния снабжаются счетчиками 
+ссылок: одна ссылка принадлежит кэшу, остальные -- потокам, которые 
+проверяют подписи. Найдя состояние, поток под защитой мьютекса 
+увеличивает счетчик, а затем проверяет подпись после снятия блокировки 
+непосредственно на хранимом состоянии, без копирования. По окончании 
+проверки счетчик атомарно уменьшается. Состояние, вытесненное из кэша, 
+освобождается тем, кто последним сбросит ссылку на него.
+
+Память под полное состояние bignPubkeyPreEc() выделяется только при его 
+построении. Построение выполняется без блокировки. Если два потока 
+одновременно построили состояние для одного ключа, то в кэш попадает 
+только одно из них.
+*******************************************************************************
+*/
+
+#define BIGN_PRE_CACHE_SIZE 64
+
+typedef struct
+{
+	size_t refs;		/*< число ссылок */
+	mem_align_t pre[];	/*< хранимая часть состояния bignPubkeyPreEc() */
+} bign_pre_ref;
+
+typedef struct
+{
+	word fp;			/*< отпечаток ключа */
+	size_t stamp;		/*< отметка последнего обращения (0 -- пусто) */
+	bign_pre_ref* ref;	/*< состояние */
+} bign_pre_entry;
+
+struct bign_pre_cache
+{
+	mt_mtx_t mtx[1];							/*< мьютекс */
+	size_t no;									/*< длина элемента поля */
+	size_t keep;								/*< длина хранимой части */
+	size_t stamp;								/*< счетчик обращений */
+	bign_pre_entry entries[BIGN_PRE_CACHE_SIZE];/*< состояния */
+	word cands[BIGN_PRE_CACHE_SIZE];			/*< отпечатки кандидатов */
+	size_t cand_pos;							/*< позиция в cands */
+};
+
+err_t bignPreCacheCreate(bign_pre_cache** pcache, const ec_o* ec)
+{
+	bign_pre_cache* cache;
+	ASSERT(memIsValid(pcache, sizeof(bign_pre_cache*)));
+	ASSERT(ecIsOperable(ec));
+	// создать кэш
+	cache = (bign_pre_cache*)blobCreate(sizeof(bign_pre_cache));
+	if (cache == 0)
+		return ERR_OUTOFMEMORY;
+	if (!mtMtxCreate(cache->mtx))
+	{
+		blobClose(cache);
+		return ERR_OUTOFMEMORY;
+	}
+	cache->no = ec->f->no;
+	cache->keep = bignPubkeyPreQ_keep(4 * cache->no);
+	*pcache = cache;
+	return ERR_OK;
+}
+
+void bignPreCacheClose(bign_pre_cache* cache)
+{
+	size_t i;
+	if (cache == 0)
+		return;
+	for (i = 0; i < BIGN_PRE_CACHE_SIZE; ++i)
+		blobClose(cache->entries[i].ref);
+	mtMtxClose(cache->mtx);
+	blobClose(cache);
+}
+
+static size_t bignPreCacheFind(const bign_pre_cache* cache, word fp,
+	const octet pubkey[])
+{
+	size_t i;
+	for (i = 0; i < BIGN_PRE_CACHE_SIZE; ++i)
+		if (cache->entries[i].stamp && cache->entries[i].fp == fp &&
+			memEq(cache->entries[i].ref->pre, pubkey, 2 * cache->no))
+			break;
+	return i;
+}
+
+static bool_t bignPreCacheIsCand(bign_pre_cache* cache, word fp)
+{
+	size_t i;
+	for (i = 0; i < BIGN_PRE_CACHE_SIZE; ++i)
+		if (cache->cands[i] == fp)
+			return TRUE;
+	// добавить кандидата
+	cache->cands[cache->cand_pos] = fp;
+	cache->cand_pos = (cache->cand_pos + 1) % BIGN_PRE_CACHE_SIZE;
+	return FALSE;
+}
+
+static void bignPreCacheRelease(bign_pre_ref* ref)
+{
+	if (ref && mtAtomicDecr(&ref->refs) == 0)
+		blobClose(ref);
+}
+
+static void bignPreCacheInsert(bign_pre_cache* cache, word fp,
+	bign_pre_ref* ref)
+{
+	size_t i, pos;
+	bign_pre_entry* entry;
+	// состояние уже добавлено другим потоком?
+	if (bignPreCacheFind(cache, fp, (const octet*)ref->pre) < 
+		BIGN_PRE_CACHE_SIZE)
+	{
+		bignPreCacheRelease(ref);
+		return;
+	}
+	// найти пустой или самый старый элемент
+	for (i = pos = 0; i < BIGN_PRE_CACHE_SIZE; ++i)
+		if (cache->entries[i].stamp < cache->entries[pos].stamp)
+			pos = i;
+	entry = cache->entries + pos;
+	// вытеснить и сохранить
+	bignPreCacheRelease(entry->ref);
+	entry->ref = ref;
+	entry->fp = fp;
+	entry->stamp = ++cache->stamp;
+}
+
+err_t bignVerifyCachedEc(bign_pre_cache* cache, const ec_o* ec,
+	const octet oid_der[], size_t oid_len, const octet hash[],
+	const octet sig[], const octet pubkey[])
+{
+	err_t code;
+	octet fp_hash[32];
+	word fp;
+	size_t pos;
+	void* pre;
+	bign_pre_ref* ref;
+	// кэш не создан?
+	if (cache == 0)
+		return bignVerifyEc(ec, oid_der, oid_len, hash, sig, pubkey);
+	// pre
+	ASSERT(ecIsOperable(ec));
+	ASSERT(cache->no == ec->f->no);
+	ASSERT(ec->pre != 0);
+	// входной контроль
+	if (!memIsValid(pubkey, 2 * cache->no))
+		return ERR_BAD_INPUT;
+	// вычислить отпечаток
+	code = beltHash(fp_hash, pubkey, 2 * cache->no);
+	ERR_CALL_CHECK(code);
+	memCopy(&fp, fp_hash, O_PER_W);
+	// найти ключ
+	mtMtxLock(cache->mtx);
+	pos = bignPreCacheFind(cache, fp, pubkey);
+	// ключ найден: проверить подпись на хранимом состоянии
+	if (pos < BIGN_PRE_CACHE_SIZE)
+	{
+		ref = cache->entries[pos].ref;
+		cache->entries[pos].stamp = ++cache->stamp;
+		mtAtomicIncr(&ref->refs);
+		mtMtxUnlock(cache->mtx);
+		code = bignVerifyPreEc(ec, oid_der, oid_len, hash, sig, ref->pre);
+		bignPreCacheRelease(ref);
+		return code;
+	}
+	// первое обращение?
+	if (!bignPreCacheIsCand(cache, fp))
+	{
+		mtMtxUnlock(cache->mtx);
+		return bignVerifyEc(ec, oid_der, oid_len, hash, sig, pubkey);
+	}
+	mtMtxUnlock(cache->mtx);
+	// повторное обращение: построить состояние
+	pre = blobCreate(bignPubkeyPre_keep(4 * cache->no));
+	if (pre == 0)
+		return bignVerifyEc(ec, oid_der, oid_len, hash, sig, pubkey);
+	if (bignPubkeyPreEc(pre, ec, pubkey) != ERR_OK)
+	{
+		blobClose(pre);
+		return bignVerifyEc(ec, oid_der, oid_len, hash, sig, pubkey);
+	}
+	code = bignVerifyPreEc(ec, oid_der, oid_len, hash, sig, pre);
+	// сохранить хранимую часть состояния (при ошибке кэш не пополняется)
+	ref = (bign_pre_ref*)blobCreate(sizeof(bign_pre_ref) + cache->keep);
+	if (ref)
+	{
+		ref->refs = 1;
+		memCopy(ref->pre, pre, cache->keep);
+		mtMtxLock(cache->mtx);
+		bignPreCacheInsert(cache, fp, ref);
+		mtMtxUnlock(cache->mtx);
+	}
+	// завершение
+	blobClose(pre);
+	return code;
+}
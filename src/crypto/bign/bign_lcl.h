@@ -4,7 +4,7 @@
 \brief STB 34.101.45 (bign): local declarations
 \project bee2 [cryptographic library]
 \created 2014.04.03
-\version 2026.03.03
+\version 2026.10.16
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
@@ -230,9 +230,24 @@ err_t bignSign2Ec(octet sig[], const ec_o* ec, const octet oid_der[],
 	size_t oid_len, const octet hash[], const octet privkey[], const void* t,
 	size_t t_len);
 
+err_t bignSignBatchEc(octet sigs[], const ec_o* ec, const octet oid_der[],
+	size_t oid_len, const octet hashes[], size_t count, 
+	const octet privkey[], gen_i rng, void* rng_state, size_t nthreads);
+
 err_t bignVerifyEc(const ec_o* ec, const octet oid_der[], size_t oid_len,
 	const octet hash[], const octet sig[], const octet pubkey[]);
 
+err_t bignVerifyBatchEc(err_t rets[], const ec_o* ec, const octet oid_der[],
+	size_t oid_len, const octet hashes[], const octet sigs[], 
+	const octet pubkeys[], size_t count, size_t nthreads);
+
+size_t bignPubkeyPreQ_keep(size_t l);
+
+err_t bignPubkeyPreEc(void* pre, const ec_o* ec, const octet pubkey[]);
+
+err_t bignVerifyPreEc(const ec_o* ec, const octet oid_der[], size_t oid_len,
+	const octet hash[], const octet sig[], const void* pre);
+
 err_t bignKeyWrapEc(octet token[], const ec_o* ec, const octet key[],
 	size_t len, const octet header[16], const octet pubkey[],
 	gen_i rng, void* rng_state);
@@ -256,6 +271,59 @@ err_t bignIdVerifyEc(const ec_o* ec, const octet oid_der[], size_t oid_len,
 	const octet id_hash[], const octet hash[], const octet id_sig[],
 	const octet id_pubkey[], const octet pubkey[]);
 
+/*
+*******************************************************************************
+Кэш предвычислений для открытых ключей
+
+Кэш хранит состояния bignPubkeyPreEc() для часто используемых открытых 
+ключей и используется функциями bign128Verify(), bign192Verify(), 
+bign256Verify().
+*******************************************************************************
+*/
+
+/*!	\brief Кэш предвычислений */
+typedef struct bign_pre_cache bign_pre_cache;
+
+/*!	\brief Создание кэша
+
+	Создается пустой кэш предвычислений для открытых ключей на кривой ec. 
+	Описание кэша возвращается по адресу *pcache.
+	\pre Указатель pcache корректен.
+	\return ERR_OK, если кэш успешно создан, и код ошибки в противном случае.
+*/
+err_t bignPreCacheCreate(
+	bign_pre_cache** pcache,	/*!< [out] кэш */
+	const ec_o* ec				/*!< [in] эллиптическая кривая */
+);
+
+/*!	\brief Закрытие кэша
+
+	Кэш cache закрывается.
+*/
+void bignPreCacheClose(
+	bign_pre_cache* cache		/*!< [in] кэш */
+);
+
+/*!	\brief Проверка ЭЦП с кэшированием предвычислений
+
+	Проверяется ЭЦП sig сообщения с хэш-значением hash на открытом ключе 
+	pubkey. Если для pubkey в кэше cache имеются предвычисления, то они 
+	используются при проверке. Иначе, при повторном обращении с ключом 
+	pubkey, предвычисления строятся и сохраняются в кэше.
+	\pre Кэш cache создан на кривой ec или cache == 0.
+	\return Результат bignVerifyEc().
+	\remark Функция может вызываться одновременно в нескольких потоках.
+*/
+err_t bignVerifyCachedEc(
+	bign_pre_cache* cache,		/*!< [in/out] кэш */
+	const ec_o* ec,				/*!< [in] эллиптическая кривая */
+	const octet oid_der[],		/*!< [in] идентификатор хэш-алгоритма */
+	size_t oid_len,				/*!< [in] длина oid_der в октетах */
+	const octet hash[],			/*!< [in] хэш-значение */
+	const octet sig[],			/*!< [in] подпись */
+	const octet pubkey[]		/*!< [in] открытый ключ */
+);
+
 #ifdef __cplusplus
 } /* extern "C" */
 #endif
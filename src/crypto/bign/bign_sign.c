@@ -4,7 +4,7 @@
 \brief STB 34.101.45 (bign): digital signature
 \project bee2 [cryptographic library]
 \created 2012.04.27
-\version 2026.02.13
+\version 2026.10.16
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
@@ -13,6 +13,7 @@
 #include "bee2/core/blob.h"
 #include "bee2/core/err.h"
 #include "bee2/core/mem.h"
+#include "bee2/core/mt.h"
 #include "bee2/core/obj.h"
 #include "bee2/core/oid.h"
 #include "bee2/core/util.h"
@@ -27,9 +28,39 @@
 /*
 *******************************************************************************
 Выработка ЭЦП
+
+Функция bignSignEc_finish() завершает выработку подписи по личному ключу d, 
+одноразовому личному ключу k и x-координате точки R = k G, которая 
+передается в виде строки октетов в буфере R. Буфер R, кроме этого, 
+используется как вспомогательный.
 *******************************************************************************
 */
 
+static void bignSignEc_finish(octet sig[], const ec_o* ec, 
+	const octet oid_der[], size_t oid_len, const octet hash[], 
+	const word d[], word k[], word R[], word s0[], word s1[], void* stack)
+{
+	const size_t no = ec->f->no, n = ec->f->n;
+	// s0 <- belt-hash(oid || R || H) mod 2^l
+	beltHashStart(stack);
+	beltHashStepH(oid_der, oid_len, stack);
+	beltHashStepH(R, no, stack);
+	beltHashStepH(hash, no, stack);
+	beltHashStepG2(sig, no / 2, stack);
+	wwFrom(s0, sig, no / 2);
+	// R <- (s0 + 2^l) d
+	zzMul(R, s0, n / 2, d, n, stack);
+	R[n + n / 2] = zzAdd(R + n / 2, R + n / 2, d, n);
+	// s1 <- R mod q
+	zzMod(s1, R, n + n / 2 + 1, ec->order, n, stack);
+	// s1 <- (k - s1 - H) mod q
+	zzSubMod(s1, k, s1, ec->order, n);
+	wwFrom(k, hash, no);
+	zzSubMod(s1, s1, k, ec->order, n);
+	// выгрузить s1
+	wwTo(sig + no / 2, no, s1);
+}
+
 err_t bignSignEc(octet sig[], const ec_o* ec, const octet oid_der[],
 	size_t oid_len, const octet hash[], const octet privkey[], gen_i rng, 
 	void* rng_state)
@@ -92,24 +123,9 @@ err_t bignSignEc(octet sig[], const ec_o* ec, const octet oid_der[],
 		return ERR_BAD_PARAMS;
 	}
 	qrTo((octet*)R, ecX(R), ec->f, stack);
-	// s0 <- belt-hash(oid || R || H) mod 2^l
-	beltHashStart(stack);
-	beltHashStepH(oid_der, oid_len, stack);
-	beltHashStepH(R, no, stack);
-	beltHashStepH(hash, no, stack);
-	beltHashStepG2(sig, no / 2, stack);
-	wwFrom(s0, sig, no / 2);
-	// R <- (s0 + 2^l) d
-	zzMul(R, s0, n / 2, d, n, stack);
-	R[n + n / 2] = zzAdd(R + n / 2, R + n / 2, d, n);
-	// s1 <- R mod q
-	zzMod(s1, R, n + n / 2 + 1, ec->order, n, stack);
-	// s1 <- (k - s1 - H) mod q
-	zzSubMod(s1, k, s1, ec->order, n);
-	wwFrom(k, hash, no);
-	zzSubMod(s1, s1, k, ec->order, n);
-	// выгрузить s1
-	wwTo(sig + no / 2, no, s1);
+	// завершить выработку подписи
+	bignSignEc_finish(sig, ec, oid_der, oid_len, hash, d, k, R, s0, s1, 
+		stack);
 	// завершение
 	blobClose(state);
 	return ERR_OK;
@@ -131,6 +147,660 @@ err_t bignSign(octet sig[], const bign_params* params, const octet oid_der[],
 	return code;
 }
 
+/*
+*******************************************************************************
+Выработка ЭЦП с пулом одноразовых ключей
+
+Пул хранит до capacity пар (k, R.x), где k -- одноразовый личный ключ, 
+R.x -- x-координата точки R = k G в виде строки октетов. Пары размещаются 
+в кольцевом буфере внутри блоба. Выбранная пара стирается из буфера под 
+защитой мьютекса, поэтому каждый ключ k используется не более одного раза.
+
+Пары вырабатываются функцией bignPoolGen(). Ключ k генерируется под 
+защитой мьютекса (генератор rng не обязан быть потокобезопасным), 
+точка R вычисляется без блокировки.
+
+Пул создает собственное описание кривой. Если для базовой точки нет 
+предвычисленных кратных, а битовая длина порядка q кратна 
+BIGN_POOL_PRE_W, то для базовой точки строится таблица по схеме SI 
+с окном ширины BIGN_POOL_PRE_W. Таблица строится за время порядка 
+20 вычислений k G и ускоряет последующие вычисления в 2-3 раза.
+
+Фоновый поток (см. bignPoolRun()) пополняет пул, пока он не заполнится, 
+затем ожидает события, связанного с условной переменной cnd. О событии 
+сообщается при выборке пары из заполненного пула и при закрытии пула. 
+Поток завершается при закрытии пула или при ошибке. Код ошибки 
+сохраняется в поле code и возвращается функцией bignSignPool(), когда 
+пул опустеет.
+
+Если пул пуст, а фоновый поток не завершился с ошибкой, то bignSignPool() 
+вырабатывает пару самостоятельно. Такие обращения подсчитываются в поле 
+misses (см. bignPoolMisses()).
+*******************************************************************************
+*/
+
+#define BIGN_POOL_PRE_W 8
+
+struct bign_pool_st
+{
+	mt_mtx_t mtx[1];		/*< мьютекс */
+	mt_cnd_t cnd[1];		/*< условная переменная (если running) */
+	mt_thrd_t thrd;			/*< фоновый поток */
+	bool_t running;			/*< фоновый поток запущен? */
+	bool_t stop;			/*< остановить фоновый поток? */
+	err_t code;				/*< код ошибки фонового потока */
+	size_t misses;			/*< число выборок из пустого пула */
+	ec_o* ec;				/*< описание кривой */
+	gen_i rng;				/*< генератор */
+	void* rng_state;		/*< состояние генератора */
+	size_t capacity;		/*< емкость пула */
+	size_t head;			/*< позиция первой пары */
+	size_t count;			/*< число пар */
+	octet* pairs;			/*< [capacity][2 * no] пары (k, R.x) */
+};
+
+#define bignPoolGen_local(n)\
+/* k */		O_OF_W(n),\
+/* R */		O_OF_W(2 * n)
+
+static err_t bignPoolGen(bign_pool_t pool, octet pair[], void* stack)
+{
+	const ec_o* ec = pool->ec;
+	const size_t no = ec->f->no, n = ec->f->n;
+	bool_t ok;
+	word* k;			/* [n] одноразовый личный ключ */
+	word* R;			/* [2 * n] точка R */
+	// разметить стек
+	memSlice(stack,
+		bignPoolGen_local(n), SIZE_0, SIZE_MAX,
+		&k, &R, &stack);
+	// сгенерировать k
+	mtMtxLock(pool->mtx);
+	ok = zzRandNZMod(k, ec->order, n, pool->rng, pool->rng_state);
+	mtMtxUnlock(pool->mtx);
+	if (!ok)
+		return ERR_BAD_RNG;
+	// R <- k G
+	if (!bignMulBase(R, ec, k, stack))
+		return ERR_BAD_PARAMS;
+	// pair <- (k, R.x)
+	wwTo(pair, no, k);
+	qrTo(pair + no, ecX(R), ec->f, stack);
+	return ERR_OK;
+}
+
+static size_t bignPoolGen_deep(size_t n, size_t f_deep, size_t ec_deep)
+{
+	return memSliceSize(
+		bignPoolGen_local(n),
+		utilMax(2,
+			f_deep,
+			bignMulBase_deep(n, f_deep, ec_deep)),
+		SIZE_MAX);
+}
+
+static void bignPoolPush(bign_pool_t pool, octet pair[])
+{
+	const size_t no = pool->ec->f->no;
+	mtMtxLock(pool->mtx);
+	if (pool->count < pool->capacity)
+	{
+		memCopy(pool->pairs + 2 * no * 
+			((pool->head + pool->count) % pool->capacity), pair, 2 * no);
+		++pool->count;
+	}
+	mtMtxUnlock(pool->mtx);
+	memWipe(pair, 2 * no);
+}
+
+static bool_t bignPoolPop(bign_pool_t pool, octet pair[], err_t* code)
+{
+	const size_t no = pool->ec->f->no;
+	bool_t ret = FALSE;
+	mtMtxLock(pool->mtx);
+	*code = pool->code;
+	if (pool->count)
+	{
+		memCopy(pair, pool->pairs + 2 * no * pool->head, 2 * no);
+		memWipe(pool->pairs + 2 * no * pool->head, 2 * no);
+		// разбудить фоновый поток
+		if (pool->running && pool->count == pool->capacity)
+			mtCndSignal(pool->cnd);
+		pool->head = (pool->head + 1) % pool->capacity;
+		--pool->count;
+		ret = TRUE;
+	}
+	else if (*code == ERR_OK)
+		++pool->misses;
+	mtMtxUnlock(pool->mtx);
+	return ret;
+}
+
+static void bignPoolThrd(void* arg)
+{
+	bign_pool_t pool = (bign_pool_t)arg;
+	const ec_o* ec = pool->ec;
+	err_t code = ERR_OK;
+	void* state;
+	octet* pair;		/* [2 * no] пара (k, R.x) */
+	void* stack;
+	// создать состояние
+	state = blobCreate2(
+		2 * ec->f->no,
+		bignPoolGen_deep(ec->f->n, ec->f->deep, ec->deep),
+		SIZE_MAX,
+		&pair, &stack);
+	mtMtxLock(pool->mtx);
+	if (state == 0)
+		pool->code = ERR_OUTOFMEMORY;
+	// пополнять пул
+	else while (!pool->stop)
+	{
+		if (pool->count == pool->capacity)
+		{
+			mtCndWait(pool->cnd, pool->mtx);
+			continue;
+		}
+		mtMtxUnlock(pool->mtx);
+		code = bignPoolGen(pool, pair, stack);
+		if (code == ERR_OK)
+			bignPoolPush(pool, pair);
+		mtMtxLock(pool->mtx);
+		if (code != ERR_OK)
+		{
+			pool->code = code;
+			break;
+		}
+	}
+	mtMtxUnlock(pool->mtx);
+	// завершение
+	blobClose(state);
+}
+
+err_t bignPoolCreate(bign_pool_t* ppool, const bign_params* params, 
+	size_t capacity, gen_i rng, void* rng_state)
+{
+	err_t code;
+	size_t no, n, mb, h, pre_size;
+	ec_o* ec;
+	bign_pool_t pool;
+	octet* pairs;
+	ec_pre_t* pre;
+	void* stack;
+	// входной контроль
+	if (!memIsValid(ppool, sizeof(bign_pool_t)))
+		return ERR_BAD_INPUT;
+	if (rng == 0)
+		return ERR_BAD_RNG;
+	// создать кривую
+	code = bignParamsCheck(params);
+	ERR_CALL_CHECK(code);
+	code = bignEcCreate(&ec, params);
+	ERR_CALL_CHECK(code);
+	// размерности
+	no = ec->f->no, n = ec->f->n;
+	if (capacity == 0 || capacity > SIZE_MAX / 4 / no)
+	{
+		bignEcClose(ec);
+		return ERR_BAD_INPUT;
+	}
+	// строить таблицу?
+	mb = wwBitSize(ec->order, n + 1);
+	h = mb / BIGN_POOL_PRE_W;
+	pre_size = 0;
+	if (ec->pre == 0 && mb % BIGN_POOL_PRE_W == 0)
+		pre_size = sizeof(ec_pre_t) + 
+			O_OF_W(SIZE_BIT_POS(BIGN_POOL_PRE_W - 1) * 2 * n);
+	// создать пул
+	pool = (bign_pool_t)blobCreate2(
+		sizeof(struct bign_pool_st),
+		2 * no * capacity,
+		pre_size,
+		SIZE_MAX,
+		&pool, &pairs, &pre);
+	if (pool == 0)
+	{
+		bignEcClose(ec);
+		return ERR_OUTOFMEMORY;
+	}
+	if (!mtMtxCreate(pool->mtx))
+	{
+		blobClose(pool);
+		bignEcClose(ec);
+		return ERR_SYS;
+	}
+	pool->ec = ec, pool->pairs = pairs;
+	pool->rng = rng, pool->rng_state = rng_state;
+	pool->capacity = capacity;
+	// построить таблицу (при ошибке таблица не используется)
+	if (pre_size)
+	{
+		stack = blobCreate(ecPreSI_deep(n, ec->d, ec->deep, h));
+		if (stack && ecPreSI(pre, ec->base, BIGN_POOL_PRE_W, h, ec, stack))
+			ec->pre = pre;
+		blobClose(stack);
+	}
+	*ppool = pool;
+	return ERR_OK;
+}
+
+err_t bignPoolFill(bign_pool_t pool, size_t count)
+{
+	err_t code = ERR_OK;
+	void* state;
+	octet* pair;		/* [2 * no] пара (k, R.x) */
+	void* stack;
+	// входной контроль
+	if (!memIsValid(pool, sizeof(struct bign_pool_st)))
+		return ERR_BAD_INPUT;
+	// создать состояние
+	state = blobCreate2(
+		2 * pool->ec->f->no,
+		bignPoolGen_deep(pool->ec->f->n, pool->ec->f->deep, pool->ec->deep),
+		SIZE_MAX,
+		&pair, &stack);
+	if (state == 0)
+		return ERR_OUTOFMEMORY;
+	// пополнить пул
+	for (; count && bignPoolCount(pool) < pool->capacity; --count)
+	{
+		code = bignPoolGen(pool, pair, stack);
+		if (code != ERR_OK)
+			break;
+		bignPoolPush(pool, pair);
+	}
+	// завершение
+	blobClose(state);
+	return code;
+}
+
+err_t bignPoolRun(bign_pool_t pool)
+{
+	err_t code = ERR_OK;
+	// входной контроль
+	if (!memIsValid(pool, sizeof(struct bign_pool_st)))
+		return ERR_BAD_INPUT;
+	mtMtxLock(pool->mtx);
+	// фоновый поток завершился с ошибкой? дождаться его завершения
+	if (pool->running && pool->code != ERR_OK)
+	{
+		mtThrdJoin(&pool->thrd);
+		mtCndClose(pool->cnd);
+		pool->running = FALSE, pool->code = ERR_OK;
+	}
+	// запустить поток
+	if (!pool->running)
+	{
+		if (!mtCndCreate(pool->cnd))
+			code = ERR_SYS;
+		else if (!mtThrdCreate(&pool->thrd, bignPoolThrd, pool))
+		{
+			mtCndClose(pool->cnd);
+			code = ERR_SYS;
+		}
+		else
+			pool->running = TRUE;
+	}
+	mtMtxUnlock(pool->mtx);
+	return code;
+}
+
+size_t bignPoolCount(bign_pool_t pool)
+{
+	size_t count;
+	ASSERT(memIsValid(pool, sizeof(struct bign_pool_st)));
+	mtMtxLock(pool->mtx);
+	count = pool->count;
+	mtMtxUnlock(pool->mtx);
+	return count;
+}
+
+size_t bignPoolMisses(bign_pool_t pool)
+{
+	size_t misses;
+	ASSERT(memIsValid(pool, sizeof(struct bign_pool_st)));
+	mtMtxLock(pool->mtx);
+	misses = pool->misses;
+	mtMtxUnlock(pool->mtx);
+	return misses;
+}
+
+void bignPoolClose(bign_pool_t pool)
+{
+	ec_o* ec;
+	if (pool == 0)
+		return;
+	ASSERT(memIsValid(pool, sizeof(struct bign_pool_st)));
+	// остановить поток
+	mtMtxLock(pool->mtx);
+	pool->stop = TRUE;
+	if (pool->running)
+		mtCndSignal(pool->cnd);
+	mtMtxUnlock(pool->mtx);
+	if (pool->running)
+	{
+		mtThrdJoin(&pool->thrd);
+		mtCndClose(pool->cnd);
+	}
+	// закрыть пул (пары стираются)
+	mtMtxClose(pool->mtx);
+	ec = pool->ec;
+	blobClose(pool);
+	bignEcClose(ec);
+}
+
+err_t bignSignPool(octet sig[], bign_pool_t pool, const octet oid_der[],
+	size_t oid_len, const octet hash[], const octet privkey[])
+{
+	err_t code;
+	const ec_o* ec;
+	size_t no, n;
+	void* state;
+	word* d;				/* [n] личный ключ */
+	word* k;				/* [n] одноразовый личный ключ */
+	word* R;				/* [2 * n] точка R */
+	word* s0;				/* [n/2] первая часть подписи */
+	word* s1;				/* [n] вторая часть подписи (|d) */
+	octet* pair;			/* [2 * no] пара (k, R.x) */
+	void* stack;
+	// входной контроль
+	if (!memIsValid(pool, sizeof(struct bign_pool_st)))
+		return ERR_BAD_INPUT;
+	// размерности
+	ec = pool->ec;
+	no = ec->f->no, n = ec->f->n;
+	ASSERT(n % 2 == 0);
+	// входной контроль
+	if (!memIsValid(hash, no) || !memIsValid(privkey, no) ||
+		!memIsValid(sig, no + no / 2) ||
+		!memIsDisjoint2(hash, no, sig, no + no / 2))
+		return ERR_BAD_INPUT;
+	if (oid_len == SIZE_MAX || oidFromDER(0, oid_der, oid_len) == SIZE_MAX)
+		return ERR_BAD_OID;
+	// создать состояние
+	state = blobCreate2(
+		O_OF_W(n),
+		O_OF_W(n) | SIZE_HI,
+		O_OF_W(n),
+		O_OF_W(2 * n),
+		O_OF_W(n / 2),
+		2 * no,
+		utilMax(4,
+			beltHash_keep(),
+			bignPoolGen_deep(n, ec->f->deep, ec->deep),
+			zzMul_deep(n / 2, n),
+			zzMod_deep(n + n / 2 + 1, n)),
+		SIZE_MAX,
+		&d, &s1, &k, &R, &s0, &pair, &stack);
+	if (state == 0)
+		return ERR_OUTOFMEMORY;
+	// загрузить d
+	wwFrom(d, privkey, no);
+	if (wwIsZero(d, n) || wwCmp(d, ec->order, n) >= 0)
+	{
+		blobClose(state);
+		return ERR_BAD_PRIVKEY;
+	}
+	// выбрать пару (k, R.x) или, если пул пуст, выработать ее
+	if (!bignPoolPop(pool, pair, &code))
+	{
+		if (code == ERR_OK)
+			code = bignPoolGen(pool, pair, stack);
+		ERR_CALL_HANDLE(code, blobClose(state));
+	}
+	wwFrom(k, pair, no);
+	memCopy(R, pair + no, no);
+	// завершить выработку подписи
+	bignSignEc_finish(sig, ec, oid_der, oid_len, hash, d, k, R, s0, s1, 
+		stack);
+	// завершение
+	blobClose(state);
+	return ERR_OK;
+}
+
+/*
+*******************************************************************************
+Пакетная выработка ЭЦП
+
+Пакет подписей вырабатывается на одном личном ключе. Параметры, 
+идентификатор хэш-алгоритма и личный ключ контролируются один раз, 
+память выделяется один раз для всего пакета.
+
+Одноразовые личные ключи генерируются в вызывающем потоке по порядку 
+следования подписей порциями по BIGN_SIGN_PORTION ключей. Поэтому 
+генератор rng не обязан быть потокобезопасным, а подписи совпадают 
+с подписями, которые выработали бы count последовательных обращений 
+к bignSignEc() с тем же генератором. Кратные k G и остальные вычисления 
+для подписей порции распределяются между потоками. Каждый поток 
+обрабатывает не менее BIGN_SIGN_MT_MIN подписей на собственном стеке.
+
+Если ec->pre == 0, а пакет содержит не менее BIGN_SIGN_PRE_MIN подписей, 
+то для пакета один раз строится таблица предвычисленных кратных G 
+по схеме SI с окном ширины BIGN_SIGN_PRE_W (см. bignVerifyBatchEc()).
+*******************************************************************************
+*/
+
+#define BIGN_SIGN_PORTION 1024
+#define BIGN_SIGN_PRE_MIN 64
+#define BIGN_SIGN_PRE_W 8
+#define BIGN_SIGN_MT_MIN 4
+
+typedef struct
+{
+	const ec_o* ec;			/*< описание кривой */
+	const ec_pre_t* pre;	/*< предвычисленные кратные G (или 0) */
+	const octet* oid_der;	/*< идентификатор хэш-алгоритма */
+	size_t oid_len;			/*< длина oid_der */
+	const word* d;			/*< личный ключ */
+	word* ks;				/*< одноразовые личные ключи */
+	const octet* hashes;	/*< хэш-значения */
+	octet* sigs;			/*< подписи */
+	size_t count;			/*< число подписей */
+	bool_t ok;				/*< подписи выработаны? */
+	void* stack;			/*< стек */
+	mt_thrd_t thrd;			/*< поток */
+	bool_t created;			/*< поток создан? */
+} bign_sign_job;
+
+#define bignSignBatchJob_local(n)\
+/* R */		O_OF_W(2 * n),\
+/* s0 */	O_OF_W(n / 2),\
+/* s1 */	O_OF_W(n)
+
+static void bignSignBatchJob(void* arg)
+{
+	bign_sign_job* job = (bign_sign_job*)arg;
+	const ec_o* ec = job->ec;
+	const size_t no = ec->f->no, n = ec->f->n;
+	size_t i;
+	word* k;			/* [n] одноразовый личный ключ */
+	word* R;			/* [2 * n] точка R */
+	word* s0;			/* [n/2] первая часть подписи */
+	word* s1;			/* [n] вторая часть подписи */
+	void* stack;
+	// разметить стек
+	memSlice(job->stack,
+		bignSignBatchJob_local(n), SIZE_0, SIZE_MAX,
+		&R, &s0, &s1, &stack);
+	// обработать подписи
+	for (i = 0, job->ok = TRUE; i < job->count; ++i)
+	{
+		k = job->ks + n * i;
+		// R <- k G
+		if (job->pre)
+			job->ok = ecMulPreSI(R, job->pre, ec, k, n, stack);
+		else
+			job->ok = bignMulBase(R, ec, k, stack);
+		if (!job->ok)
+			break;
+		qrTo((octet*)R, ecX(R), ec->f, stack);
+		// завершить выработку подписи
+		bignSignEc_finish(job->sigs + (no + no / 2) * i, ec, job->oid_der,
+			job->oid_len, job->hashes + no * i, job->d, k, R, s0, s1, 
+			stack);
+	}
+}
+
+static size_t bignSignBatchJob_deep(size_t n, size_t f_deep, size_t ec_d,
+	size_t ec_deep)
+{
+	return memSliceSize(
+		bignSignBatchJob_local(n),
+		utilMax(6,
+			f_deep,
+			beltHash_keep(),
+			bignMulBase_deep(n, f_deep, ec_deep),
+			ecMulPreSI_deep(n, ec_d, ec_deep, n),
+			zzMul_deep(n / 2, n),
+			zzMod_deep(n + n / 2 + 1, n)),
+		SIZE_MAX);
+}
+
+err_t bignSignBatchEc(octet sigs[], const ec_o* ec, const octet oid_der[],
+	size_t oid_len, const octet hashes[], size_t count, 
+	const octet privkey[], gen_i rng, void* rng_state, size_t nthreads)
+{
+	err_t code = ERR_OK;
+	size_t no, n;
+	size_t mb, h, pre_size;
+	size_t portion, keep, k, kk, pos, m, i, j;
+	void* state;
+	bign_sign_job* jobs;		/* [k] задания */
+	word* d;					/* [n] личный ключ */
+	word* ks;					/* [n * portion] одноразовые личные ключи */
+	octet* stacks;				/* [k * keep] стеки */
+	ec_pre_t* pre;				/* [pre_size] таблица кратных G */
+	const ec_pre_t* base_pre;	/* предвычисленные кратные G (или 0) */
+	// pre
+	ASSERT(ecIsOperable(ec));
+	// размерности
+	no = ec->f->no, n = ec->f->n;
+	ASSERT(n % 2 == 0);
+	// входной контроль
+	if (count == 0 || nthreads == 0 || 
+		count > SIZE_MAX / (no + no / 2) ||
+		!memIsValid(hashes, no * count) || 
+		!memIsValid(sigs, (no + no / 2) * count) ||
+		!memIsValid(privkey, no) ||
+		!memIsDisjoint2(sigs, (no + no / 2) * count, hashes, no * count) ||
+		!memIsDisjoint2(sigs, (no + no / 2) * count, privkey, no))
+		return ERR_BAD_INPUT;
+	if (oid_len == SIZE_MAX || oidFromDER(0, oid_der, oid_len) == SIZE_MAX)
+		return ERR_BAD_OID;
+	if (rng == 0)
+		return ERR_BAD_RNG;
+	// определить размер порции и число заданий
+	portion = MIN2(count, BIGN_SIGN_PORTION);
+	k = portion / BIGN_SIGN_MT_MIN;
+	if (k > nthreads)
+		k = nthreads;
+	if (k == 0)
+		k = 1;
+	// строить таблицу?
+	mb = wwBitSize(ec->order, n + 1);
+	h = mb / BIGN_SIGN_PRE_W;
+	pre_size = 0;
+	if (ec->pre == 0 && count >= BIGN_SIGN_PRE_MIN && 
+		mb % BIGN_SIGN_PRE_W == 0)
+		pre_size = sizeof(ec_pre_t) + 
+			O_OF_W(SIZE_BIT_POS(BIGN_SIGN_PRE_W - 1) * 2 * n);
+	// создать состояние
+	keep = bignSignBatchJob_deep(n, ec->f->deep, ec->d, ec->deep);
+	if (pre_size)
+		keep = utilMax(2, keep, 
+			memSliceSize(ecPreSI_deep(n, ec->d, ec->deep, h), SIZE_0, 
+				SIZE_MAX));
+	state = blobCreate2(
+		sizeof(bign_sign_job) * k,
+		O_OF_W(n),
+		O_OF_W(n * portion),
+		keep * k,
+		pre_size,
+		SIZE_MAX,
+		&jobs, &d, &ks, &stacks, &pre);
+	if (state == 0)
+		return ERR_OUTOFMEMORY;
+	// загрузить d
+	wwFrom(d, privkey, no);
+	if (wwIsZero(d, n) || wwCmp(d, ec->order, n) >= 0)
+	{
+		blobClose(state);
+		return ERR_BAD_PRIVKEY;
+	}
+	// построить таблицу
+	base_pre = 0;
+	if (pre_size && 
+		ecPreSI(pre, ec->base, BIGN_SIGN_PRE_W, h, ec, stacks))
+		base_pre = pre;
+	// обработать порции
+	for (pos = 0; code == ERR_OK && pos < count; pos += m)
+	{
+		m = MIN2(count - pos, portion);
+		// сгенерировать одноразовые ключи
+		for (i = 0; i < m; ++i)
+			if (!zzRandNZMod(ks + n * i, ec->order, n, rng, rng_state))
+				break;
+		if (i < m)
+		{
+			code = ERR_BAD_RNG;
+			break;
+		}
+		// подготовить задания
+		kk = MIN2(k, m / BIGN_SIGN_MT_MIN);
+		if (kk == 0)
+			kk = 1;
+		for (i = j = 0; i < kk; ++i)
+		{
+			jobs[i].ec = ec, jobs[i].pre = base_pre;
+			jobs[i].oid_der = oid_der, jobs[i].oid_len = oid_len;
+			jobs[i].d = d;
+			jobs[i].count = m / kk + (i < m % kk);
+			jobs[i].ks = ks + n * j;
+			jobs[i].hashes = hashes + no * (pos + j);
+			jobs[i].sigs = sigs + (no + no / 2) * (pos + j);
+			jobs[i].stack = stacks + keep * i;
+			j += jobs[i].count;
+		}
+		ASSERT(j == m);
+		// запустить потоки
+		for (i = 1; i < kk; ++i)
+			jobs[i].created = 
+				mtThrdCreate(&jobs[i].thrd, bignSignBatchJob, jobs + i);
+		// обработать первый фрагмент
+		bignSignBatchJob(jobs);
+		// дождаться завершения потоков
+		for (i = 1; i < kk; ++i)
+			if (jobs[i].created)
+				mtThrdJoin(&jobs[i].thrd);
+			else
+				bignSignBatchJob(jobs + i);
+		// проверить результаты
+		for (i = 0; i < kk; ++i)
+			if (!jobs[i].ok)
+				code = ERR_BAD_PARAMS;
+	}
+	// завершение
+	blobClose(state);
+	return code;
+}
+
+err_t bignSignBatch(octet sigs[], const bign_params* params, 
+	const octet oid_der[], size_t oid_len, const octet hashes[], 
+	size_t count, const octet privkey[], gen_i rng, void* rng_state, 
+	size_t nthreads)
+{
+	err_t code;
+	ec_o* ec;
+	code = bignParamsCheck(params);
+	ERR_CALL_CHECK(code);
+	code = bignEcCreate(&ec, params);
+	ERR_CALL_CHECK(code);
+	code = bignSignBatchEc(sigs, ec, oid_der, oid_len, hashes, count, 
+		privkey, rng, rng_state, nthreads);
+	bignEcClose(ec);
+	return code;
+}
+
 /*
 *******************************************************************************
 Детерминированная выработка ЭЦП
@@ -262,60 +932,60 @@ err_t bignSign2(octet sig[], const bign_params* params, const octet oid_der[],
 /*
 *******************************************************************************
 Проверка ЭЦП
+
+При проверке вычисляется точка R = s1 G + (s0 + 2^l) Q, где s1 < q 
+и s0 < 2^l. Если для базовой точки G имеются предвычисленные кратные pre 
+(ec->pre или таблица, построенная при пакетной проверке), то слагаемые 
+определяются по отдельности: s1 G -- с помощью pre, (s0 + 2^l) Q -- 
+функцией ecMulA() с кратностью половинной длины или, если для Q имеются 
+предвычисленные кратные qpre (см. bignPubkeyPreEc()), функцией 
+ecMulPreSI(). Иначе R определяется функцией ecAddMulA(), а qpre 
+не используется: раздельное вычисление s1 G без таблицы для G медленнее 
+совместного.
+
+Функция bignVerifyEc_internal() проверяет подпись, используя 
+зарезервированный стек. Входные данные не контролируются.
 *******************************************************************************
 */
 
-err_t bignVerifyEc(const ec_o* ec, const octet oid_der[], size_t oid_len,
-	const octet hash[], const octet sig[], const octet pubkey[])
+#define bignVerifyEc_local(n, ec_d)\
+/* Q */		O_OF_W(2 * n),\
+/* R */		O_OF_W(2 * n),\
+/* V */		O_OF_W(ec_d * n),\
+/* H */		O_OF_W(n),\
+/* s0 */	O_OF_W(n),\
+/* s1 */	O_OF_W(n)
+
+static err_t bignVerifyEc_internal(const ec_o* ec, const ec_pre_t* pre,
+	const ec_pre_t* qpre, const octet oid_der[], size_t oid_len, 
+	const octet hash[], const octet sig[], const octet pubkey[], void* stack)
 {
-	err_t code;
 	size_t no, n;
-	void* state;
 	word* Q;			/* [2 * n] открытый ключ */
-	word* R;			/* [2 * n] точка R (|Q) */
+	word* R;			/* [2 * n] точка R */
+	word* V;			/* [ec->d * n] проективная точка R */
 	word* H;			/* [n] хэш-значение */
-	word* s0;			/* [n / 2 + 1] первая часть подписи (|H) */
+	word* s0;			/* [n] первая часть подписи */
 	word* s1;			/* [n] вторая часть подписи */
-	void* stack;
+	bool_t o1, o2;
 	// pre
 	ASSERT(ecIsOperable(ec));
+	ASSERT(pre == 0 || pre == ec->pre || pre->type == ec_pre_si);
+	ASSERT(qpre == 0 || qpre->type == ec_pre_si);
 	// размерности
 	no = ec->f->no, n = ec->f->n;
-	ASSERT(n % 2 == 0);
-	// входной контроль
-	if (!memIsValid(hash, no) || !memIsValid(sig, no + no / 2) ||
-		!memIsValid(pubkey, 2 * no))
-		return ERR_BAD_INPUT;
-	if (oid_len == SIZE_MAX || oidFromDER(0, oid_der, oid_len) == SIZE_MAX)
-		return ERR_BAD_OID;
-	// создать состояние
-	state = blobCreate2(
-		O_OF_W(2 * n),
-		O_OF_W(2 * n) | SIZE_HI,
-		O_OF_W(n),
-		O_OF_W(n / 2 + 1) | SIZE_HI,
-		O_OF_W(n),
-		utilMax(2,
-			beltHash_keep(),
-			ecAddMulA_deep(n, ec->d, ec->deep, 2, n, n / 2 + 1)),
-		SIZE_MAX,
-		&Q, &R, &H, &s0, &s1, &stack);
-	if (state == 0)
-		return ERR_OUTOFMEMORY;
+	// разметить стек
+	memSlice(stack,
+		bignVerifyEc_local(n, ec->d), SIZE_0, SIZE_MAX,
+		&Q, &R, &V, &H, &s0, &s1, &stack);
 	// загрузить Q
 	if (!qrFrom(ecX(Q), pubkey, ec->f, stack) ||
 		!qrFrom(ecY(Q, n), pubkey + no, ec->f, stack))
-	{
-		blobClose(state);
 		return ERR_BAD_PUBKEY;
-	}
 	// загрузить и проверить s1
 	wwFrom(s1, sig + no / 2, no);
 	if (wwCmp(s1, ec->order, n) >= 0)
-	{
-		blobClose(state);
 		return ERR_BAD_SIG;
-	}
 	// s1 <- (s1 + H) mod q
 	wwFrom(H, hash, no);
 	if (wwCmp(H, ec->order, n) >= 0)
@@ -328,11 +998,35 @@ err_t bignVerifyEc(const ec_o* ec, const octet oid_der[], size_t oid_len,
 	// загрузить s0
 	wwFrom(s0, sig, no / 2);
 	s0[n / 2] = 1;
+	wwSetZero(s0 + n / 2 + 1, n / 2 - 1);
 	// R <- s1 G + (s0 + 2^l) Q
-	if (!ecAddMulA(R, ec, stack, 2, ec->base, s1, n, Q, s0, n / 2 + 1))
+	if (pre == 0)
 	{
-		blobClose(state);
-		return ERR_BAD_SIG;
+		if (!ecAddMulA(R, ec, stack, 2, ec->base, s1, n, Q, s0, n / 2 + 1))
+			return ERR_BAD_SIG;
+	}
+	else
+	{
+		// R <- s1 G (o1: R == O?)
+		o1 = wwIsZero(s1, n) || !(pre == ec->pre ?
+			bignMulBase(R, ec, s1, stack) :
+			ecMulPreSI(R, pre, ec, s1, n, stack));
+		// Q <- (s0 + 2^l) Q (o2: Q == O?)
+		o2 = !(qpre == 0 ?
+			ecMulA(Q, Q, ec, s0, n / 2 + 1, stack) :
+			ecMulPreSI(Q, qpre, ec, s0, n, stack));
+		// R <- R + Q
+		if (o1 && o2)
+			return ERR_BAD_SIG;
+		else if (o1)
+			wwCopy(R, Q, 2 * n);
+		else if (!o2)
+		{
+			ecFromA(V, R, ec, stack);
+			ecAddA(V, V, Q, ec, stack);
+			if (!ecToA(R, V, ec, stack))
+				return ERR_BAD_SIG;
+		}
 	}
 	qrTo((octet*)R, ecX(R), ec->f, stack);
 	// s0 == belt-hash(oid || R || H) mod 2^l?
@@ -340,9 +1034,51 @@ err_t bignVerifyEc(const ec_o* ec, const octet oid_der[], size_t oid_len,
 	beltHashStepH(oid_der, oid_len, stack);
 	beltHashStepH(R, no, stack);
 	beltHashStepH(hash, no, stack);
-	code = beltHashStepV2(sig, no / 2, stack) ? ERR_OK : ERR_BAD_SIG;
+	return beltHashStepV2(sig, no / 2, stack) ? ERR_OK : ERR_BAD_SIG;
+}
+
+static size_t bignVerifyEc_deep(size_t n, size_t f_deep, size_t ec_d, 
+	size_t ec_deep)
+{
+	return memSliceSize(
+		bignVerifyEc_local(n, ec_d),
+		utilMax(6,
+			ec_deep,
+			beltHash_keep(),
+			ecAddMulA_deep(n, ec_d, ec_deep, 2, n, n / 2 + 1),
+			bignMulBase_deep(n, f_deep, ec_deep),
+			ecMulPreSI_deep(n, ec_d, ec_deep, n),
+			ecMulA_deep(n, ec_d, ec_deep, n / 2 + 1)),
+		SIZE_0,
+		SIZE_MAX);
+}
+
+err_t bignVerifyEc(const ec_o* ec, const octet oid_der[], size_t oid_len,
+	const octet hash[], const octet sig[], const octet pubkey[])
+{
+	err_t code;
+	size_t no, n;
+	void* stack;
+	// pre
+	ASSERT(ecIsOperable(ec));
+	// размерности
+	no = ec->f->no, n = ec->f->n;
+	ASSERT(n % 2 == 0);
+	// входной контроль
+	if (!memIsValid(hash, no) || !memIsValid(sig, no + no / 2) ||
+		!memIsValid(pubkey, 2 * no))
+		return ERR_BAD_INPUT;
+	if (oid_len == SIZE_MAX || oidFromDER(0, oid_der, oid_len) == SIZE_MAX)
+		return ERR_BAD_OID;
+	// создать стек
+	stack = blobCreate(bignVerifyEc_deep(n, ec->f->deep, ec->d, ec->deep));
+	if (stack == 0)
+		return ERR_OUTOFMEMORY;
+	// проверить подпись
+	code = bignVerifyEc_internal(ec, ec->pre, 0, oid_der, oid_len, hash, 
+		sig, pubkey, stack);
 	// завершение
-	blobClose(state);
+	blobClose(stack);
 	return code;
 }
 
@@ -359,3 +1095,348 @@ err_t bignVerify(const bign_params* params, const octet oid_der[],
 	bignEcClose(ec);
 	return code;
 }
+
+/*
+*******************************************************************************
+Проверка ЭЦП с предвычислениями для открытого ключа
+
+Состояние bignPubkeyPreEc() содержит открытый ключ Q (первые 2 no октетов), 
+предвычисленные кратные Q и предвычисленные кратные базовой точки G. 
+Кратные рассчитываются по схеме SI с окном ширины BIGN_PUBKEY_PRE_W. 
+При ширине 6 кратная (s0 + 2^l) Q определяется примерно на 40% быстрее, 
+чем функцией ecMulA(), а таблица занимает 2^5 аффинных точек и строится 
+за время порядка 6 таких умножений. При большей ширине ускорение 
+незначительно, а время построения и размер таблицы растут вдвое 
+с каждым битом ширины.
+
+Раздельное вычисление s1 G и (s0 + 2^l) Q выгодно, только если для G 
+также имеются предвычисленные кратные (см. bignVerifyEc_internal()). 
+Если кратные G входят в описание кривой (ec->pre), то используются они, 
+а таблица для G в состоянии не строится. Так происходит при 
+кэшировании состояний в реализациях bignXXXVerify(): кэш хранит только 
+первые bignPubkeyPreQ_keep() октетов состояний. Иначе (в частности, 
+в bignPubkeyPre()) в состоянии строится таблица для G.
+*******************************************************************************
+*/
+
+#define BIGN_PUBKEY_PRE_W 6
+
+static size_t bignPubkeyPreH(const ec_o* ec)
+{
+	const size_t mb = wwBitSize(ec->order, ec->f->n + 1);
+	return (mb + BIGN_PUBKEY_PRE_W - 1) / BIGN_PUBKEY_PRE_W;
+}
+
+size_t bignPubkeyPreQ_keep(size_t l)
+{
+	const size_t no = l / 4;
+	return 2 * no + sizeof(ec_pre_t) + 
+		O_OF_W(SIZE_BIT_POS(BIGN_PUBKEY_PRE_W - 1) * 2 * W_OF_O(no));
+}
+
+size_t bignPubkeyPre_keep(size_t l)
+{
+	const size_t no = l / 4;
+	return bignPubkeyPreQ_keep(l) + sizeof(ec_pre_t) + 
+		O_OF_W(SIZE_BIT_POS(BIGN_PUBKEY_PRE_W - 1) * 2 * W_OF_O(no));
+}
+
+err_t bignPubkeyPreEc(void* pre, const ec_o* ec, const octet pubkey[])
+{
+	err_t code;
+	size_t no, n;
+	void* state;
+	word* Q;			/* [2 * n] открытый ключ */
+	void* stack;
+	// pre
+	ASSERT(ecIsOperable(ec));
+	// размерности
+	no = ec->f->no, n = ec->f->n;
+	// входной контроль
+	if (!memIsValid(pre, bignPubkeyPre_keep(4 * no)) ||
+		!memIsValid(pubkey, 2 * no))
+		return ERR_BAD_INPUT;
+	// проверить ключ
+	code = bignPubkeyValEc(ec, pubkey);
+	ERR_CALL_CHECK(code);
+	// создать состояние
+	state = blobCreate2(
+		O_OF_W(2 * n),
+		utilMax(2,
+			ec->deep,
+			ecPreSI_deep(n, ec->d, ec->deep, bignPubkeyPreH(ec))),
+		SIZE_MAX,
+		&Q, &stack);
+	if (state == 0)
+		return ERR_OUTOFMEMORY;
+	// загрузить Q и построить таблицу для Q
+	if (!qrFrom(ecX(Q), pubkey, ec->f, stack) ||
+		!qrFrom(ecY(Q, n), pubkey + no, ec->f, stack) ||
+		!ecPreSI((ec_pre_t*)((octet*)pre + 2 * no), Q, BIGN_PUBKEY_PRE_W, 
+			bignPubkeyPreH(ec), ec, stack))
+		code = ERR_BAD_PUBKEY;
+	// построить таблицу для G
+	else if (ec->pre == 0 &&
+		!ecPreSI((ec_pre_t*)((octet*)pre + bignPubkeyPreQ_keep(4 * no)), 
+			ec->base, BIGN_PUBKEY_PRE_W, bignPubkeyPreH(ec), ec, stack))
+		code = ERR_BAD_PARAMS;
+	else
+		memCopy(pre, pubkey, 2 * no);
+	// завершение
+	blobClose(state);
+	return code;
+}
+
+err_t bignPubkeyPre(void* pre, const bign_params* params, 
+	const octet pubkey[])
+{
+	err_t code;
+	ec_o* ec;
+	code = bignParamsCheck(params);
+	ERR_CALL_CHECK(code);
+	code = bignEcCreate(&ec, params);
+	ERR_CALL_CHECK(code);
+	code = bignPubkeyPreEc(pre, ec, pubkey);
+	bignEcClose(ec);
+	return code;
+}
+
+err_t bignVerifyPreEc(const ec_o* ec, const octet oid_der[], size_t oid_len,
+	const octet hash[], const octet sig[], const void* pre)
+{
+	err_t code;
+	size_t no, n;
+	const ec_pre_t* qpre;
+	const ec_pre_t* gpre;
+	void* stack;
+	// pre
+	ASSERT(ecIsOperable(ec));
+	// размерности
+	no = ec->f->no, n = ec->f->n;
+	ASSERT(n % 2 == 0);
+	// входной контроль
+	if (!memIsValid(hash, no) || !memIsValid(sig, no + no / 2) ||
+		!memIsValid(pre, bignPubkeyPre_keep(4 * no)))
+		return ERR_BAD_INPUT;
+	qpre = (const ec_pre_t*)((const octet*)pre + 2 * no);
+	if (qpre->type != ec_pre_si || qpre->w != BIGN_PUBKEY_PRE_W ||
+		qpre->h != bignPubkeyPreH(ec))
+		return ERR_BAD_INPUT;
+	gpre = ec->pre;
+	if (gpre == 0)
+	{
+		gpre = (const ec_pre_t*)((const octet*)pre + 
+			bignPubkeyPreQ_keep(4 * no));
+		if (gpre->type != ec_pre_si || gpre->w != BIGN_PUBKEY_PRE_W ||
+			gpre->h != bignPubkeyPreH(ec))
+			return ERR_BAD_INPUT;
+	}
+	if (oid_len == SIZE_MAX || oidFromDER(0, oid_der, oid_len) == SIZE_MAX)
+		return ERR_BAD_OID;
+	// создать стек
+	stack = blobCreate(bignVerifyEc_deep(n, ec->f->deep, ec->d, ec->deep));
+	if (stack == 0)
+		return ERR_OUTOFMEMORY;
+	// проверить подпись
+	code = bignVerifyEc_internal(ec, gpre, qpre, oid_der, oid_len, hash, 
+		sig, (const octet*)pre, stack);
+	// завершение
+	blobClose(stack);
+	return code;
+}
+
+err_t bignVerifyPre(const bign_params* params, const octet oid_der[],
+	size_t oid_len, const octet hash[], const octet sig[], const void* pre)
+{
+	err_t code;
+	ec_o* ec;
+	code = bignParamsCheck(params);
+	ERR_CALL_CHECK(code);
+	code = bignEcCreate(&ec, params);
+	ERR_CALL_CHECK(code);
+	code = bignVerifyPreEc(ec, oid_der, oid_len, hash, sig, pre);
+	bignEcClose(ec);
+	return code;
+}
+
+/*
+*******************************************************************************
+Пакетная проверка ЭЦП
+
+В подписи bign передается не точка R, а хэш-значение ее x-координаты. 
+Поэтому проверочные соотношения для разных подписей нельзя объединить 
+в одно соотношение со случайными весами, и подписи пакета проверяются 
+по отдельности. Выигрыш достигается за счет того, что параметры, 
+идентификатор хэш-алгоритма и память контролируются и выделяются один раз 
+для всего пакета, а подписи распределяются между потоками.
+
+Если ec->pre == 0, а пакет содержит не менее BIGN_VERIFY_PRE_MIN 
+подписей, то для пакета один раз строится таблица предвычисленных 
+кратных G по схеме SI с окном ширины BIGN_VERIFY_PRE_W. Таблица 
+используется при вычислении s1 G (см. bignVerifyEc_internal()). 
+Построение таблицы стоит примерно 10 проверок подписи, поэтому оно 
+окупается только на больших пакетах.
+
+Каждый поток обрабатывает не менее BIGN_VERIFY_MT_MIN подписей 
+на собственном стеке.
+*******************************************************************************
+*/
+
+#define BIGN_VERIFY_PRE_MIN 64
+#define BIGN_VERIFY_PRE_W 8
+#define BIGN_VERIFY_MT_MIN 4
+
+typedef struct
+{
+	const ec_o* ec;			/*< описание кривой */
+	const ec_pre_t* pre;	/*< предвычисленные кратные G (или 0) */
+	const octet* oid_der;	/*< идентификатор хэш-алгоритма */
+	size_t oid_len;			/*< длина oid_der */
+	const octet* hashes;	/*< хэш-значения */
+	const octet* sigs;		/*< подписи */
+	const octet* pubkeys;	/*< открытые ключи */
+	err_t* rets;			/*< результаты проверки */
+	size_t count;			/*< число подписей */
+	void* stack;			/*< стек */
+	mt_thrd_t thrd;			/*< поток */
+	bool_t created;			/*< поток создан? */
+} bign_verify_job;
+
+static void bignVerifyBatchJob(void* arg)
+{
+	bign_verify_job* job = (bign_verify_job*)arg;
+	const size_t no = job->ec->f->no;
+	size_t i;
+	for (i = 0; i < job->count; ++i)
+		job->rets[i] = bignVerifyEc_internal(job->ec, job->pre, 0,
+			job->oid_der, job->oid_len, job->hashes + no * i, 
+			job->sigs + (no + no / 2) * i, job->pubkeys + 2 * no * i, 
+			job->stack);
+}
+
+err_t bignVerifyBatchEc(err_t rets[], const ec_o* ec, const octet oid_der[],
+	size_t oid_len, const octet hashes[], const octet sigs[], 
+	const octet pubkeys[], size_t count, size_t nthreads)
+{
+	err_t code = ERR_OK;
+	size_t no, n;
+	size_t mb, h, pre_size;
+	size_t keep, k, pos, i;
+	void* state;
+	bign_verify_job* jobs;		/* [k] задания */
+	octet* stacks;				/* [k * keep] стеки */
+	ec_pre_t* pre;				/* [pre_size] таблица кратных G */
+	const ec_pre_t* base_pre;	/* предвычисленные кратные G (или 0) */
+	// pre
+	ASSERT(ecIsOperable(ec));
+	// размерности
+	no = ec->f->no, n = ec->f->n;
+	ASSERT(n % 2 == 0);
+	// входной контроль
+	if (count == 0 || nthreads == 0 || 
+		count > SIZE_MAX / (2 * no) || count > SIZE_MAX / sizeof(err_t) ||
+		!memIsValid(hashes, no * count) || 
+		!memIsValid(sigs, (no + no / 2) * count) ||
+		!memIsValid(pubkeys, 2 * no * count) ||
+		!memIsValid(rets, sizeof(err_t) * count) ||
+		!memIsDisjoint2(rets, sizeof(err_t) * count, hashes, no * count) ||
+		!memIsDisjoint2(rets, sizeof(err_t) * count, 
+			sigs, (no + no / 2) * count) ||
+		!memIsDisjoint2(rets, sizeof(err_t) * count, 
+			pubkeys, 2 * no * count))
+		return ERR_BAD_INPUT;
+	// определить число заданий
+	k = count / BIGN_VERIFY_MT_MIN;
+	if (k > nthreads)
+		k = nthreads;
+	if (k == 0)
+		k = 1;
+	// строить таблицу?
+	mb = wwBitSize(ec->order, n + 1);
+	h = mb / BIGN_VERIFY_PRE_W;
+	pre_size = 0;
+	if (ec->pre == 0 && count >= BIGN_VERIFY_PRE_MIN && 
+		mb % BIGN_VERIFY_PRE_W == 0)
+		pre_size = sizeof(ec_pre_t) + 
+			O_OF_W(SIZE_BIT_POS(BIGN_VERIFY_PRE_W - 1) * 2 * n);
+	// создать состояние
+	keep = bignVerifyEc_deep(n, ec->f->deep, ec->d, ec->deep);
+	if (pre_size)
+		keep = utilMax(2, keep, 
+			memSliceSize(ecPreSI_deep(n, ec->d, ec->deep, h), SIZE_0, 
+				SIZE_MAX));
+	if (oid_len == SIZE_MAX || oidFromDER(0, oid_der, oid_len) == SIZE_MAX)
+		code = ERR_BAD_OID;
+	else
+	{
+		state = blobCreate2(
+			sizeof(bign_verify_job) * k,
+			keep * k,
+			pre_size,
+			SIZE_MAX,
+			&jobs, &stacks, &pre);
+		if (state == 0)
+			code = ERR_OUTOFMEMORY;
+	}
+	if (code != ERR_OK)
+	{
+		for (i = 0; i < count; ++i)
+			rets[i] = code;
+		return code;
+	}
+	// построить таблицу
+	base_pre = ec->pre;
+	if (pre_size && 
+		ecPreSI(pre, ec->base, BIGN_VERIFY_PRE_W, h, ec, stacks))
+		base_pre = pre;
+	// подготовить задания
+	for (i = pos = 0; i < k; ++i)
+	{
+		jobs[i].ec = ec, jobs[i].pre = base_pre;
+		jobs[i].oid_der = oid_der, jobs[i].oid_len = oid_len;
+		jobs[i].count = count / k + (i < count % k);
+		jobs[i].hashes = hashes + no * pos;
+		jobs[i].sigs = sigs + (no + no / 2) * pos;
+		jobs[i].pubkeys = pubkeys + 2 * no * pos;
+		jobs[i].rets = rets + pos;
+		jobs[i].stack = stacks + keep * i;
+		pos += jobs[i].count;
+	}
+	ASSERT(pos == count);
+	// запустить потоки
+	for (i = 1; i < k; ++i)
+		jobs[i].created = 
+			mtThrdCreate(&jobs[i].thrd, bignVerifyBatchJob, jobs + i);
+	// обработать первый фрагмент
+	bignVerifyBatchJob(jobs);
+	// дождаться завершения потоков
+	for (i = 1; i < k; ++i)
+		if (jobs[i].created)
+			mtThrdJoin(&jobs[i].thrd);
+		else
+			bignVerifyBatchJob(jobs + i);
+	// завершение
+	blobClose(state);
+	// проверить результаты
+	for (i = 0; code == ERR_OK && i < count; ++i)
+		if (rets[i] != ERR_OK)
+			code = ERR_BAD_SIG;
+	return code;
+}
+
+err_t bignVerifyBatch(err_t rets[], const bign_params* params, 
+	const octet oid_der[], size_t oid_len, const octet hashes[], 
+	const octet sigs[], const octet pubkeys[], size_t count, 
+	size_t nthreads)
+{
+	err_t code;
+	ec_o* ec;
+	code = bignParamsCheck(params);
+	ERR_CALL_CHECK(code);
+	code = bignEcCreate(&ec, params);
+	ERR_CALL_CHECK(code);
+	code = bignVerifyBatchEc(rets, ec, oid_der, oid_len, hashes, sigs, 
+		pubkeys, count, nthreads);
+	bignEcClose(ec);
+	return code;
+}
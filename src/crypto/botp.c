@@ -4,7 +4,7 @@
 \brief STB 34.101.47/botp: OTP algorithms
 \project bee2 [cryptographic library]
 \created 2015.11.02
-\version 2026.03.24
+\version 2026.10.16
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
@@ -110,13 +110,12 @@ typedef struct
 	octet ctr1[8];			/*< копия счетчика */
 	octet mac[32];			/*< имитовставка */
 	char otp[10];			/*< текущий пароль */
-	mem_align_t stack[];	/*< 2 состояния beltHMAC */
+	mem_align_t stack[];	/*< состояние beltHMAC */
 } botp_hotp_st;
 
 size_t botpHOTP_keep()
 {
-	return sizeof(botp_hotp_st) + 
-		memSliceSize(beltHMAC_keep(), beltHMAC_keep(), SIZE_MAX);
+	return sizeof(botp_hotp_st) + beltHMAC_keep();
 }
 
 void botpHOTPStart(void* state, size_t digit, const octet key[], 
@@ -126,7 +125,7 @@ void botpHOTPStart(void* state, size_t digit, const octet key[],
 	ASSERT(6 <= digit && digit <= 8);
 	ASSERT(memIsDisjoint2(key, key_len, state, botpHOTP_keep()));
 	st->digit = digit;
-	beltHMACStart(memSliceNext(st->stack, beltHMAC_keep()), key, key_len);
+	beltHMACStart(st->stack, key, key_len);
 }
 
 void botpHOTPStepS(void* state, const octet ctr[8])
@@ -143,8 +142,7 @@ void botpHOTPStepR(char* otp, void* state)
 	ASSERT(memIsDisjoint2(otp, st->digit + 1, state, botpHOTP_keep()) || 
 		otp == st->otp);
 	// вычислить имитовставку
-	memCopy(st->stack, memSliceNext2(st->stack, beltHMAC_keep()), 
-		beltHMAC_keep());
+	beltHMACRestart(st->stack);
 	beltHMACStepA(st->ctr, 8, st->stack);
 	beltHMACStepG(st->mac, st->stack);
 	// построить пароль
@@ -236,13 +234,12 @@ typedef struct
 	octet t[8];				/*< округленная отметка времени */
 	octet mac[32];			/*< имитовставка */
 	char otp[10];			/*< текущий пароль */
-	mem_align_t stack[];	/*< 2 состояния beltHMAC */
+	mem_align_t stack[];	/*< состояние beltHMAC */
 } botp_totp_st;
 
 size_t botpTOTP_keep()
 {
-	return sizeof(botp_totp_st) + 
-		memSliceSize( beltHMAC_keep(), beltHMAC_keep(), SIZE_MAX);
+	return sizeof(botp_totp_st) + beltHMAC_keep();
 }
 
 void botpTOTPStart(void* state, size_t digit, const octet key[], 
@@ -252,7 +249,7 @@ void botpTOTPStart(void* state, size_t digit, const octet key[],
 	ASSERT(6 <= digit && digit <= 8);
 	ASSERT(memIsDisjoint2(key, key_len, state, botpTOTP_keep()));
 	st->digit = digit;
-	beltHMACStart(memSliceNext(st->stack, beltHMAC_keep()), key, key_len);
+	beltHMACStart(st->stack, key, key_len);
 }
 
 void botpTOTPStepR(char* otp, tm_time_t t, void* state)
@@ -263,8 +260,7 @@ void botpTOTPStepR(char* otp, tm_time_t t, void* state)
 	ASSERT(memIsDisjoint2(otp, st->digit + 1, state, botpHOTP_keep()) || 
 		otp == st->otp);
 	// вычислить имитовставку
-	memCopy(st->stack, memSliceNext2(st->stack, beltHMAC_keep()), 
-		beltHMAC_keep());
+	beltHMACRestart(st->stack);
 	botpTimeToCtr(st->t, t);
 	beltHMACStepA(st->t, 8, st->stack);
 	beltHMACStepG(st->mac, st->stack);
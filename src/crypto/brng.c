@@ -4,7 +4,7 @@
 \brief STB 34.101.47 (brng): algorithms of pseudorandom number generation
 \project bee2 [cryptographic library]
 \created 2013.01.31
-\version 2025.10.02
+\version 2026.10.16
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
@@ -177,9 +177,9 @@ err_t brngCTRRand(void* buf, size_t count, const octet key[32], octet iv[32])
 *******************************************************************************
 Генерация в режиме HMAC
 
-В brng_hmac_st::stack размещаются два beltHMAC-состояния:
--	вспомогательное состояние;
--	состояние beltHMAC(key, ...).
+В brng_hmac_st::stack размещается состояние beltHMAC(key, ...). 
+Перед очередным вычислением beltHMAC состояние перезапускается 
+(beltHMACRestart()), ключ повторно не обрабатывается.
 
 \remark Учитывается инкрементальность beltHMAC
 *******************************************************************************
@@ -192,13 +192,12 @@ typedef struct
 	octet r[32];				/*< переменная r */
 	octet block[32];			/*< блок выходных данных */
 	size_t reserved;			/*< резерв выходных октетов */
-	mem_align_t stack[];		/*< 2 состояния beltHMAC */
+	mem_align_t stack[];		/*< состояние beltHMAC */
 } brng_hmac_st;
 
 size_t brngHMAC_keep()
 {
-	return sizeof(brng_hmac_st) + 
-		memSliceSize(beltHMAC_keep(), beltHMAC_keep(), SIZE_MAX);
+	return sizeof(brng_hmac_st) + beltHMAC_keep();
 }
 
 void brngHMACStart(void* state, const octet key[], size_t key_len, 
@@ -216,10 +215,8 @@ void brngHMACStart(void* state, const octet key[], size_t key_len,
 	else
 		s->iv = iv;
 	// обработать key
-	beltHMACStart(memSliceNext(s->stack, beltHMAC_keep()), key, key_len);
+	beltHMACStart(s->stack, key, key_len);
 	// r <- beltHMAC(key, iv)
-	memCopy(s->stack, memSliceNext2(s->stack, beltHMAC_keep()), 
-		beltHMAC_keep());
 	beltHMACStepA(iv, iv_len, s->stack);
 	beltHMACStepG(s->r, s->stack);
 	// нет выходных данных
@@ -248,8 +245,7 @@ void brngHMACStepR(void* buf, size_t count, void* state)
 	while (count >= 32)
 	{
 		// r <- beltHMAC(key, r) 
-		memCopy(s->stack, memSliceNext2(s->stack, beltHMAC_keep()), 
-			beltHMAC_keep());
+		beltHMACRestart(s->stack);
 		beltHMACStepA(s->r, 32, s->stack);
 		beltHMACStepG(s->r, s->stack);
 		// Y_t <- beltHMAC(key, r || iv)
@@ -263,8 +259,7 @@ void brngHMACStepR(void* buf, size_t count, void* state)
 	if (count)
 	{
 		// r <- beltHMAC(key, r) 
-		memCopy(s->stack, memSliceNext(s->stack, beltHMAC_keep()), 
-			beltHMAC_keep());
+		beltHMACRestart(s->stack);
 		beltHMACStepA(s->r, 32, s->stack);
 		beltHMACStepG(s->r, s->stack);
 		// Y_t <- left(beltHMAC(key, r || iv))
@@ -4,7 +4,7 @@
 \brief Elliptic curves
 \project bee2 [cryptographic library]
 \created 2014.03.04
-\version 2026.03.06
+\version 2026.10.16
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
@@ -1294,3 +1294,326 @@ size_t ecAddMulA_deep(size_t n, size_t ec_d, size_t ec_deep, size_t k, ...)
 	va_end(args);
 	return ret;
 }
+
+/*
+*******************************************************************************
+Сумма кратных точек: массивы
+
+В функции ecMulMulti() определяется сумма кратных точек
+	d[0] a[0] + d[1] a[1] + ... + d[k-1] a[k-1]
+одним из двух методов. Метод выбирается по оценкам сложности, которые 
+приводятся ниже. В оценках l -- максимальная битовая длина d[i], (P <- P + A) 
+и (P <- P + P) учитываются с весами 11 и 16 (см. ecp_j.c), общие для 
+обоих методов l(P <- 2P) не учитываются.
+
+1. Метод interleaving с оконными NAF (алгоритм 3.51 из [HMV04], 
+см. ecAddMulA()). Для каждой точки a[i] рассчитываются проективные 
+малые кратные a[i], 3a[i], ..., (2^{w-1}-1)a[i] (по схеме SO, w выбирается 
+функцией ecNAFWidth()), после чего все k 2^{w-2} малых кратных 
+одновременно преобразуются к аффинному виду с помощью функции интерфейса 
+ec_toan_i. Поэтому в основном цикле выполняются сложения P <- P + A, 
+а не P <- P + P. Сложность:
+	k[1(P <- 2A) + 1(P <- P + A) + (2^{w-2}-2)(P <- P + P) + 
+		l/(w + 1)(P <- P + A)].
+
+2. Метод Пиппенджера (bucket method, см. [BDLO12]). Кратности 
+записываются знаковыми цифрами по основанию 2^c:
+	d[i] = \sum_{j=0}^{h-1} e_{ij} 2^{cj}, |e_{ij}| <= 2^{c-1}, 
+	h = l / c + 1.
+Для каждого j (от старших к младшим) точки раскладываются по 2^{c-1} 
+корзинам: корзина B_e накапливает точки sgn(e_{ij})a[i] с |e_{ij}| = e. 
+Сумма \sum_e e B_e определяется 2^c сложениями (через нарастающие суммы) 
+и добавляется к результату, предварительно умноженному на 2^c. 
+Сложность:
+	h[k(P <- P + A) + 2^c(P <- P + P)].
+Ширина c выбирается минимизацией этой оценки.
+
+Цифры e_{ij} определяются по c-битовым фрагментам d_{ij} кратностей 
+и битам переноса t_{ij}: 
+	e_{ij} = d_{ij} + t_{ij} - 2^c t_{i,j+1},
+где t_{i0} = 0 и t_{i,j+1} = 1 тогда и только тогда, когда 
+d_{ij} + t_{ij} > 2^{c-1}. Биты переноса рассчитываются заранее.
+
+Метод Пиппенджера используется также в том случае, если какая-либо 
+из малых кратных метода interleaving оказалась бесконечно удаленной.
+
+[BDLO12] Bernstein D., Doumen J., Lange T., Oosterwijk J.-J. Faster batch 
+         forgery identification. INDOCRYPT 2012.
+         https://eprint.iacr.org/2012/549.pdf.
+*******************************************************************************
+*/
+
+// оценка сложности метода interleaving
+static size_t ecMulMultiCostI(size_t l, size_t k)
+{
+	const size_t w = ecNAFWidth(l);
+	return k * (6 + 11 + 16 * (SIZE_BIT_POS(w - 2) - 2) + 11 * l / (w + 1));
+}
+
+// ширина окна метода Пиппенджера
+static size_t ecMulMultiWidthP(size_t l, size_t k)
+{
+	size_t c, best_c, cost, best_cost;
+	best_c = 2, best_cost = SIZE_MAX;
+	for (c = 2; c < 16; ++c)
+	{
+		cost = (l / c + 1) * (11 * k + 16 * SIZE_BIT_POS(c));
+		if (cost < best_cost)
+			best_c = c, best_cost = cost;
+	}
+	return best_c;
+}
+
+// оценка сложности метода Пиппенджера
+static size_t ecMulMultiCostP(size_t l, size_t k)
+{
+	const size_t c = ecMulMultiWidthP(l, k);
+	return (l / c + 1) * (11 * k + 16 * SIZE_BIT_POS(c));
+}
+
+// c-битовый фрагмент [m]d, начиная с позиции pos
+static word ecMulMultiGetBits(const word d[], size_t m, size_t pos, size_t c)
+{
+	if (pos >= B_OF_W(m))
+		return 0;
+	if (pos + c > B_OF_W(m))
+		c = B_OF_W(m) - pos;
+	return wwGetBits(d, pos, c);
+}
+
+#define ecMulMultiI_local(n, ec_d, m, k, w)\
+/* t */			O_OF_W(ec_d * n),\
+/* u */			O_OF_W(2 * n),\
+/* naf_size */	O_PER_S * k,\
+/* naf_pos */	O_PER_S * k,\
+/* naf */		O_OF_W((2 * m + 1) * k),\
+/* pre */		O_OF_W(SIZE_BIT_POS(w - 2) * 2 * n * k),\
+/* pre1 */		O_OF_W(SIZE_BIT_POS(w - 2) * ec_d * n * k)
+
+static bool_t ecMulMultiI(bool_t* ret, word b[], const word a[], 
+	const ec_o* ec, const word d[], size_t m, size_t k, void* stack)
+{
+	const size_t n = ec->f->n;
+	const size_t naf_width = ecNAFWidth(B_OF_W(m));
+	const size_t half = SIZE_BIT_POS(naf_width - 2);
+	size_t naf_max_size;
+	size_t i, j;
+	word digit;
+	word* t;			/* [ec->d * n] проективная точка */
+	word* u;			/* [2 * n] аффинная точка */
+	size_t* naf_size;	/* [k] длины NAF */
+	size_t* naf_pos;	/* [k] позиции в NAF */
+	word* naf;			/* [k][2 * m + 1] NAF */
+	word* pre;			/* [k * half] аффинные малые кратные */
+	word* pre1;			/* [k * half] проективные малые кратные */
+	// разметить стек
+	memSlice(stack,
+		ecMulMultiI_local(n, ec->d, m, k, naf_width), SIZE_0, SIZE_MAX,
+		&t, &u, &naf_size, &naf_pos, &naf, &pre, &pre1, &stack);
+	// NAF и проективные малые кратные
+	naf_max_size = 0;
+	for (i = 0; i < k; ++i)
+	{
+		const word* ai = ecPtA(a, i, ec);
+		word* p = ecPt(pre1, i * half, ec);
+		naf_size[i] = wwNAF(naf + (2 * m + 1) * i, d + m * i, m, naf_width);
+		if (naf_size[i] > naf_max_size)
+			naf_max_size = naf_size[i];
+		naf_pos[i] = 0;
+		// p[0] <- a[i], t <- 2 a[i], p[1] <- t + a[i], ...
+		ecFromA(p, ai, ec, stack);
+		ecDblA(t, ai, ec, stack);
+		ecAddA(ecPt(p, 1, ec), t, ai, ec, stack);
+		for (j = 2; j < half; ++j)
+			ecAdd(ecPt(p, j, ec), t, ecPt(p, j - 1, ec), ec, stack);
+	}
+	// аффинные малые кратные
+	if (ec->toan)
+	{
+		if (!ec->toan(pre, pre1, k * half, ec, stack))
+			return FALSE;
+	}
+	else
+		for (i = 0; i < k * half; ++i)
+			if (!ecToA(ecPtA(pre, i, ec), ecPt(pre1, i, ec), ec, stack))
+				return FALSE;
+	// t <- O
+	ecSetO(t, ec);
+	// основной цикл
+	for (; naf_max_size; --naf_max_size)
+	{
+		// t <- 2 t
+		ecDbl(t, t, ec, stack);
+		// цикл по (a[i], naf[i])
+		for (i = 0; i < k; ++i)
+		{
+			// цифры naf[i] не начались?
+			if (naf_size[i] < naf_max_size)
+				continue;
+			// прочитать очередную цифру naf[i]
+			digit = wwGetBits(naf + (2 * m + 1) * i, naf_pos[i], naf_width);
+			// обработать цифру
+			if (digit & 1)
+			{
+				// t <- t \pm pre[i * half + |digit| / 2]
+				if (digit >> (naf_width - 1))
+				{
+					j = (size_t)(WORD_BIT_POS(naf_width) - digit) >> 1;
+					ecNegA(u, ecPtA(pre, i * half + j, ec), ec, stack);
+					ecAddA(t, t, u, ec, stack);
+				}
+				else
+				{
+					j = (size_t)digit >> 1;
+					ecAddA(t, t, ecPtA(pre, i * half + j, ec), ec, stack);
+				}
+				// к следующей цифре naf[i]
+				naf_pos[i] += naf_width;
+			}
+			else
+				// к следующей цифре
+				++naf_pos[i];
+		}
+	}
+	// к аффинным координатам
+	*ret = ecToA(b, t, ec, stack);
+	// очистка
+	CLEAN(digit);
+	return TRUE;
+}
+
+static size_t ecMulMultiI_deep(size_t n, size_t ec_d, size_t ec_deep, 
+	size_t m, size_t k)
+{
+	return memSliceSize(
+		ecMulMultiI_local(n, ec_d, m, k, ecNAFWidth(B_OF_W(m))),
+		ec_deep,
+		SIZE_MAX);
+}
+
+#define ecMulMultiP_local(n, ec_d, k, c, h)\
+/* t */			O_OF_W(ec_d * n),\
+/* s */			O_OF_W(ec_d * n),\
+/* r */			O_OF_W(ec_d * n),\
+/* u */			O_OF_W(2 * n),\
+/* carry */		O_OF_W(W_OF_B((h + 1) * k)),\
+/* buckets */	O_OF_W(SIZE_BIT_POS(c - 1) * ec_d * n)
+
+static bool_t ecMulMultiP(word b[], const word a[], const ec_o* ec, 
+	const word d[], size_t m, size_t k, size_t l, void* stack)
+{
+	const size_t n = ec->f->n;
+	const size_t c = ecMulMultiWidthP(l, k);
+	const size_t h = l / c + 1;
+	const size_t half = SIZE_BIT_POS(c - 1);
+	size_t i, j, e;
+	word* t;			/* [ec->d * n] результат */
+	word* s;			/* [ec->d * n] нарастающая сумма корзин */
+	word* r;			/* [ec->d * n] сумма окна */
+	word* u;			/* [2 * n] аффинная точка */
+	word* carry;		/* [(h + 1) * k] биты переноса */
+	word* buckets;		/* [half] корзины */
+	// разметить стек
+	memSlice(stack,
+		ecMulMultiP_local(n, ec->d, k, c, h), SIZE_0, SIZE_MAX,
+		&t, &s, &r, &u, &carry, &buckets, &stack);
+	// биты переноса: carry[(h + 1) i + j] == t_{ij}
+	wwSetZero(carry, W_OF_B((h + 1) * k));
+	for (i = 0; i < k; ++i)
+		for (j = 0; j < h; ++j)
+		{
+			e = (size_t)ecMulMultiGetBits(d + m * i, m, c * j, c);
+			e += wwTestBit(carry, (h + 1) * i + j);
+			if (e > half)
+				wwSetBit(carry, (h + 1) * i + j + 1, TRUE);
+		}
+	// t <- O
+	ecSetO(t, ec);
+	// цикл по окнам
+	for (j = h; j--;)
+	{
+		// t <- 2^c t
+		if (!ecIsO(t, ec))
+			for (e = 0; e < c; ++e)
+				ecDbl(t, t, ec, stack);
+		// разложить точки по корзинам
+		for (e = 0; e < half; ++e)
+			ecSetO(ecPt(buckets, e, ec), ec);
+		for (i = 0; i < k; ++i)
+		{
+			bool_t neg;
+			e = (size_t)ecMulMultiGetBits(d + m * i, m, c * j, c);
+			e += wwTestBit(carry, (h + 1) * i + j);
+			neg = wwTestBit(carry, (h + 1) * i + j + 1);
+			if (neg)
+				e = SIZE_BIT_POS(c) - e;
+			if (e == 0)
+				continue;
+			ASSERT(e <= half);
+			if (neg)
+			{
+				ecNegA(u, ecPtA(a, i, ec), ec, stack);
+				ecAddA(ecPt(buckets, e - 1, ec), ecPt(buckets, e - 1, ec), 
+					u, ec, stack);
+			}
+			else
+				ecAddA(ecPt(buckets, e - 1, ec), ecPt(buckets, e - 1, ec), 
+					ecPtA(a, i, ec), ec, stack);
+		}
+		// r <- \sum_e e B_e
+		ecSetO(s, ec);
+		ecSetO(r, ec);
+		for (e = half; e--;)
+		{
+			ecAdd(s, s, ecPt(buckets, e, ec), ec, stack);
+			ecAdd(r, r, s, ec, stack);
+		}
+		// t <- t + r
+		ecAdd(t, t, r, ec, stack);
+	}
+	// к аффинным координатам
+	return ecToA(b, t, ec, stack);
+}
+
+static size_t ecMulMultiP_deep(size_t n, size_t ec_d, size_t ec_deep, 
+	size_t k, size_t l)
+{
+	const size_t c = ecMulMultiWidthP(l, k);
+	return memSliceSize(
+		ecMulMultiP_local(n, ec_d, k, c, l / c + 1),
+		ec_deep,
+		SIZE_MAX);
+}
+
+bool_t ecMulMulti(word b[], const word a[], const ec_o* ec, const word d[],
+	size_t m, size_t k, void* stack)
+{
+	size_t l, i;
+	bool_t ret;
+	// pre
+	ASSERT(ecIsOperable(ec));
+	ASSERT(m > 0 && k > 0);
+	ASSERT(wwIsValid(a, 2 * ec->f->n * k));
+	ASSERT(wwIsValid(d, m * k));
+	ASSERT(wwIsDisjoint2(b, 2 * ec->f->n, a, 2 * ec->f->n * k));
+	ASSERT(wwIsDisjoint2(b, 2 * ec->f->n, d, m * k));
+	// l <- max_i wwBitSize(d[i])
+	for (i = l = 0; i < k; ++i)
+		l = MAX2(l, wwBitSize(d + m * i, m));
+	if (l == 0)
+		return FALSE;
+	// interleaving?
+	if (ecMulMultiCostI(B_OF_W(m), k) <= ecMulMultiCostP(l, k) &&
+		ecMulMultiI(&ret, b, a, ec, d, m, k, stack))
+		return ret;
+	// метод Пиппенджера
+	return ecMulMultiP(b, a, ec, d, m, k, l, stack);
+}
+
+size_t ecMulMulti_deep(size_t n, size_t ec_d, size_t ec_deep, size_t m, 
+	size_t k)
+{
+	return utilMax(2,
+		ecMulMultiI_deep(n, ec_d, ec_deep, m, k),
+		ecMulMultiP_deep(n, ec_d, ec_deep, k, B_OF_W(m)));
+}
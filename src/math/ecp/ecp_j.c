@@ -4,7 +4,7 @@
 \brief Elliptic curves over prime fields: Jacobian coordinates
 \project bee2 [cryptographic library]
 \created 2012.06.26
-\version 2026.02.13
+\version 2026.10.16
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
@@ -59,6 +59,10 @@ ecpDblAJ(). Подумать, как "помочь" этой функции, п
 рассчитанные значения, например, za^2. Аналогичное замечание касается
 функции ecpAddJ().
 
+В функции ecpToANJ() выполняется преобразование count якобиевых точек 
+в аффинные. Используется прием Монтгомери: вместо count обращений 
+в базовом поле выполняется одно обращение и 3(count - 1) умножений.
+
 \remark Целевые функции ci(l), определенные в описании реализации ecMulA()
 в ec.c, принимают следующий вид:
 	c1(l) = l/3 11;
@@ -140,6 +144,79 @@ static size_t ecpToAJ_deep(size_t n, size_t f_deep)
 		SIZE_MAX);
 }
 
+#define ecpToANJ_local(n)\
+/* t1 */	O_OF_W(n),\
+/* t2 */	O_OF_W(n),\
+/* t3 */	O_OF_W(n)
+
+// [count][2n]b <- [count][3n]a (A <- J)
+static bool_t ecpToANJ(word b[], const word a[], size_t count, 
+	const ec_o* ec, void* stack)
+{
+	size_t n, i;
+	word* t1;			/* [n] */
+	word* t2;			/* [n] */
+	word* t3;			/* [n] */
+	// pre
+	ASSERT(ecIsOperable(ec) && ec->d == 3);
+	ASSERT(wwIsDisjoint2(a, 3 * ec->f->n * count, b, 2 * ec->f->n * count));
+	// разметить стек
+	n = ec->f->n;
+	memSlice(stack,
+		ecpToANJ_local(n), SIZE_0, SIZE_MAX,
+		&t1, &t2, &t3, &stack);
+	if (count == 0)
+		return TRUE;
+	// xb[i] <- za[0] za[1] ... za[i]
+	for (i = 0; i < count; ++i)
+	{
+		const word* ai = ecPt(a, i, ec);
+		ASSERT(ecpSeemsOnJ(ai, ec));
+		// a[i] == O => b <- O
+		if (qrIsZero(ecZ(ai, n), ec->f))
+			return FALSE;
+		if (i == 0)
+			qrCopy(ecX(b), ecZ(ai, n), ec->f);
+		else
+			qrMul(ecX(ecPtA(b, i, ec)), ecX(ecPtA(b, i - 1, ec)), 
+				ecZ(ai, n), ec->f, stack);
+	}
+	// t1 <- (za[0] za[1] ... za[count - 1])^{-1}
+	qrInv(t1, ecX(ecPtA(b, count - 1, ec)), ec->f, stack);
+	// цикл по точкам в обратном порядке
+	for (i = count; i--;)
+	{
+		const word* ai = ecPt(a, i, ec);
+		word* bi = ecPtA(b, i, ec);
+		// t2 <- za[i]^{-1}, t1 <- (za[0] ... za[i - 1])^{-1}
+		if (i)
+		{
+			qrMul(t2, t1, ecX(ecPtA(b, i - 1, ec)), ec->f, stack);
+			qrMul(t1, t1, ecZ(ai, n), ec->f, stack);
+		}
+		else
+			qrCopy(t2, t1, ec->f);
+		// t3 <- t2^2
+		qrSqr(t3, t2, ec->f, stack);
+		// xb[i] <- xa[i] t3
+		qrMul(ecX(bi), ecX(ai), t3, ec->f, stack);
+		// t3 <- t2 t3
+		qrMul(t3, t2, t3, ec->f, stack);
+		// yb[i] <- ya[i] t3
+		qrMul(ecY(bi, n), ecY(ai, n), t3, ec->f, stack);
+	}
+	// b[i] != O
+	return TRUE;
+}
+
+static size_t ecpToANJ_deep(size_t n, size_t f_deep)
+{
+	return memSliceSize(
+		ecpToANJ_local(n), 
+		f_deep,
+		SIZE_MAX);
+}
+
 // [3n]b <- -[3n]a (J <- -J)
 static void ecpNegJ(word b[], const word a[], const ec_o* ec, void* stack)
 {
@@ -1289,6 +1366,7 @@ bool_t ecpCreateJ(ec_o* ec, const qr_o* f, const octet A[], const octet B[],
 	// настроить интерфейсы
 	ec->froma = ecpFromAJ;
 	ec->toa = ecpToAJ;
+	ec->toan = ecpToANJ;
 	ec->neg = ecpNegJ;
 	ec->nega = ecpNegAJ;
 	ec->add = ecpAddJ;
@@ -1305,8 +1383,9 @@ bool_t ecpCreateJ(ec_o* ec, const qr_o* f, const octet A[], const octet B[],
 		ec->finadda = ecpFinAddA;
 	}
 	// для простоты учитываем в том числе глубину ecpFinAdd/ecpFinAddA
-	ec->deep = utilMax(9,
+	ec->deep = utilMax(10,
 		ecpToAJ_deep(f->n, f->deep),
+		ecpToANJ_deep(f->n, f->deep),
 		ecpAddJ_deep(f->n, f->deep),
 		ecpAddAJ_deep(f->n, f->deep),
 		bA3 ? ecpDblJA3_deep(f->n, f->deep) : ecpDblJ_deep(f->n, f->deep),
@@ -1335,9 +1414,10 @@ size_t ecpCreateJ_deep(size_t n, size_t f_deep)
 {
 	return memSliceSize(
 		ecpCreateJ_local(n),
-		utilMax(12,
+		utilMax(13,
 			O_OF_W(n),
 			ecpToAJ_deep(n, f_deep),
+			ecpToANJ_deep(n, f_deep),
 			ecpAddJ_deep(n, f_deep),
 			ecpAddAJ_deep(n, f_deep),
 			ecpDblJ_deep(n, f_deep),
@@ -0,0 +1,59 @@
+/*
+*******************************************************************************
+\file cpu_test.c
+\brief Tests for processor capabilities
+\project bee2/test
+\created 2026.10.16
+\version 2026.10.16
+\copyright The Bee2 authors
+\license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
+*******************************************************************************
+*/
+
+#include <bee2/core/cpu.h>
+#include <bee2/core/util.h>
+
+/*
+*******************************************************************************
+Тестирование
+*******************************************************************************
+*/
+
+static bool_t cpuTestDispatch(size_t have)
+{
+	const size_t caps[] = { CPU_AVX512F | CPU_AVX2, CPU_AVX2, 
+		CPU_SSE2 | CPU_PCLMUL, CPU_NEON, 0 };
+	size_t i, j;
+	// выбрано первое подходящее ядро?
+	i = cpuDispatch(caps, COUNT_OF(caps));
+	if (i >= COUNT_OF(caps) || (caps[i] & have) != caps[i])
+		return FALSE;
+	for (j = 0; j < i; ++j)
+		if ((caps[j] & have) == caps[j])
+			return FALSE;
+	return TRUE;
+}
+
+bool_t cpuTest()
+{
+	const size_t all = CPU_SSE2 | CPU_PCLMUL | CPU_AVX2 | CPU_AVX512F | 
+		CPU_NEON;
+	size_t have;
+	size_t epoch;
+	bool_t ret;
+	// возможности
+	have = cpuCaps();
+	if ((have & ~all) != 0 || !cpuHas(0) || !cpuHas(have) ||
+		cpuCaps() != have)
+		return FALSE;
+	if (!cpuTestDispatch(have))
+		return FALSE;
+	// маскирование
+	epoch = cpuCapsEpoch();
+	cpuCapsMask(CPU_SSE2);
+	ret = cpuCaps() == (have & CPU_SSE2) && cpuTestDispatch(have & CPU_SSE2);
+	cpuCapsMask(0);
+	ret = ret && cpuCaps() == 0 && !cpuHas(CPU_AVX2) && cpuTestDispatch(0);
+	cpuCapsMask(SIZE_MAX);
+	return ret && cpuCaps() == have && cpuCapsEpoch() == epoch + 3;
+}
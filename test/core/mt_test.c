@@ -4,7 +4,7 @@
 \brief Tests for multithreading
 \project bee2/test
 \created 2021.05.15
-\version 2025.05.07
+\version 2026.10.16
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
@@ -26,10 +26,36 @@ static void init()
 	_inited = TRUE;
 }
 
+static void incr(void* ctr)
+{
+	mtAtomicIncr((size_t*)ctr);
+}
+
+typedef struct
+{
+	mt_mtx_t mtx[1];	/*< мьютекс */
+	mt_cnd_t cnd[1];	/*< условная переменная */
+	size_t stage;		/*< этап обмена */
+} mt_test_cnd;
+
+static void pong(void* arg)
+{
+	mt_test_cnd* t = (mt_test_cnd*)arg;
+	mtMtxLock(t->mtx);
+	while (t->stage != 1)
+		mtCndWait(t->cnd, t->mtx);
+	t->stage = 2;
+	mtCndSignal(t->cnd);
+	mtMtxUnlock(t->mtx);
+}
+
 bool_t mtTest()
 {
 	mt_mtx_t mtx[1];
+	mt_thrd_t thrd[4];
+	mt_test_cnd cnd[1];
 	size_t ctr[1] = { SIZE_0 };
+	size_t i;
 	// мьютексы
 	if (!mtMtxCreate(mtx))
 		return FALSE;
@@ -47,6 +73,37 @@ bool_t mtTest()
 		return FALSE;
 	if (!mtCallOnce(&_once, init) || !_inited)
 		return FALSE;
+	// потоки
+	for (i = 0; i < 4; ++i)
+		if (!mtThrdCreate(thrd + i, incr, ctr))
+			return FALSE;
+	for (i = 0; i < 4; ++i)
+		mtThrdJoin(thrd + i);
+	if (*ctr != 4)
+		return FALSE;
+	// условные переменные
+	if (mtCndCreate(cnd->cnd))
+	{
+		if (!mtMtxCreate(cnd->mtx))
+		{
+			mtCndClose(cnd->cnd);
+			return FALSE;
+		}
+		cnd->stage = 0;
+		if (!mtThrdCreate(thrd, pong, cnd))
+		{
+			mtMtxClose(cnd->mtx), mtCndClose(cnd->cnd);
+			return FALSE;
+		}
+		mtMtxLock(cnd->mtx);
+		cnd->stage = 1;
+		mtCndBroadcast(cnd->cnd);
+		while (cnd->stage != 2)
+			mtCndWait(cnd->cnd, cnd->mtx);
+		mtMtxUnlock(cnd->mtx);
+		mtThrdJoin(thrd);
+		mtMtxClose(cnd->mtx), mtCndClose(cnd->cnd);
+	}
 	// все нормально
 	return TRUE;
 }
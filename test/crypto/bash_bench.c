@@ -4,7 +4,7 @@
 \brief Benchmarks for STB 34.101.77 (bash)
 \project bee2/test
 \created 2014.07.15
-\version 2025.09.28
+\version 2026.10.16
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
@@ -44,7 +44,7 @@ bool_t bashBench()
 	prngCOMBOStart(combo_state, utilNonce32());
 	prngCOMBOStepR(buf, sizeof(buf), combo_state);
 	// платформа
-	printf("bashBench::platform = %s\n", bash_platform);
+	printf("bashBench::platform = %s [%s]\n", bash_platform, bashPlatform());
 	// оценить скорость хэширования
 	{
 		const size_t reps = 2000;
@@ -105,6 +105,32 @@ bool_t bashBench()
 				(unsigned)tmSpeed(2 * reps, ticks));
 		}
 	}
+	// оценить скорость хэширования коротких сообщений
+	{
+		const size_t reps = 200;
+		const void* src[32];
+		size_t count[32];
+		octet hashes[32 * 32];
+		size_t i, j;
+		tm_ticks_t ticks;
+		for (j = 0; j < 32; ++j)
+			src[j] = buf + 16 * j, count[j] = 64;
+		// эксперимент с bash256
+		for (i = 0, ticks = tmTicks(); i < reps; ++i)
+			for (j = 0; j < 32; ++j)
+				bashHash(hashes + 32 * j, 128, src[j], count[j]);
+		ticks = tmTicks() - ticks;
+		printf("bashBench::bash256[32x64]: %3u cpb [%5u kBytes/sec]\n",
+			(unsigned)(ticks / (32 * 64) / reps),
+			(unsigned)tmSpeed(reps * 32 * 64 / 1024, ticks));
+		// эксперимент с bashHashMulti
+		for (i = 0, ticks = tmTicks(); i < reps; ++i)
+			bashHashMulti(hashes, 128, src, count, 32);
+		ticks = tmTicks() - ticks;
+		printf("bashBench::bash256Multi[32x64]: %3u cpb [%5u kBytes/sec]\n",
+			(unsigned)(ticks / (32 * 64) / reps),
+			(unsigned)tmSpeed(reps * 32 * 64 / 1024, ticks));
+	}
 	// все нормально
 	return TRUE;
 }
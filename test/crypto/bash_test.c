@@ -4,18 +4,342 @@
 \brief Tests for STB 34.101.77 (bash)
 \project bee2/test
 \created 2015.09.22
-\version 2025.09.28
+\version 2026.10.16
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
 */
 
+#include <bee2/core/blob.h>
+#include <bee2/core/cpu.h>
+#include <bee2/core/err.h>
 #include <bee2/core/mem.h>
 #include <bee2/core/hex.h>
 #include <bee2/core/util.h>
 #include <bee2/crypto/bash.h>
 #include <bee2/crypto/belt.h>
 
+/*
+*******************************************************************************
+Обработка нескольких состояний
+
+Результаты bashF4() и bashF8() (во всех реализациях, доступных 
+на платформе), bashHashMulti() (за один раз и по частям), 
+bashPrgAbsorbMulti() и bashPrgSqueezeMulti() сравниваются с результатами 
+bashF(), bashHash(), bashPrgAbsorb() и bashPrgSqueeze().
+*******************************************************************************
+*/
+
+static bool_t bashTestF8(octet blocks[1536], octet buf[192], void* stack)
+{
+	const size_t masks[] = { SIZE_MAX, ~(size_t)CPU_AVX512F, 0 };
+	size_t pos, i, j;
+	for (pos = 0; pos < COUNT_OF(masks); ++pos)
+	{
+		cpuCapsMask(masks[pos]);
+		// bashF8()
+		for (i = 0; i < 1536; ++i)
+			blocks[i] = beltH()[(3 * i + pos) % 256];
+		bashF8(blocks, stack);
+		for (j = 0; j < 8; ++j)
+		{
+			for (i = 0; i < 192; ++i)
+				buf[i] = beltH()[(3 * (64 * (i / 8) + 8 * j + i % 8) + pos) 
+					% 256];
+			bashF(buf, stack);
+			for (i = 0; i < 192; ++i)
+				if (buf[i] != blocks[64 * (i / 8) + 8 * j + i % 8])
+					break;
+			if (i < 192)
+				break;
+		}
+		if (j < 8)
+			break;
+		// bashF4()
+		for (i = 0; i < 768; ++i)
+			blocks[i] = beltH()[(5 * i + pos) % 256];
+		bashF4(blocks, stack);
+		for (j = 0; j < 4; ++j)
+		{
+			for (i = 0; i < 192; ++i)
+				buf[i] = beltH()[(5 * (32 * (i / 8) + 8 * j + i % 8) + pos) 
+					% 256];
+			bashF(buf, stack);
+			for (i = 0; i < 192; ++i)
+				if (buf[i] != blocks[32 * (i / 8) + 8 * j + i % 8])
+					break;
+			if (i < 192)
+				break;
+		}
+		if (j < 4)
+			break;
+	}
+	cpuCapsMask(SIZE_MAX);
+	return pos == COUNT_OF(masks);
+}
+
+static bool_t bashTestHashMulti(void* state)
+{
+	const void* src[11];
+	size_t count[11];
+	size_t count1[11];
+	octet hash[48 * 11];
+	octet hash1[48];
+	size_t i;
+	// подготовить сообщения
+	for (i = 0; i < 11; ++i)
+	{
+		src[i] = beltH() + 5 * i;
+		count[i] = (i * 41) % 200;
+	}
+	// хэшировать за один раз
+	if (bashHashMulti(hash, 192, src, count, 11) != ERR_OK)
+		return FALSE;
+	for (i = 0; i < 11; ++i)
+		if (bashHash(hash1, 192, src[i], count[i]) != ERR_OK ||
+			!memEq(hash + 48 * i, hash1, 48))
+			return FALSE;
+	// слишком много сообщений
+	if (bashHashMulti(hash, 192, src, count, SIZE_MAX / 2) != ERR_BAD_INPUT)
+		return FALSE;
+	// хэшировать по частям
+	bashHashMultiStart(state, 128, 11);
+	for (i = 0; i < 11; ++i)
+		count1[i] = count[i] / 3;
+	bashHashMultiStepH(src, count1, state);
+	bashHashMultiStepG(hash, 32, state);
+	for (i = 0; i < 11; ++i)
+	{
+		src[i] = (const octet*)src[i] + count1[i];
+		count1[i] = count[i] - count1[i];
+	}
+	bashHashMultiStepH(src, count1, state);
+	bashHashMultiStepG(hash, 32, state);
+	for (i = 0; i < 11; ++i)
+		if (bashHash(hash1, 128, beltH() + 5 * i, count[i]) != ERR_OK ||
+			!memEq(hash + 32 * i, hash1, 32))
+			return FALSE;
+	return TRUE;
+}
+
+static bool_t bashTestPrgMulti(octet buf[], octet buf1[], void* state)
+{
+	const size_t keep = bashPrg_keep();
+	const void* src[11];
+	void* dest[11];
+	size_t count[11];
+	void* states[11];
+	size_t i;
+	// запустить автоматы
+	for (i = 0; i < 11; ++i)
+	{
+		states[i] = (octet*)state + keep * i;
+		bashPrgStart(states[i], 128 + 64 * (i % 3), 1 + i % 2, 0, 0,
+			beltH(), 32);
+		src[i] = beltH() + 7 * i;
+		count[i] = (i * 53) % 180;
+	}
+	// загрузить / выгрузить
+	bashPrgAbsorbMulti(src, count, states, 11);
+	for (i = 0; i < 11; ++i)
+		dest[i] = buf + 300 * i, count[i] = (i * 67) % 300;
+	bashPrgSqueezeMulti(dest, count, states, 11);
+	// сравнить
+	for (i = 0; i < 11; ++i)
+	{
+		bashPrgStart(states[i], 128 + 64 * (i % 3), 1 + i % 2, 0, 0,
+			beltH(), 32);
+		bashPrgAbsorb(beltH() + 7 * i, (i * 53) % 180, states[i]);
+		bashPrgSqueeze(buf1, count[i], states[i]);
+		if (!memEq(buf + 300 * i, buf1, count[i]))
+			return FALSE;
+	}
+	return TRUE;
+}
+
+static bool_t bashTestMulti()
+{
+	const size_t size = utilMax(3, 
+		1536 + 192 + bashF_deep(), 
+		bashHashMulti_keep(11),
+		11 * bashPrg_keep() + 300 * 11 + 300);
+	octet* stack;
+	bool_t ret;
+	if (!(stack = (octet*)blobCreate(size)))
+		return FALSE;
+	ret = bashTestF8(stack, stack + 1536, stack + 1536 + 192) &&
+		bashTestHashMulti(stack) &&
+		bashTestPrgMulti(stack + 11 * bashPrg_keep(), 
+			stack + 11 * bashPrg_keep() + 300 * 11, stack);
+	blobClose(stack);
+	return ret;
+}
+
+/*
+*******************************************************************************
+Выравнивание
+
+Результаты зашифрования, расшифрования и загрузки выровненных 
+и невыровненных данных сравниваются для всех уровней l и емкостей d.
+*******************************************************************************
+*/
+
+#define bashTestPrgAlign_local(keep)\
+/* buf */		2048,\
+/* stack */		keep,\
+/* stack1 */	keep
+
+static bool_t bashTestPrgAlign()
+{
+	mem_align_t state[4096 / sizeof(mem_align_t)];
+	const size_t keep = bashPrg_keep();
+	octet* buf;			/* [2048] */
+	void* stack;		/* [keep] */
+	void* stack1;		/* [keep] */
+	size_t l, d;
+	// разметить состояние
+	if (sizeof(state) < memSliceSize(
+			bashTestPrgAlign_local(keep),
+			SIZE_MAX))
+		return FALSE;
+	memSlice(state,
+		bashTestPrgAlign_local(keep), SIZE_MAX,
+		&buf, &stack, &stack1);
+	for (l = 128; l <= 256; l += 64)
+	for (d = 1; d <= 2; ++d)
+	{
+		// buf[0..1000) <- H || H || H || H, buf[1001..2001) <- buf[0..1000)
+		memCopy(buf, beltH(), 256);
+		memCopy(buf + 256, beltH(), 256);
+		memCopy(buf + 512, beltH(), 256);
+		memCopy(buf + 768, beltH(), 232);
+		memCopy(buf + 1001, buf, 1000);
+		bashPrgStart(stack, l, d, 0, 0, beltH(), l / 8);
+		bashPrgStart(stack1, l, d, 0, 0, beltH(), l / 8);
+		// зашифровать
+		bashPrgEncr(buf, 1000, stack);
+		bashPrgEncrStart(stack1);
+		bashPrgEncrStep(buf + 1001, 7, stack1);
+		bashPrgEncrStep(buf + 1008, 993, stack1);
+		if (!memEq(buf, buf + 1001, 1000))
+			return FALSE;
+		// загрузить
+		bashPrgAbsorb(buf + 1, 999, stack);
+		bashPrgAbsorb(buf + 1002, 999, stack1);
+		// расшифровать
+		bashPrgDecr(buf + 1001, 1000, stack1);
+		bashPrgDecrStart(stack);
+		bashPrgDecrStep(buf, 1, stack);
+		bashPrgDecrStep(buf + 1, 999, stack);
+		bashPrgSqueeze(buf + 1000, 1, stack);
+		bashPrgSqueeze(buf + 2001, 1, stack1);
+		if (!memEq(buf, buf + 1001, 1001))
+			return FALSE;
+	}
+	return TRUE;
+}
+
+/*
+*******************************************************************************
+Древовидное хэширование
+
+Хэш-значения bashTreeHash(), bashTreeStepH() (для разных разбиений данных 
+на фрагменты) и bashTreeHashLeaves() сравниваются с хэш-значением, 
+которое вычисляется по определению: дерево Меркла строится рекурсивно, 
+левое поддерево содержит максимальную степень двойки листьев, меньшую n.
+*******************************************************************************
+*/
+
+static void bashTestTreeNode(octet node[], size_t l, const octet leaves[], 
+	size_t n, void* state)
+{
+	octet left[64];
+	size_t k;
+	if (n == 1)
+	{
+		memCopy(node, leaves, l / 4);
+		return;
+	}
+	for (k = 1; 2 * k < n; k *= 2);
+	bashTestTreeNode(left, l, leaves, k, state);
+	bashTestTreeNode(node, l, leaves + l / 4 * k, n - k, state);
+	bashPrgStart(state, l, 1, (const octet*)"bashtreenode", 12, 0, 0);
+	bashPrgAbsorbStart(state);
+	bashPrgAbsorbStep(left, l / 4, state);
+	bashPrgAbsorbStep(node, l / 4, state);
+	bashPrgSqueeze(node, l / 4, state);
+}
+
+#define bashTestTree_local(keep)\
+/* leaves */	64 * 64,\
+/* data */		4096,\
+/* stack */		keep
+
+static bool_t bashTestTree()
+{
+	mem_align_t state[20480 / sizeof(mem_align_t)];
+	const size_t keep = utilMax(3, bashTree_keep(4), bashPrg_keep(), 
+		bashHash_keep());
+	const size_t lens[] = { 0, 1, 63, 64, 65, 1000, 1024, 1025, 4095 };
+	const size_t chunks[] = { 1, 37, 200, 1024 };
+	octet hash[64];
+	octet hash1[64];
+	octet* leaves;		/* [64 * 64] */
+	octet* data;		/* [4096] */
+	void* stack;		/* [keep] */
+	size_t l, pos, i, n, t;
+	// разметить состояние
+	if (sizeof(state) < memSliceSize(
+			bashTestTree_local(keep),
+			SIZE_MAX))
+		return FALSE;
+	memSlice(state,
+		bashTestTree_local(keep), SIZE_MAX,
+		&leaves, &data, &stack);
+	for (i = 0; i < 4096; ++i)
+		data[i] = beltH()[i % 256] ^ (octet)(i / 256);
+	for (l = 128; l <= 256; l += 64)
+	for (pos = 0; pos < COUNT_OF(lens); ++pos)
+	{
+		// по определению
+		n = lens[pos] ? (lens[pos] + 63) / 64 : 1;
+		for (i = 0; i < n; ++i)
+			bashHash(leaves + l / 4 * i, l, data + 64 * i, 
+				MIN2(64, lens[pos] - 64 * i));
+		bashTestTreeNode(hash, l, leaves, n, stack);
+		memSetZero(hash1, 8);
+		hash1[0] = 64;
+		bashPrgStart(stack, l, 1, (const octet*)"bashtreeroot", 12, 0, 0);
+		bashPrgAbsorbStart(stack);
+		bashPrgAbsorbStep(hash1, 8, stack);
+		bashPrgAbsorbStep(hash, l / 4, stack);
+		bashPrgSqueeze(hash, l / 4, stack);
+		// по хэш-значениям листьев
+		if (bashTreeHashLeaves(hash1, l, 64, leaves, n) != ERR_OK ||
+			!memEq(hash, hash1, l / 4))
+			return FALSE;
+		// за один вызов
+		if (bashTreeHash(hash1, l, 64, data, lens[pos], 3) != ERR_OK ||
+			!memEq(hash, hash1, l / 4))
+			return FALSE;
+		// по частям
+		for (i = 0; i < COUNT_OF(chunks); ++i)
+		{
+			bashTreeStart(stack, l, 64, 1 + i);
+			for (n = 0; n < lens[pos]; n += t)
+			{
+				t = MIN2(chunks[i], lens[pos] - n);
+				bashTreeStepH(data + n, t, stack);
+				if (n == 0)
+					bashTreeStepG(hash1, l / 4, stack);
+			}
+			if (!bashTreeStepV(hash, l / 4, stack))
+				return FALSE;
+		}
+	}
+	return TRUE;
+}
+
 /*
 *******************************************************************************
 Самотестирование
@@ -30,6 +354,7 @@ bool_t bashTest()
 	octet hash[64];
 	mem_align_t state[1024 / sizeof(mem_align_t)];
 	mem_align_t state1[1024 / sizeof(mem_align_t)];
+	const size_t masks[] = { SIZE_MAX, ~(size_t)CPU_AVX512F, 0 };
 	size_t pos;
 	// подготовить память
 	if (sizeof(state) < utilMax(3,
@@ -38,23 +363,31 @@ bool_t bashTest()
 			bashPrg_keep()) ||
 		sizeof(state) != sizeof(state1))
 		return FALSE;
-	// A.2
-	memCopy(buf, beltH(), 192);
-	bashF(buf, state);
-	if (!hexEq(buf, 
-		"8FE727775EA7F140B95BB6A200CBB28C"
-		"7F0809C0C0BC68B7DC5AEDC841BD94E4"
-		"03630C301FC255DF5B67DB53EF65E376"
-		"E8A4D797A6172F2271BA48093173D329"
-		"C3502AC946767326A2891971392D3F70"
-		"89959F5D61621238655975E00E2132A0"
-		"D5018CEEDB17731CCD88FC50151D37C0"
-		"D4A3359506AEDC2E6109511E7703AFBB"
-		"014642348D8568AA1A5D9868C4C7E6DF"
-		"A756B1690C7C2608A2DC136F5997AB8F"
-		"BB3F4D9F033C87CA6070E117F099C409"
-		"4972ACD9D976214B7CED8E3F8B6E058E"))
-		return FALSE;
+	// A.2 (все реализации bashF(), доступные на платформе)
+	for (pos = 0; pos < COUNT_OF(masks); ++pos)
+	{
+		cpuCapsMask(masks[pos]);
+		memCopy(buf, beltH(), 192);
+		bashF(buf, state);
+		if (!hexEq(buf, 
+			"8FE727775EA7F140B95BB6A200CBB28C"
+			"7F0809C0C0BC68B7DC5AEDC841BD94E4"
+			"03630C301FC255DF5B67DB53EF65E376"
+			"E8A4D797A6172F2271BA48093173D329"
+			"C3502AC946767326A2891971392D3F70"
+			"89959F5D61621238655975E00E2132A0"
+			"D5018CEEDB17731CCD88FC50151D37C0"
+			"D4A3359506AEDC2E6109511E7703AFBB"
+			"014642348D8568AA1A5D9868C4C7E6DF"
+			"A756B1690C7C2608A2DC136F5997AB8F"
+			"BB3F4D9F033C87CA6070E117F099C409"
+			"4972ACD9D976214B7CED8E3F8B6E058E"))
+		{
+			cpuCapsMask(SIZE_MAX);
+			return FALSE;
+		}
+	}
+	cpuCapsMask(SIZE_MAX);
 	// A.3.1
 	bash256Hash(hash, beltH(), 0);
 	if (!hexEq(hash, 
@@ -292,6 +625,15 @@ bool_t bashTest()
 	bashPrgSqueezeStep(buf + 14, 32 - 14, state);
 	if (!memEq(buf, hash, 32))
 		return FALSE;
+	// несколько состояний
+	if (!bashTestMulti())
+		return FALSE;
+	// выравнивание
+	if (!bashTestPrgAlign())
+		return FALSE;
+	// древовидное хэширование
+	if (!bashTestTree())
+		return FALSE;
 	// все нормально
 	return TRUE;
 }
@@ -4,7 +4,7 @@
 \brief Benchmarks for STB 34.101.31 (belt)
 \project bee2/test
 \created 2014.11.18
-\version 2025.09.28
+\version 2026.10.16
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
@@ -14,6 +14,7 @@
 #include <bee2/core/mem.h>
 #include <bee2/core/prng.h>
 #include <bee2/core/tm.h>
+#include <bee2/core/u32.h>
 #include <bee2/core/util.h>
 #include <bee2/crypto/belt.h>
 
@@ -26,12 +27,18 @@
 bool_t beltBench()
 {
 	const size_t reps = 5000;
-	mem_align_t belt_state[512 / sizeof(mem_align_t)];
+	mem_align_t belt_state[1024 / sizeof(mem_align_t)];
 	mem_align_t combo_state[64 / sizeof(mem_align_t)];
 	octet buf[1024];
 	octet key[32];
 	octet iv[16];
 	octet hash[32];
+	octet hashes[32 * 8];
+	const void* msgs[8];
+	size_t counts[8];
+	u16 strs[16 * 64];
+	u32 block_key[8];
+	u32 block[4];
 	size_t i;
 	tm_ticks_t ticks;
 	// подготовить стек
@@ -53,6 +60,20 @@ bool_t beltBench()
 	prngCOMBOStepR(buf, sizeof(buf), combo_state);
 	prngCOMBOStepR(key, sizeof(key), combo_state);
 	prngCOMBOStepR(iv, sizeof(iv), combo_state);
+	// cкорость belt-block (поблочное зашифрование, база для сравнения 
+	// с режимами, в которых блоки обрабатываются порциями)
+	beltKeyExpand2(block_key, key, 32);
+	u32From(block, iv, 16);
+	for (i = 0, ticks = tmTicks(); i < reps; ++i)
+	{
+		size_t j;
+		for (j = 0; j < 1024; j += 16)
+			beltBlockEncr2(block, block_key);
+	}
+	ticks = tmTicks() - ticks;
+	printf("beltBench::belt-block:%3u cpb [%5u kBytes/sec]\n",
+		(unsigned)(ticks / 1024 / reps),
+		(unsigned)tmSpeed(reps, ticks));
 	// cкорость belt-ecb
 	beltECBStart(belt_state, key, 32);
 	for (i = 0, ticks = tmTicks(); i < reps; ++i)
@@ -127,6 +148,26 @@ bool_t beltBench()
 	printf("beltBench::belt-hash: %3u cpb [%5u kBytes/sec]\n",
 		(unsigned)(ticks / 1024 / reps),
 		(unsigned)tmSpeed(reps, ticks));
+	// cкорость belt-hash (8 сообщений по 128 октетов)
+	for (i = 0; i < 8; ++i)
+		msgs[i] = buf + 128 * i, counts[i] = 128;
+	for (i = 0, ticks = tmTicks(); i < reps; ++i)
+	{
+		size_t j;
+		for (j = 0; j < 8; ++j)
+			beltHash(hashes + 32 * j, msgs[j], counts[j]);
+	}
+	ticks = tmTicks() - ticks;
+	printf("beltBench::belt-hash8:%3u cpb [%5u kBytes/sec]\n",
+		(unsigned)(ticks / 1024 / reps),
+		(unsigned)tmSpeed(reps, ticks));
+	// cкорость beltHashMulti (те же 8 сообщений)
+	for (i = 0, ticks = tmTicks(); i < reps; ++i)
+		beltHashMulti(hashes, msgs, counts, 8);
+	ticks = tmTicks() - ticks;
+	printf("beltBench::belt-hashM:%3u cpb [%5u kBytes/sec]\n",
+		(unsigned)(ticks / 1024 / reps),
+		(unsigned)tmSpeed(reps, ticks));
 	// cкорость belt-bde
 	beltBDEStart(belt_state, key, 32, iv);
 	for (i = 0, ticks = tmTicks(); i < reps; ++i)
@@ -145,6 +186,34 @@ bool_t beltBench()
 	printf("beltBench::belt-sde:  %3u cpb [%5u kBytes/sec]\n",
 		(unsigned)(ticks / 2048 / reps),
 		(unsigned)tmSpeed(2 * reps, ticks));
+	// cкорость belt-sde (пакет из 8 секторов по 128 октетов)
+	for (i = 0, ticks = tmTicks(); i < reps; ++i)
+		beltSDEEncrSectors(buf, buf, 128, 8, key, 32, iv, 1),
+		beltSDEDecrSectors(buf, buf, 128, 8, key, 32, iv, 1);
+	ticks = tmTicks() - ticks;
+	printf("beltBench::belt-sdeS: %3u cpb [%5u kBytes/sec]\n",
+		(unsigned)(ticks / 2048 / reps),
+		(unsigned)tmSpeed(2 * reps, ticks));
+	// cкорость belt-fmt (64 строки из 16 десятичных цифр)
+	for (i = 0; i < 16 * 64; ++i)
+		strs[i] = buf[i % sizeof(buf)] % 10;
+	for (i = 0, ticks = tmTicks(); i < reps / 50; ++i)
+	{
+		size_t j;
+		for (j = 0; j < 64; ++j)
+			beltFMTEncr(strs + 16 * j, 10, strs + 16 * j, 16, key, 32, iv);
+	}
+	ticks = tmTicks() - ticks;
+	printf("beltBench::belt-fmt:  %5u cycles/str [%5u str/sec]\n",
+		(unsigned)(ticks / 64 / (reps / 50)),
+		(unsigned)tmSpeed(64 * (reps / 50), ticks));
+	// cкорость beltFMTEncrBatch (те же 64 строки)
+	for (i = 0, ticks = tmTicks(); i < reps / 50; ++i)
+		beltFMTEncrBatch(strs, 10, strs, 16, 64, key, 32, 0, 1);
+	ticks = tmTicks() - ticks;
+	printf("beltBench::belt-fmtB: %5u cycles/str [%5u str/sec]\n",
+		(unsigned)(ticks / 64 / (reps / 50)),
+		(unsigned)tmSpeed(64 * (reps / 50), ticks));
 	// все нормально
 	return TRUE;
 }
@@ -4,12 +4,15 @@
 \brief Tests for STB 34.101.31 (belt)
 \project bee2/test
 \created 2012.06.20
-\version 2025.10.22
+\version 2026.10.16
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
 */
 
+#include <bee2/core/blob.h>
+#include <bee2/core/cpu.h>
+#include <bee2/core/err.h>
 #include <bee2/core/mem.h>
 #include <bee2/core/hex.h>
 #include <bee2/core/u32.h>
@@ -109,6 +112,827 @@ static bool_t beltTestZerosum()
 	return sum[0] == 0 && sum[1] == 0 && sum[2] == 0 && sum[3] == 0;
 }
 
+/*
+*******************************************************************************
+Многоблочная обработка
+
+В режимах ECB, CBC, CFB, CTR, BDE, CHE длинные фрагменты обрабатываются 
+порциями из нескольких блоков. В режимах DWP и CHE порциями из нескольких 
+блоков вычисляются также имитовставки. Результаты обработки одним 
+фрагментом сравниваются с результатами поблочной обработки.
+*******************************************************************************
+*/
+
+static bool_t beltTestMulti(octet buf[128], octet buf1[128], void* stack)
+{
+	const octet* key = beltH() + 128;
+	const octet* iv = beltH() + 192;
+	size_t i;
+	// belt-ecb
+	memCopy(buf, beltH(), 128);
+	beltECBStart(stack, key, 32);
+	beltECBStepE(buf, 128, stack);
+	memCopy(buf1, beltH(), 128);
+	for (i = 0; i < 128; i += 16)
+		beltECBStepE(buf1 + i, 16, stack);
+	if (!memEq(buf, buf1, 128))
+		return FALSE;
+	beltECBStepD(buf, 128, stack);
+	if (!memEq(buf, beltH(), 128))
+		return FALSE;
+	beltECBEncr(buf, beltH(), 100, key, 32);
+	beltECBDecr(buf, buf, 100, key, 32);
+	if (!memEq(buf, beltH(), 100))
+		return FALSE;
+	// belt-cbc
+	memCopy(buf, beltH(), 128);
+	beltCBCStart(stack, key, 32, iv);
+	beltCBCStepE(buf, 128, stack);
+	memCopy(buf1, buf, 128);
+	beltCBCStart(stack, key, 32, iv);
+	for (i = 0; i < 128; i += 16)
+		beltCBCStepD(buf1 + i, 16, stack);
+	if (!memEq(buf1, beltH(), 128))
+		return FALSE;
+	beltCBCStart(stack, key, 32, iv);
+	beltCBCStepD(buf, 128, stack);
+	if (!memEq(buf, beltH(), 128))
+		return FALSE;
+	for (i = 64; i <= 100; i += 9)
+	{
+		beltCBCEncr(buf, beltH(), i, key, 32, iv);
+		beltCBCDecr(buf, buf, i, key, 32, iv);
+		if (!memEq(buf, beltH(), i))
+			return FALSE;
+	}
+	// belt-cfb
+	memCopy(buf, beltH(), 128);
+	beltCFBStart(stack, key, 32, iv);
+	beltCFBStepE(buf, 128, stack);
+	memCopy(buf1, buf, 128);
+	beltCFBStart(stack, key, 32, iv);
+	beltCFBStepD(buf1, 3, stack);
+	beltCFBStepD(buf1 + 3, 125, stack);
+	if (!memEq(buf1, beltH(), 128))
+		return FALSE;
+	// belt-ctr
+	memCopy(buf, beltH(), 128);
+	beltCTRStart(stack, key, 32, iv);
+	beltCTRStepE(buf, 3, stack);
+	beltCTRStepE(buf + 3, 125, stack);
+	memCopy(buf1, beltH(), 128);
+	beltCTRStart(stack, key, 32, iv);
+	for (i = 0; i < 128; i += 16)
+		beltCTRStepE(buf1 + i, 16, stack);
+	if (!memEq(buf, buf1, 128))
+		return FALSE;
+	// belt-bde
+	memCopy(buf, beltH(), 128);
+	beltBDEStart(stack, key, 32, iv);
+	beltBDEStepE(buf, 128, stack);
+	memCopy(buf1, beltH(), 128);
+	beltBDEStart(stack, key, 32, iv);
+	for (i = 0; i < 128; i += 16)
+		beltBDEStepE(buf1 + i, 16, stack);
+	if (!memEq(buf, buf1, 128))
+		return FALSE;
+	beltBDEStart(stack, key, 32, iv);
+	beltBDEStepD(buf, 128, stack);
+	if (!memEq(buf, beltH(), 128))
+		return FALSE;
+	// belt-che
+	memCopy(buf, beltH(), 128);
+	beltCHEStart(stack, key, 32, iv);
+	beltCHEStepE(buf, 128, stack);
+	memCopy(buf1, beltH(), 128);
+	beltCHEStart(stack, key, 32, iv);
+	for (i = 0; i < 128; i += 16)
+		beltCHEStepE(buf1 + i, 16, stack);
+	if (!memEq(buf, buf1, 128))
+		return FALSE;
+	beltCHEStepA(buf, 128, stack);
+	beltCHEStepG(buf1, stack);
+	beltCHEStart(stack, key, 32, iv);
+	for (i = 0; i < 128; i += 16)
+		beltCHEStepA(buf + i, 16, stack);
+	beltCHEStepG(buf1 + 8, stack);
+	if (!memEq(buf1, buf1 + 8, 8))
+		return FALSE;
+	// belt-dwp
+	beltDWPStart(stack, key, 32, iv);
+	beltDWPStepI(buf, 100, stack);
+	beltDWPStepA(buf + 4, 124, stack);
+	beltDWPStepG(buf1, stack);
+	beltDWPStart(stack, key, 32, iv);
+	for (i = 0; i < 96; i += 16)
+		beltDWPStepI(buf + i, 16, stack);
+	beltDWPStepI(buf + 96, 4, stack);
+	beltDWPStepA(buf + 4, 12, stack);
+	for (i = 16; i < 128; i += 16)
+		beltDWPStepA(buf + i, 16, stack);
+	beltDWPStepG(buf1 + 8, stack);
+	if (!memEq(buf1, buf1 + 8, 8))
+		return FALSE;
+	// все нормально
+	return TRUE;
+}
+
+/*
+*******************************************************************************
+Подготовленный ключ
+
+Результаты обработки данных в состояниях, построенных по подготовленному 
+ключу (функции StartK), сравниваются с результатами обработки 
+в состояниях, построенных по исходному ключу (функции Start).
+*******************************************************************************
+*/
+
+static bool_t beltTestStartK(octet buf[128], octet buf1[128], void* stack)
+{
+	mem_align_t ks[64 / sizeof(mem_align_t)];
+	const octet* key = beltH() + 128;
+	const octet* iv = beltH() + 192;
+	if (sizeof(ks) < beltKey_keep())
+		return FALSE;
+	beltKeyStart(ks, key, 24);
+	// belt-ecb
+	memCopy(buf, beltH(), 128), memCopy(buf1, beltH(), 128);
+	beltECBStart(stack, key, 24);
+	beltECBStepE(buf, 128, stack);
+	beltECBStartK(stack, ks);
+	beltECBStepE(buf1, 128, stack);
+	if (!memEq(buf, buf1, 128))
+		return FALSE;
+	// belt-cbc
+	beltCBCStart(stack, key, 24, iv);
+	beltCBCStepE(buf, 128, stack);
+	beltCBCStartK(stack, ks, iv);
+	beltCBCStepE(buf1, 128, stack);
+	if (!memEq(buf, buf1, 128))
+		return FALSE;
+	// belt-cfb
+	beltCFBStart(stack, key, 24, iv);
+	beltCFBStepE(buf, 128, stack);
+	beltCFBStartK(stack, ks, iv);
+	beltCFBStepE(buf1, 128, stack);
+	if (!memEq(buf, buf1, 128))
+		return FALSE;
+	// belt-ctr
+	beltCTRStart(stack, key, 24, iv);
+	beltCTRStepE(buf, 128, stack);
+	beltCTRStartK(stack, ks, iv);
+	beltCTRStepE(buf1, 128, stack);
+	if (!memEq(buf, buf1, 128))
+		return FALSE;
+	// belt-mac
+	beltMACStart(stack, key, 24);
+	beltMACStepA(buf, 100, stack);
+	beltMACStepG(buf, stack);
+	beltMACStartK(stack, ks);
+	beltMACStepA(buf1, 100, stack);
+	beltMACStepG(buf1, stack);
+	if (!memEq(buf, buf1, 128))
+		return FALSE;
+	// belt-dwp
+	beltDWPStart(stack, key, 24, iv);
+	beltDWPStepI(iv, 16, stack);
+	beltDWPStepEA(buf, 120, stack);
+	beltDWPStepG(buf + 120, stack);
+	beltDWPStartK(stack, ks, iv);
+	beltDWPStepI(iv, 16, stack);
+	beltDWPStepEA(buf1, 120, stack);
+	beltDWPStepG(buf1 + 120, stack);
+	if (!memEq(buf, buf1, 128))
+		return FALSE;
+	// belt-che
+	beltCHEStart(stack, key, 24, iv);
+	beltCHEStepI(iv, 16, stack);
+	beltCHEStepEA(buf, 120, stack);
+	beltCHEStepG(buf + 120, stack);
+	beltCHEStartK(stack, ks, iv);
+	beltCHEStepI(iv, 16, stack);
+	beltCHEStepEA(buf1, 120, stack);
+	beltCHEStepG(buf1 + 120, stack);
+	if (!memEq(buf, buf1, 128))
+		return FALSE;
+	// все нормально
+	memWipe(ks, sizeof(ks));
+	return TRUE;
+}
+
+/*
+*******************************************************************************
+Многопоточная обработка
+
+Результаты многопоточного шифрования длинного буфера (несколько фрагментов 
+по 64 Кбайт и неполный блок) сравниваются с результатами однопоточного. 
+Результаты пакетного шифрования секторов сравниваются с результатами 
+шифрования отдельных секторов.
+*******************************************************************************
+*/
+
+static bool_t beltTestSectors(octet buf[], octet buf1[], size_t n)
+{
+	const octet* key = beltH() + 128;
+	octet iv[16];
+	octet iv1[16];
+	size_t i, j;
+	// синхропосылка с переносами при увеличении
+	memCopy(iv, beltH() + 192, 16);
+	iv[0] = 0xF0, iv[1] = 0xFF;
+	for (i = 0; i < 512 * n; ++i)
+		buf[i] = beltH()[i % 256];
+	// belt-bde
+	if (beltBDEEncrSectors(buf1, buf, 512, n, key, 32, iv, 3) != ERR_OK)
+		return FALSE;
+	for (memCopy(iv1, iv, 16), i = 0; i < n; ++i)
+	{
+		if (beltBDEDecr(buf1 + 512 * i, buf1 + 512 * i, 512, key, 32, 
+				iv1) != ERR_OK)
+			return FALSE;
+		for (j = 0; j < 16 && ++iv1[j] == 0; ++j);
+	}
+	if (!memEq(buf, buf1, 512 * n) ||
+		beltBDEEncrSectors(buf1, buf, 512, n, key, 32, iv, 2) != ERR_OK ||
+		beltBDEDecrSectors(buf1, buf1, 512, n, key, 32, iv, 4) != ERR_OK ||
+		!memEq(buf, buf1, 512 * n))
+		return FALSE;
+	// belt-sde
+	if (beltSDEEncrSectors(buf1, buf, 512, n, key, 32, iv, 3) != ERR_OK)
+		return FALSE;
+	for (memCopy(iv1, iv, 16), i = 0; i < n; ++i)
+	{
+		if (beltSDEDecr(buf1 + 512 * i, buf1 + 512 * i, 512, key, 32, 
+				iv1) != ERR_OK)
+			return FALSE;
+		for (j = 0; j < 16 && ++iv1[j] == 0; ++j);
+	}
+	if (!memEq(buf, buf1, 512 * n) ||
+		beltSDEEncrSectors(buf1, buf, 512, n, key, 32, iv, 1) != ERR_OK ||
+		beltSDEDecrSectors(buf1, buf1, 512, n, key, 32, iv, 5) != ERR_OK ||
+		!memEq(buf, buf1, 512 * n))
+		return FALSE;
+	// belt-sde: короткие секторы (базовые такты WBL)
+	for (i = 32; i <= 80; i += 16)
+	{
+		if (beltSDEEncrSectors(buf1, buf, i, 11, key, 32, iv, 2) != ERR_OK)
+			return FALSE;
+		for (memCopy(iv1, iv, 16), j = 0; j < 11; ++j)
+		{
+			size_t t;
+			if (beltSDEDecr(buf1 + i * j, buf1 + i * j, i, key, 32, 
+					iv1) != ERR_OK)
+				return FALSE;
+			for (t = 0; t < 16 && ++iv1[t] == 0; ++t);
+		}
+		if (!memEq(buf, buf1, i * 11) ||
+			beltSDEEncrSectors(buf1, buf, i, 11, key, 32, iv, 1) != ERR_OK ||
+			beltSDEDecrSectors(buf1, buf1, i, 11, key, 32, iv, 1) != ERR_OK ||
+			!memEq(buf, buf1, i * 11))
+			return FALSE;
+	}
+	// все нормально
+	return TRUE;
+}
+
+static bool_t beltTestMT()
+{
+	const size_t count = 4 * 65536 + 3 * 16 + 5;
+	const octet* key = beltH() + 128;
+	const octet* iv = beltH() + 192;
+	void* state;
+	octet* buf;		/* [count] */
+	octet* buf1;	/* [count] */
+	size_t i;
+	bool_t ret;
+	// создать состояние
+	state = blobCreate2(
+		count, 
+		count, 
+		SIZE_MAX,
+		&buf, &buf1);
+	if (state == 0)
+		return FALSE;
+	// belt-ctr
+	for (i = 0; i < count; ++i)
+		buf[i] = beltH()[i % 256];
+	if (beltCTR(buf1, buf, count, key, 32, iv) != ERR_OK ||
+		beltCTRParallel(buf, buf, count, key, 32, iv, 3) != ERR_OK ||
+		!memEq(buf, buf1, count))
+	{
+		blobClose(state);
+		return FALSE;
+	}
+	// belt-ctr: пересекающиеся буферы
+	if (beltCTRParallel(buf + 1, buf, count - 1, key, 32, iv, 4) != ERR_OK)
+	{
+		blobClose(state);
+		return FALSE;
+	}
+	for (i = 1; i < count; ++i)
+		if (buf[i] != beltH()[(i - 1) % 256])
+		{
+			blobClose(state);
+			return FALSE;
+		}
+	// belt-ecb
+	if (beltECBEncr(buf1, buf, count, key, 32) != ERR_OK ||
+		beltECBEncrParallel(buf, buf, count, key, 32, 8) != ERR_OK ||
+		!memEq(buf, buf1, count) ||
+		beltECBDecrParallel(buf, buf, count, key, 32, 5) != ERR_OK ||
+		beltECBDecr(buf1, buf1, count, key, 32) != ERR_OK ||
+		!memEq(buf, buf1, count))
+	{
+		blobClose(state);
+		return FALSE;
+	}
+	// belt-bde, belt-sde: секторы
+	ret = beltTestSectors(buf, buf1, count / 512);
+	// завершить
+	blobClose(state);
+	return ret;
+}
+
+/*
+*******************************************************************************
+Обработка нескольких потоков
+
+Результаты beltCBCStepEMulti() и beltMACStepAMulti() сравниваются 
+с результатами обработки отдельных потоков. Потоки используют разные 
+ключи, имеют разные длины (в том числе неполные блоки) и 
+обрабатываются в два приема.
+*******************************************************************************
+*/
+
+#define beltTestMultiStream_local(count, keep)\
+/* buf */	count,\
+/* buf1 */	count,\
+/* stack */	11 * keep
+
+static bool_t beltTestMultiStream()
+{
+	mem_align_t state[16384 / sizeof(mem_align_t)];
+	const size_t len[11] = { 16, 33, 0, 48, 17, 200, 31, 64, 5, 129, 1000 };
+	const size_t count = 1543;
+	const size_t keep = MAX2(beltCBC_keep(), beltMAC_keep());
+	octet* buf;			/* [count] */
+	octet* buf1;		/* [count] */
+	void* stack;		/* [11 * keep] */
+	void* states[11];
+	void* bufs[11];
+	size_t counts[11];
+	size_t total, i;
+	octet mac[8];
+	// разметить состояние
+	if (sizeof(state) < memSliceSize(
+			beltTestMultiStream_local(count, keep),
+			SIZE_MAX))
+		return FALSE;
+	memSlice(state,
+		beltTestMultiStream_local(count, keep), SIZE_MAX,
+		&buf, &buf1, &stack);
+	for (i = 0; i < 11; ++i)
+		states[i] = (octet*)stack + i * keep;
+	for (i = 0; i < count; ++i)
+		buf[i] = beltH()[(7 * i) % 256];
+	memCopy(buf1, buf, count);
+	// belt-cbc: первый прием (по одному блоку при len[i] >= 32)
+	for (total = i = 0; i < 11; total += len[i++])
+	{
+		beltCBCStart(states[i], beltH() + i, 32, beltH() + 128 + i);
+		bufs[i] = buf1 + total;
+		counts[i] = len[i] >= 32 ? 16 : 0;
+	}
+	beltCBCStepEMulti(bufs, counts, states, 11);
+	// belt-cbc: второй прием
+	for (i = 0; i < 11; ++i)
+	{
+		bufs[i] = (octet*)bufs[i] + counts[i];
+		counts[i] = len[i] < 16 ? 0 : len[i] - counts[i];
+	}
+	beltCBCStepEMulti(bufs, counts, states, 11);
+	for (total = i = 0; i < 11; total += len[i++])
+	{
+		if (len[i] < 16)
+			continue;
+		beltCBCStart(states[0], beltH() + i, 32, beltH() + 128 + i);
+		beltCBCStepE(buf + total, len[i], states[0]);
+		if (!memEq(buf + total, buf1 + total, len[i]))
+			return FALSE;
+	}
+	// belt-mac: два приема
+	for (total = i = 0; i < 11; total += len[i++])
+	{
+		beltMACStart(states[i], beltH() + i, 32);
+		bufs[i] = buf + total;
+		counts[i] = len[i] / 3;
+	}
+	beltMACStepAMulti((const void**)bufs, counts, states, 11);
+	for (i = 0; i < 11; ++i)
+	{
+		bufs[i] = (octet*)bufs[i] + counts[i];
+		counts[i] = len[i] - counts[i];
+	}
+	beltMACStepAMulti((const void**)bufs, counts, states, 11);
+	for (total = i = 0; i < 11; total += len[i++])
+	{
+		beltMACStepG(mac, states[i]);
+		if (beltMAC(buf1, buf + total, len[i], beltH() + i, 32) != ERR_OK ||
+			!memEq(mac, buf1, 8))
+			return FALSE;
+	}
+	// все нормально
+	return TRUE;
+}
+
+/*
+*******************************************************************************
+Пакетное шифрование с сохранением формата
+
+Результаты beltFMTEncrBatch() сравниваются с результатами beltFMTEncr(). 
+Проверяются сочетания (mod, count), при которых строки обрабатываются 
+группами (b1 == b2 == 1) и по одной.
+*******************************************************************************
+*/
+
+#define beltTestFMTBatch_local(n)\
+/* str */	2 * 21 * n,\
+/* str1 */	2 * 21 * n,\
+/* iv */	16 * n
+
+static bool_t beltTestFMTBatch()
+{
+	mem_align_t state[16384 / sizeof(mem_align_t)];
+	const u32 mods[3] = { 10, 65536, 58 };
+	const size_t counts[3] = { 16, 5, 21 };
+	const size_t ns[3] = { 150, 150, 15 };
+	u16* str;		/* [21 * 150] */
+	u16* str1;		/* [21 * 150] */
+	octet* iv;		/* [16 * 150] */
+	u32 mod;
+	size_t count, n;
+	size_t pos, i;
+	// разметить состояние
+	if (sizeof(state) < memSliceSize(
+			beltTestFMTBatch_local(150),
+			SIZE_MAX))
+		return FALSE;
+	memSlice(state,
+		beltTestFMTBatch_local(150), SIZE_MAX,
+		&str, &str1, &iv);
+	// сочетания (mod, count, n)
+	for (pos = 0; pos < COUNT_OF(mods); ++pos)
+	{
+		mod = mods[pos], count = counts[pos], n = ns[pos];
+		for (i = 0; i < count * n; ++i)
+			str[i] = (u16)((7 * i + 3) % mod);
+		for (i = 0; i < 16 * n; ++i)
+			iv[i] = beltH()[(5 * i) % 256] ^ (octet)(i / 256);
+		if (beltFMTEncrBatch(str1, mod, str, count, n, beltH() + 128, 32, 
+				iv, 2) != ERR_OK)
+			return FALSE;
+		for (i = 0; i < n; ++i)
+			if (beltFMTDecr(str1 + count * i, mod, str1 + count * i, count, 
+					beltH() + 128, 32, iv + 16 * i) != ERR_OK)
+				return FALSE;
+		if (!memEq(str, str1, 2 * count * n) ||
+			beltFMTEncrBatch(str1, mod, str, count, n, beltH() + 128, 32, 
+				0, 3) != ERR_OK ||
+			beltFMTEncr(str, mod, str, count, beltH() + 128, 32, 
+				0) != ERR_OK ||
+			!memEq(str, str1, 2 * count) ||
+			beltFMTDecrBatch(str1, mod, str1, count, n, beltH() + 128, 32, 
+				0, 1) != ERR_OK ||
+			beltFMTDecr(str, mod, str, count, beltH() + 128, 32, 
+				0) != ERR_OK ||
+			!memEq(str, str1, 2 * count * n))
+			return FALSE;
+	}
+	// все нормально
+	return TRUE;
+}
+
+/*
+*******************************************************************************
+Пакетная защита ключей
+
+Результаты beltKWPWrapBatch() сравниваются с результатами beltKWPWrap(). 
+При снятии защиты два защищенных ключа искажаются: для них должны 
+возвращаться ошибки, а остальные ключи должны обрабатываться корректно.
+*******************************************************************************
+*/
+
+#define beltTestKWPBatch_local(n)\
+/* keys */		32 * n,\
+/* tokens */	48 * n,\
+/* keys1 */		32 * n,\
+/* header */	16 * n,\
+/* rets */		sizeof(err_t) * n
+
+static bool_t beltTestKWPBatch()
+{
+	mem_align_t state[20480 / sizeof(mem_align_t)];
+	const size_t n = 150;
+	const octet* key = beltH() + 128;
+	octet* keys;		/* [32 * n] */
+	octet* tokens;		/* [48 * n] */
+	octet* keys1;		/* [32 * n] */
+	octet* header;		/* [16 * n] */
+	err_t* rets;		/* [n] */
+	size_t i;
+	// разметить состояние
+	if (sizeof(state) < memSliceSize(
+			beltTestKWPBatch_local(n),
+			SIZE_MAX))
+		return FALSE;
+	memSlice(state,
+		beltTestKWPBatch_local(n), SIZE_MAX,
+		&keys, &tokens, &keys1, &header, &rets);
+	for (i = 0; i < 32 * n; ++i)
+		keys[i] = beltH()[(3 * i) % 256] ^ (octet)(i / 256);
+	for (i = 0; i < 16 * n; ++i)
+		header[i] = beltH()[(5 * i + 1) % 256] ^ (octet)(i / 256);
+	// установить защиту
+	if (beltKWPWrapBatch(tokens, keys, 32, n, header, key, 32, 
+			3) != ERR_OK)
+		return FALSE;
+	for (i = 0; i < n; ++i)
+		if (beltKWPWrap(keys1, keys + 32 * i, 32, header + 16 * i, key, 
+				32) != ERR_OK ||
+			!memEq(keys1, tokens + 48 * i, 48))
+			return FALSE;
+	// снять защиту
+	if (beltKWPUnwrapBatch(keys1, rets, tokens, 48, n, header, key, 32, 
+			2) != ERR_OK ||
+		!memEq(keys, keys1, 32 * n))
+		return FALSE;
+	// исказить ключи 7 и n - 1
+	tokens[48 * 7 + 3] ^= 1;
+	tokens[48 * (n - 1) + 47] ^= 0x80;
+	if (beltKWPUnwrapBatch(keys1, rets, tokens, 48, n, header, key, 32, 
+			4) != ERR_BAD_KEYTOKEN)
+		return FALSE;
+	for (i = 0; i < n; ++i)
+		if (i == 7 || i == n - 1)
+		{
+			if (rets[i] != ERR_BAD_KEYTOKEN || 
+				!memIsZero(keys1 + 32 * i, 32))
+				return FALSE;
+		}
+		else if (rets[i] != ERR_OK || 
+			!memEq(keys + 32 * i, keys1 + 32 * i, 32))
+			return FALSE;
+	// нулевые заголовки
+	if (beltKWPWrapBatch(tokens, keys, 32, n, 0, key, 32, 1) != ERR_OK ||
+		beltKWPWrap(keys1, keys + 32, 32, 0, key, 32) != ERR_OK ||
+		!memEq(keys1, tokens + 48, 48) ||
+		beltKWPUnwrapBatch(keys1, rets, tokens, 48, n, 0, key, 32, 
+			1) != ERR_OK ||
+		!memEq(keys, keys1, 32 * n))
+		return FALSE;
+	// ключи неполной длины (21 октет)
+	if (beltKWPWrapBatch(tokens, keys, 21, 11, header, key, 32, 
+			1) != ERR_OK ||
+		beltKWPUnwrapBatch(keys1, rets, tokens, 37, 11, header, key, 32, 
+			1) != ERR_OK ||
+		!memEq(keys, keys1, 21 * 11))
+		return FALSE;
+	for (i = 0; i < 11; ++i)
+		if (beltKWPWrap(keys1, keys + 21 * i, 21, header + 16 * i, key, 
+				32) != ERR_OK ||
+			!memEq(keys1, tokens + 37 * i, 37))
+			return FALSE;
+	// все нормально
+	return TRUE;
+}
+
+/*
+*******************************************************************************
+Построение ключей по нескольким паролям
+
+Результаты beltPBKDF2Multi() сравниваются с результатами beltPBKDF2(). 
+Среди паролей есть пустой и длинный (длиннее 32 октетов). Часть паролей 
+строится на одной синхропосылке.
+*******************************************************************************
+*/
+
+static bool_t beltTestPBKDF2Multi()
+{
+	const octet* pwd[19];
+	size_t pwd_len[19];
+	const octet* salt[19];
+	size_t salt_len[19];
+	octet key[32 * 19];
+	octet key1[32];
+	size_t iter, i;
+	for (i = 0; i < 19; ++i)
+	{
+		pwd[i] = beltH() + 7 * i;
+		pwd_len[i] = 5 * i;
+		salt[i] = beltH() + 128 + (i % 3) * 8;
+		salt_len[i] = 8 + (i % 3);
+	}
+	for (iter = 1; iter <= 33; iter += 16)
+	{
+		if (beltPBKDF2Multi(key, pwd, pwd_len, iter, salt, salt_len, 19, 
+				1 + iter % 3) != ERR_OK)
+			return FALSE;
+		for (i = 0; i < 19; ++i)
+		{
+			if (beltPBKDF2(key1, pwd[i], pwd_len[i], iter, salt[i], 
+					salt_len[i]) != ERR_OK ||
+				!memEq(key + 32 * i, key1, 32))
+				return FALSE;
+		}
+	}
+	// все нормально
+	return TRUE;
+}
+
+/*
+*******************************************************************************
+Совмещенные шифрование и имитозащита
+
+Результаты совмещенной обработки длинного буфера (несколько порций 
+BELT_EA_SIZE и неполный блок) функциями StepEA, StepAD, Wrap, Unwrap 
+режимов DWP и CHE сравниваются с результатами раздельной обработки. 
+Кроме этого, имитовставки, выработанные с отключенной возможностью 
+CPU_PCLMUL, проверяются без отключения.
+*******************************************************************************
+*/
+
+#define beltTestEA_local(count)\
+/* buf */	count,\
+/* buf1 */	count,\
+/* buf2 */	count
+
+static bool_t beltTestEA()
+{
+	mem_align_t state[16384 / sizeof(mem_align_t)];
+	const size_t count = 3 * 1024 + 3 * 16 + 5;
+	const octet* key = beltH() + 128;
+	const octet* iv = beltH() + 192;
+	octet mac[8];
+	octet mac1[8];
+	octet* buf;			/* [count] */
+	octet* buf1;		/* [count] */
+	octet* buf2;		/* [count] */
+	void* stack;
+	size_t i;
+	// разметить состояние
+	if (sizeof(state) < memSliceSize(
+			beltTestEA_local(count),
+			utilMax(2,
+				beltDWP_keep(),
+				beltCHE_keep()),
+			SIZE_MAX))
+		return FALSE;
+	memSlice(state,
+		beltTestEA_local(count), SIZE_0, SIZE_MAX,
+		&buf, &buf1, &buf2, &stack);
+	for (i = 0; i < count; ++i)
+		buf[i] = beltH()[i % 256];
+	// belt-dwp
+	beltDWPStart(stack, key, 32, iv);
+	beltDWPStepI(beltH(), 33, stack);
+	memCopy(buf1, buf, count);
+	beltDWPStepE(buf1, count, stack);
+	beltDWPStepA(buf1, count, stack);
+	beltDWPStepG(mac, stack);
+	beltDWPStart(stack, key, 32, iv);
+	beltDWPStepI(beltH(), 33, stack);
+	memCopy(buf2, buf, count);
+	beltDWPStepEA(buf2, 7, stack);
+	beltDWPStepEA(buf2 + 7, count - 7, stack);
+	beltDWPStepG(mac1, stack);
+	if (!memEq(buf1, buf2, count) || !memEq(mac, mac1, 8))
+		return FALSE;
+	beltDWPStart(stack, key, 32, iv);
+	beltDWPStepI(beltH(), 33, stack);
+	beltDWPStepAD(buf2, count, stack);
+	if (!beltDWPStepV(mac, stack) || !memEq(buf2, buf, count))
+		return FALSE;
+	if (beltDWPWrap(buf2, mac1, buf, count, beltH(), 33, key, 32, iv) != 
+			ERR_OK ||
+		!memEq(buf1, buf2, count) || !memEq(mac, mac1, 8) ||
+		beltDWPUnwrap(buf2, buf1, count, beltH(), 33, mac, key, 32, iv) != 
+			ERR_OK ||
+		!memEq(buf2, buf, count) ||
+		beltDWPUnwrap(buf1, buf1, count, beltH(), 33, mac, key, 32, iv) != 
+			ERR_OK ||
+		!memEq(buf1, buf, count))
+		return FALSE;
+	mac1[0] ^= 1;
+	if (beltDWPUnwrap(buf1, buf2, count, beltH(), 33, mac1, key, 32, iv) != 
+			ERR_BAD_MAC ||
+		!memIsZero(buf1, count))
+		return FALSE;
+	// belt-che
+	beltCHEStart(stack, key, 32, iv);
+	beltCHEStepI(beltH(), 33, stack);
+	memCopy(buf1, buf, count);
+	beltCHEStepE(buf1, count, stack);
+	beltCHEStepA(buf1, count, stack);
+	beltCHEStepG(mac, stack);
+	beltCHEStart(stack, key, 32, iv);
+	beltCHEStepI(beltH(), 33, stack);
+	memCopy(buf2, buf, count);
+	beltCHEStepEA(buf2, 7, stack);
+	beltCHEStepEA(buf2 + 7, count - 7, stack);
+	beltCHEStepG(mac1, stack);
+	if (!memEq(buf1, buf2, count) || !memEq(mac, mac1, 8))
+		return FALSE;
+	beltCHEStart(stack, key, 32, iv);
+	beltCHEStepI(beltH(), 33, stack);
+	beltCHEStepAD(buf2, count, stack);
+	if (!beltCHEStepV(mac, stack) || !memEq(buf2, buf, count))
+		return FALSE;
+	if (beltCHEWrap(buf2, mac1, buf, count, beltH(), 33, key, 32, iv) != 
+			ERR_OK ||
+		!memEq(buf1, buf2, count) || !memEq(mac, mac1, 8) ||
+		beltCHEUnwrap(buf2, buf1, count, beltH(), 33, mac, key, 32, iv) != 
+			ERR_OK ||
+		!memEq(buf2, buf, count) ||
+		beltCHEUnwrap(buf1, buf1, count, beltH(), 33, mac, key, 32, iv) != 
+			ERR_OK ||
+		!memEq(buf1, buf, count))
+		return FALSE;
+	mac1[0] ^= 1;
+	if (beltCHEUnwrap(buf1, buf2, count, beltH(), 33, mac1, key, 32, iv) != 
+			ERR_BAD_MAC ||
+		!memIsZero(buf1, count))
+		return FALSE;
+	// без PCLMULQDQ
+	cpuCapsMask(SIZE_MAX ^ CPU_PCLMUL);
+	beltDWPWrap(buf1, mac, buf, count, beltH(), 33, key, 32, iv);
+	beltCHEWrap(buf2, mac1, buf, count, beltH(), 33, key, 32, iv);
+	cpuCapsMask(SIZE_MAX);
+	if (beltDWPUnwrap(buf1, buf1, count, beltH(), 33, mac, key, 32, iv) != 
+			ERR_OK ||
+		!memEq(buf1, buf, count) ||
+		beltCHEUnwrap(buf2, buf2, count, beltH(), 33, mac1, key, 32, iv) != 
+			ERR_OK ||
+		!memEq(buf2, buf, count))
+		return FALSE;
+	// все нормально
+	return TRUE;
+}
+
+/*
+*******************************************************************************
+Хэширование нескольких сообщений
+
+Хэш-значения сообщений разной длины, обработанных совместно (за один 
+раз и по частям), сравниваются с результатами beltHash().
+*******************************************************************************
+*/
+
+static bool_t beltTestHashMulti()
+{
+	const void* src[19];
+	size_t count[19];
+	size_t count1[19];
+	octet hash[32 * 19];
+	octet hash1[32];
+	void* state;
+	size_t i;
+	bool_t ret = TRUE;
+	// подготовить сообщения
+	for (i = 0; i < 19; ++i)
+	{
+		src[i] = beltH() + 3 * i;
+		count[i] = (i * 37) % 200;
+	}
+	// хэшировать за один раз
+	if (beltHashMulti(hash, src, count, 19) != ERR_OK)
+		return FALSE;
+	for (i = 0; i < 19; ++i)
+		if (beltHash(hash1, src[i], count[i]) != ERR_OK ||
+			!memEq(hash + 32 * i, hash1, 32))
+			return FALSE;
+	// хэшировать по частям
+	if (!(state = blobCreate(beltHashMulti_keep(19))))
+		return FALSE;
+	beltHashMultiStart(state, 19);
+	for (i = 0; i < 19; ++i)
+		count1[i] = count[i] / 3;
+	beltHashMultiStepH(src, count1, state);
+	beltHashMultiStepG(hash, state);
+	for (i = 0; i < 19; ++i)
+	{
+		src[i] = (const octet*)src[i] + count1[i];
+		count1[i] = count[i] - count1[i];
+	}
+	beltHashMultiStepH(src, count1, state);
+	beltHashMultiStepG(hash, state);
+	for (i = 0; i < 19; ++i)
+		if (beltHash(hash1, beltH() + 3 * i, count[i]) != ERR_OK ||
+			!memEq(hash + 32 * i, hash1, 32))
+			ret = FALSE;
+	blobClose(state);
+	return ret;
+}
+
 /*
 *******************************************************************************
 Самотестирование
@@ -116,7 +940,8 @@ static bool_t beltTestZerosum()
 -#	Выполняются тесты из приложения A к СТБ 34.101.31 (редакция 2018 года) 
 	и из приложения Б к СТБ 34.101.47.
 -#	Номера тестов соответствуют номерам таблиц приложений.
--#	Дополнительно выполняется тест Zerosum.
+-#	Дополнительно выполняются тест Zerosum, тесты многоблочной 
+	и многопоточной обработки, тест хэширования нескольких сообщений.
 *******************************************************************************
 */
 
@@ -449,6 +1274,19 @@ bool_t beltTest()
 		beltH() + 192 + 16);
 	if (!memEq(buf, buf1, 44))
 		return FALSE;
+	// belt-ctr: позиционирование
+	beltCTR(buf1, beltH(), 128, beltH() + 128, 32, beltH() + 192);
+	memCopy(buf, beltH(), 128);
+	beltCTRStart(stack, beltH() + 128, 32, beltH() + 192);
+	beltCTRSeek(stack, 5);
+	beltCTRStepE(buf + 80, 48, stack);
+	beltCTRSeek(stack, 0);
+	beltCTRStepE(buf, 21, stack);
+	memCopy(buf + 16, beltH() + 16, 5);
+	beltCTRSeek(stack, 1);
+	beltCTRStepE(buf + 16, 64, stack);
+	if (!memEq(buf, buf1, 128))
+		return FALSE;
 	// belt-mac: тест A.17-1
 	beltMACStart(stack, beltH() + 128, 32);
 	beltMACStepA(beltH(), 13, stack);
@@ -741,6 +1579,9 @@ bool_t beltTest()
 		if (!memEq(str, str1, 9 * 2))
 			return FALSE;
 	}
+	// belt-fmt: пакетная обработка
+	if (!beltTestFMTBatch())
+		return FALSE;
 	// belt-keyexpand: тест A.27-1
 	beltKeyExpand(buf, beltH() + 128, 16);
 	if (!hexEq(buf,
@@ -819,9 +1660,43 @@ bool_t beltTest()
 	beltHMAC(hash1, beltH() + 128 + 64, 32, beltH() + 128, 42);
 	if (!memEq(hash, hash1, 32))
 		return FALSE;
+	// belt-hmac: тест Б.1-3 [+ перезапуск]
+	beltHMACStepA(beltH(), 47, stack);
+	beltHMACRestart(stack);
+	beltHMACStepA(beltH() + 128 + 64, 32, stack);
+	if (!beltHMACStepV(hash, stack))
+		return FALSE;
+	beltHMACRestart(stack);
+	beltHMACStepA(beltH() + 128 + 64, 32, stack);
+	if (!beltHMACStepV(hash, stack))
+		return FALSE;
 	// zerosum
 	if (!beltTestZerosum())
 		return FALSE;
+	// многоблочная обработка
+	if (!beltTestMulti(buf, buf1, stack))
+		return FALSE;
+	// подготовленный ключ
+	if (!beltTestStartK(buf, buf1, stack))
+		return FALSE;
+	// многопоточная обработка
+	if (!beltTestMT())
+		return FALSE;
+	// обработка нескольких потоков
+	if (!beltTestMultiStream())
+		return FALSE;
+	// пакетная защита ключей
+	if (!beltTestKWPBatch())
+		return FALSE;
+	// построение ключей по нескольким паролям
+	if (!beltTestPBKDF2Multi())
+		return FALSE;
+	// совмещенные шифрование и имитозащита
+	if (!beltTestEA())
+		return FALSE;
+	// хэширование нескольких сообщений
+	if (!beltTestHashMulti())
+		return FALSE;
 	// все нормально
 	return TRUE;
 }
@@ -4,12 +4,13 @@
 \brief Tests for Bign128
 \project bee2/test
 \created 2026.03.06
-\version 2026.03.06
+\version 2026.10.16
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
 */
 
+#include <bee2/core/err.h>
 #include <bee2/core/mem.h>
 #include <bee2/core/hex.h>
 #include <bee2/core/util.h>
@@ -161,6 +162,13 @@ bool_t bign128Test()
 		"8F112CC23E6DCE65EC5FF21DF4231C28") ||
 		bign128Verify(hash, sig, pubkey) != ERR_OK)
 		return FALSE;
+	// повторная проверка (с предвычислениями для pubkey)
+	sig[0] ^= 1;
+	if (bign128Verify(hash, sig, pubkey) != ERR_BAD_SIG)
+		return FALSE;
+	sig[0] ^= 1;
+	if (bign128Verify(hash, sig, pubkey) != ERR_OK)
+		return FALSE;
 	// тест Г.5
 	if (bignKeyWrap(token, params, beltH(), 32, beltH() + 64,
 		pubkey, brngCTRXStepR, state) != ERR_OK ||
@@ -4,12 +4,13 @@
 \brief Tests for Bign256
 \project bee2/test
 \created 2026.03.06
-\version 2026.03.06
+\version 2026.10.16
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
 */
 
+#include <bee2/core/err.h>
 #include <bee2/core/mem.h>
 #include <bee2/core/hex.h>
 #include <bee2/core/prng.h>
@@ -30,8 +31,12 @@ bool_t bign256Test()
 	octet pubkey[128];
 	octet pubkey1[128];
 	octet sig[96];
+	octet sigs[3 * 96];
+	octet pubkeys[3 * 128];
+	err_t rets[3];
 	octet token[20 + 16 + 64];
 	mem_align_t state[64 / sizeof(mem_align_t)];
+	mem_align_t state1[64 / sizeof(mem_align_t)];
 	// подготовить память
 	if (sizeof(state) < prngCOMBO_keep())
 		return FALSE;
@@ -58,6 +63,41 @@ bool_t bign256Test()
 		bign256Sign2(sig, beltH(), privkey, 0, 0) != ERR_OK ||
 		bign256Verify(beltH(), sig, pubkey) != ERR_OK)
 		return FALSE;
+	// повторная проверка ЭЦП (с предвычислениями для pubkey)
+	if (bign256Verify(beltH(), sig, pubkey) != ERR_OK)
+		return FALSE;
+	sig[0] ^= 1;
+	if (bign256Verify(beltH(), sig, pubkey) != ERR_BAD_SIG)
+		return FALSE;
+	sig[0] ^= 1;
+	// пакетная проверка ЭЦП
+	if (bign256Sign2(sigs, beltH(), privkey, 0, 0) != ERR_OK ||
+		bign256Sign2(sigs + 96, beltH() + 64, privkey, 0, 0) != ERR_OK ||
+		bign256Sign2(sigs + 192, beltH() + 128, privkey, 0, 0) != ERR_OK)
+		return FALSE;
+	memCopy(pubkeys, pubkey, 128);
+	memCopy(pubkeys + 128, pubkey, 128);
+	memCopy(pubkeys + 256, pubkey, 128);
+	if (bign256VerifyBatch(rets, beltH(), sigs, pubkeys, 3, 2) != ERR_OK ||
+		rets[0] != ERR_OK || rets[1] != ERR_OK || rets[2] != ERR_OK)
+		return FALSE;
+	sigs[96] ^= 1;
+	if (bign256VerifyBatch(rets, beltH(), sigs, pubkeys, 3, 2) != 
+			ERR_BAD_SIG ||
+		rets[0] != ERR_OK || rets[1] != ERR_BAD_SIG || rets[2] != ERR_OK)
+		return FALSE;
+	// пакетная выработка ЭЦП
+	memCopy(state1, state, sizeof(state));
+	if (bign256SignBatch(sigs, beltH(), 3, privkey, prngCOMBOStepR, 
+			state, 2) != ERR_OK ||
+		bign256Sign(sig, beltH(), privkey, prngCOMBOStepR, 
+			state1) != ERR_OK ||
+		!memEq(sig, sigs, 96) ||
+		bign256Sign(sig, beltH() + 64, privkey, prngCOMBOStepR, 
+			state1) != ERR_OK ||
+		!memEq(sig, sigs + 96, 96) ||
+		bign256Verify(beltH() + 128, sigs + 192, pubkey) != ERR_OK)
+		return FALSE;
 	// транспорт ключа
 	if (bign256KeyWrap(token, beltH(), 20, beltH() + 32, pubkey, prngCOMBOStepR,
 			state) != ERR_OK ||
@@ -4,7 +4,7 @@
 \brief Benchmarks for STB 34.101.45 (bign)
 \project bee2/test
 \created 2026.03.09
-\version 2026.03.09
+\version 2026.10.16
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
@@ -24,13 +24,18 @@
 Оценка производительности алгоритмов Bign на определеннном уровне
 
 Оценивается производительность функций bignXXXKeypairGen(), bignXXXSign(),
-bignXXXSign2(), bignXXXVerify(), bignXXXKeyWrap(), bignXXXKeyUnwrap().
+bignXXXSign2(), bignXXXSignBatch(), bignXXXVerify(), bignXXXVerifyBatch(), 
+bignXXXKeyWrap(), bignXXXKeyUnwrap().
 
 \warning При оценке производительности не проверяются коды возврата функций.
 Предполагается, что функции завершаются успешно.
 
-\warning Замеряется среднее время выполнения bignXXXVerify() и минимальное
-время остальных функции. Предполагается, что последние функции регулярны.
+\warning Замеряется среднее время выполнения bignXXXSignBatch(), 
+bignXXXVerify(), bignXXXVerifyBatch() и минимальное время остальных 
+функции. Предполагается, что последние функции регулярны.
+
+\remark Пакетные выработка и проверка выполняются в одном потоке над 
+пакетами из BIGN_BENCH_BATCH подписей.
 
 \remark Оценивается время транспорта ключа из 32 октетов.
 *******************************************************************************
@@ -42,21 +47,30 @@ typedef err_t (*bign_sign_i)(octet sig[], const octet hash[],
 	const octet privkey[], gen_i rng, void* rng_state);
 typedef err_t (*bign_sign2_i)(octet sig[], const octet hash[],
 	const octet privkey[], const void* t, size_t t_len);
+typedef err_t (*bign_sign_batch_i)(octet sigs[], const octet hashes[],
+	size_t count, const octet privkey[], gen_i rng, void* rng_state, 
+	size_t nthreads);
 typedef err_t (*bign_verify_i)(const octet hash[], const octet sig[],
 	const octet pubkey[]);
+typedef err_t (*bign_verify_batch_i)(err_t rets[], const octet hashes[],
+	const octet sigs[], const octet pubkeys[], size_t count, size_t nthreads);
 typedef err_t (*bign_keywrap_i)(octet token[], const octet key[],
 	size_t len, const octet header[16], const octet pubkey[],
 	gen_i rng, void* rng_state);
 typedef err_t(*bign_keyunwrap_i)(octet key[], const octet token[], 
 	size_t len, const octet header[16], const octet privkey[]);
 
+#define BIGN_BENCH_BATCH 16
+
 static bool_t bignBench_internal(size_t l)
 {	
 	const size_t reps = 50;
 	bign_keypairgen_i keypairgen;
 	bign_sign_i sign;
 	bign_sign2_i sign2;
+	bign_sign_batch_i sign_batch;
 	bign_verify_i verify;
+	bign_verify_batch_i verify_batch;
 	bign_keywrap_i keywrap;
 	bign_keyunwrap_i keyunwrap;
 	mem_align_t combo_state[64 / sizeof(mem_align_t)];
@@ -64,6 +78,10 @@ static bool_t bignBench_internal(size_t l)
 	octet pubkey[128];
 	octet hash[64];
 	octet sig[96];
+	octet hashes[64 * BIGN_BENCH_BATCH];
+	octet sigs[96 * BIGN_BENCH_BATCH];
+	octet pubkeys[128 * BIGN_BENCH_BATCH];
+	err_t rets[BIGN_BENCH_BATCH];
 	octet key[32];
 	octet token[32 + 64 + 16];
 	tm_ticks_t ticks;
@@ -77,7 +95,9 @@ static bool_t bignBench_internal(size_t l)
 		keypairgen = bign128KeypairGen;
 		sign = bign128Sign;
 		sign2 = bign128Sign2;
+		sign_batch = bign128SignBatch;
 		verify = bign128Verify;
+		verify_batch = bign128VerifyBatch;
 		keywrap = bign128KeyWrap;
 		keyunwrap = bign128KeyUnwrap;
 	}
@@ -86,7 +106,9 @@ static bool_t bignBench_internal(size_t l)
 		keypairgen = bign192KeypairGen;
 		sign = bign192Sign;
 		sign2 = bign192Sign2;
+		sign_batch = bign192SignBatch;
 		verify = bign192Verify;
+		verify_batch = bign192VerifyBatch;
 		keywrap = bign192KeyWrap;
 		keyunwrap = bign192KeyUnwrap;
 	}
@@ -95,7 +117,9 @@ static bool_t bignBench_internal(size_t l)
 		keypairgen = bign256KeypairGen;
 		sign = bign256Sign;
 		sign2 = bign256Sign2;
+		sign_batch = bign256SignBatch;
 		verify = bign256Verify;
+		verify_batch = bign256VerifyBatch;
 		keywrap = bign256KeyWrap;
 		keyunwrap = bign256KeyUnwrap;
 	}
@@ -143,6 +167,19 @@ static bool_t bignBench_internal(size_t l)
 		(unsigned)l,
 		(unsigned)ticks,
 		(unsigned)tmSpeed(1, ticks));
+	// sign_batch
+	prngCOMBOStepR(hashes, l / 4 * BIGN_BENCH_BATCH, combo_state);
+	for (i = 0, ticks = 0; i < reps; ++i)
+	{
+		tm_ticks_t t = tmTicks();
+		(void)sign_batch(sigs, hashes, BIGN_BENCH_BATCH, privkey,
+			prngCOMBOStepR, combo_state, 1);
+		ticks += tmTicks() - t;
+	}
+	printf("bign%uBench::SignBatch:   %u cycles/sig [%u sigs/sec]\n",
+		(unsigned)l,
+		(unsigned)(ticks / reps / BIGN_BENCH_BATCH),
+		(unsigned)tmSpeed(reps * BIGN_BENCH_BATCH, ticks));
 	// verify
 	for (i = 0, ticks = 0; i < reps; ++i)
 	{
@@ -156,6 +193,23 @@ static bool_t bignBench_internal(size_t l)
 		(unsigned)l,
 		(unsigned)(ticks / reps),
 		(unsigned)tmSpeed(reps, ticks));
+	// verify_batch
+	for (i = 0; i < BIGN_BENCH_BATCH; ++i)
+	{
+		prngCOMBOStepR(hashes + l / 4 * i, l / 4, combo_state);
+		(void)sign2(sigs + 3 * l / 8 * i, hashes + l / 4 * i, privkey, 0, 0);
+		memCopy(pubkeys + l / 2 * i, pubkey, l / 2);
+	}
+	for (i = 0, ticks = 0; i < reps; ++i)
+	{
+		tm_ticks_t t = tmTicks();
+		(void)verify_batch(rets, hashes, sigs, pubkeys, BIGN_BENCH_BATCH, 1);
+		ticks += tmTicks() - t;
+	}
+	printf("bign%uBench::VerifyBatch: %u cycles/sig [%u sigs/sec]\n",
+		(unsigned)l,
+		(unsigned)(ticks / reps / BIGN_BENCH_BATCH),
+		(unsigned)tmSpeed(reps * BIGN_BENCH_BATCH, ticks));
 	// keywrap
 	for (i = 0, ticks = (tm_ticks_t)-1; i < reps; ++i)
 	{
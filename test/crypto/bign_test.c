@@ -4,7 +4,7 @@
 \brief Tests for STB 34.101.45 (bign)
 \project bee2/test
 \created 2012.08.27
-\version 2026.03.10
+\version 2026.10.16
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
@@ -14,7 +14,9 @@
 #include <bee2/core/blob.h>
 #include <bee2/core/err.h>
 #include <bee2/core/mem.h>
+#include <bee2/core/mt.h>
 #include <bee2/core/hex.h>
+#include <bee2/core/prng.h>
 #include <bee2/core/str.h>
 #include <bee2/core/util.h>
 #include <bee2/math/ec.h>
@@ -223,6 +225,317 @@ err_t bignPrePrint(const char* name, ec_pre_type type, size_t w)
 	return code;
 }
 
+/*
+*******************************************************************************
+Пакетная проверка ЭЦП
+
+Результаты bignVerifyBatch() сравниваются с результатами bignVerify(). 
+В пакет включаются искаженные подписи, хэш-значения и открытые ключи, 
+а также подпись, для которой s1 + H = 0 mod q (точка s1 G нулевая). 
+При count >= 64 для базовой точки строится таблица предвычислений.
+*******************************************************************************
+*/
+
+static bool_t bignTestVerifyBatch(const char* curve, size_t count)
+{
+	bign_params params[1];
+	octet der[16];
+	size_t der_len;
+	size_t no, i;
+	void* state;
+	octet* hashes;			/* [no * count] */
+	octet* sigs;			/* [(no + no / 2) * count] */
+	octet* pubkeys;			/* [2 * no * count] */
+	octet* privkey;			/* [no] */
+	err_t* rets;			/* [count] */
+	void* rng;				/* [prngCOMBO_keep()] */
+	word q[W_OF_O(64)];
+	word t[W_OF_O(64)];
+	err_t code;
+	bool_t bad;
+	// загрузить параметры
+	der_len = sizeof(der);
+	if (bignParamsStd(params, curve) != ERR_OK ||
+		bignOidToDER(der, &der_len, "1.2.112.0.2.0.34.101.31.81") != ERR_OK)
+		return FALSE;
+	no = params->l / 4;
+	// создать состояние
+	state = blobCreate2(
+		no * count,
+		(no + no / 2) * count,
+		2 * no * count,
+		no,
+		sizeof(err_t) * count,
+		prngCOMBO_keep(),
+		SIZE_MAX,
+		&hashes, &sigs, &pubkeys, &privkey, &rets, &rng);
+	if (state == 0)
+		return FALSE;
+	prngCOMBOStart(rng, 21);
+	// выработать подписи
+	for (i = 0; i < count; ++i)
+	{
+		octet* hash = hashes + no * i;
+		octet* sig = sigs + (no + no / 2) * i;
+		octet* pubkey = pubkeys + 2 * no * i;
+		if (i % 8 == 0)
+		{
+			if (bignKeypairGen(privkey, pubkey, params, prngCOMBOStepR,
+				rng) != ERR_OK)
+				break;
+		}
+		else
+			memCopy(pubkey, pubkey - 2 * no, 2 * no);
+		prngCOMBOStepR(hash, no, rng);
+		if (bignSign2(sig, params, der, der_len, hash, privkey, 0, 0) != 
+			ERR_OK)
+			break;
+	}
+	if (i < count)
+	{
+		blobClose(state);
+		return FALSE;
+	}
+	// исказить подписи, хэш-значения и ключи
+	for (i = 0; i < count; ++i)
+		if (i % 7 == 3)
+			sigs[(no + no / 2) * i + i % no] ^= 1;
+		else if (i % 11 == 5)
+			hashes[no * i] ^= 0x80;
+		else if (i % 13 == 6)
+			pubkeys[2 * no * i + no - 1] ^= 0x20;
+	// s1 <- -H mod q
+	if (count > 1)
+	{
+		wwFrom(q, params->q, no);
+		wwFrom(t, hashes + no, no);
+		if (wwCmp(t, q, W_OF_O(no)) >= 0)
+			zzSub2(t, q, W_OF_O(no));
+		zzNegMod(t, t, q, W_OF_O(no));
+		wwTo(sigs + (no + no / 2) + no / 2, no, t);
+	}
+	// проверить пакет
+	code = bignVerifyBatch(rets, params, der, der_len, hashes, sigs, 
+		pubkeys, count, 3);
+	for (i = 0, bad = FALSE; i < count; ++i)
+	{
+		if (rets[i] != bignVerify(params, der, der_len, hashes + no * i, 
+			sigs + (no + no / 2) * i, pubkeys + 2 * no * i))
+			break;
+		bad |= rets[i] != ERR_OK;
+	}
+	if (i < count || code != (bad ? ERR_BAD_SIG : ERR_OK))
+	{
+		blobClose(state);
+		return FALSE;
+	}
+	// ошибки пакета
+	if (bignVerifyBatch(rets, params, der, der_len, hashes, sigs, pubkeys,
+			count, 0) != ERR_BAD_INPUT ||
+		bignVerifyBatch(rets, params, der, 1, hashes, sigs, pubkeys,
+			count, 1) != ERR_BAD_OID || rets[count - 1] != ERR_BAD_OID)
+	{
+		blobClose(state);
+		return FALSE;
+	}
+	// завершение
+	blobClose(state);
+	return TRUE;
+}
+
+/*
+*******************************************************************************
+Пакетная выработка ЭЦП
+
+Подписи bignSignBatch() сравниваются с подписями, выработанными 
+последовательными вызовами bignSign() с тем же генератором. При 
+count >= 64 для базовой точки строится таблица предвычислений, 
+при count > 1024 подписи вырабатываются несколькими порциями.
+*******************************************************************************
+*/
+
+static bool_t bignTestSignBatch(const char* curve, size_t count)
+{
+	bign_params params[1];
+	octet der[16];
+	size_t der_len;
+	size_t no, i;
+	void* state;
+	octet* hashes;			/* [no * count] */
+	octet* sigs;			/* [(no + no / 2) * count] */
+	octet* sig;				/* [no + no / 2] */
+	octet* privkey;			/* [no] */
+	octet* pubkey;			/* [2 * no] */
+	void* rng;				/* [prngCOMBO_keep()] */
+	void* rng1;				/* [prngCOMBO_keep()] */
+	// загрузить параметры
+	der_len = sizeof(der);
+	if (bignParamsStd(params, curve) != ERR_OK ||
+		bignOidToDER(der, &der_len, "1.2.112.0.2.0.34.101.31.81") != ERR_OK)
+		return FALSE;
+	no = params->l / 4;
+	// создать состояние
+	state = blobCreate2(
+		no * count,
+		(no + no / 2) * count,
+		no + no / 2,
+		no,
+		2 * no,
+		prngCOMBO_keep(),
+		prngCOMBO_keep(),
+		SIZE_MAX,
+		&hashes, &sigs, &sig, &privkey, &pubkey, &rng, &rng1);
+	if (state == 0)
+		return FALSE;
+	prngCOMBOStart(rng, 25);
+	// сгенерировать ключи и хэш-значения
+	if (bignKeypairGen(privkey, pubkey, params, prngCOMBOStepR, rng) != 
+		ERR_OK)
+	{
+		blobClose(state);
+		return FALSE;
+	}
+	prngCOMBOStepR(hashes, no * count, rng);
+	memCopy(rng1, rng, prngCOMBO_keep());
+	// выработать пакет
+	if (bignSignBatch(sigs, params, der, der_len, hashes, count, privkey,
+			prngCOMBOStepR, rng, 3) != ERR_OK)
+	{
+		blobClose(state);
+		return FALSE;
+	}
+	// сравнить с последовательной выработкой
+	for (i = 0; i < count; ++i)
+		if (bignSign(sig, params, der, der_len, hashes + no * i, privkey,
+				prngCOMBOStepR, rng1) != ERR_OK ||
+			!memEq(sig, sigs + (no + no / 2) * i, no + no / 2))
+			break;
+	if (i < count ||
+		bignVerify(params, der, der_len, hashes + no * (count - 1), 
+			sigs + (no + no / 2) * (count - 1), pubkey) != ERR_OK)
+	{
+		blobClose(state);
+		return FALSE;
+	}
+	// ошибки пакета
+	if (bignSignBatch(sigs, params, der, der_len, hashes, count, privkey,
+			prngCOMBOStepR, rng, 0) != ERR_BAD_INPUT ||
+		bignSignBatch(sigs, params, der, 1, hashes, count, privkey,
+			prngCOMBOStepR, rng, 1) != ERR_BAD_OID)
+	{
+		blobClose(state);
+		return FALSE;
+	}
+	memSetZero(privkey, no);
+	if (bignSignBatch(sigs, params, der, der_len, hashes, count, privkey,
+			prngCOMBOStepR, rng, 1) != ERR_BAD_PRIVKEY)
+	{
+		blobClose(state);
+		return FALSE;
+	}
+	// завершение
+	blobClose(state);
+	return TRUE;
+}
+
+/*
+*******************************************************************************
+Пул одноразовых ключей
+
+Генератор с состоянием rng_state выдает тот же одноразовый ключ, что 
+и при выработке подписи sig. Проверяется, что bignSignPool() 
+воспроизводит sig. Затем проверяется выборка из пустого пула. Далее 
+пул пополняется в фоновом потоке, из него выбирается больше пар, чем 
+помещается в пул, подписи проверяются. Наконец, проверяется, что ошибка 
+генератора в фоновом потоке возвращается функцией bignSignPool().
+*******************************************************************************
+*/
+
+static void bignTestZeroRng(void* buf, size_t count, void* state)
+{
+	memSetZero(buf, count);
+}
+
+static bool_t bignTestPool(const bign_params* params, const octet der[],
+	size_t der_len, const octet hash[], const octet sig[], 
+	const octet privkey[], const octet pubkey[], void* rng_state)
+{
+	const size_t capacity = 4;
+	bign_pool_t pool;
+	octet sig1[96];
+	size_t i;
+	err_t code;
+	// создать пул
+	if (bignPoolCreate(&pool, params, capacity, brngCTRXStepR, 
+			rng_state) != ERR_OK)
+		return FALSE;
+	// воспроизвести подпись
+	if (bignPoolFill(pool, 1) != ERR_OK || bignPoolCount(pool) != 1 ||
+		bignSignPool(sig1, pool, der, der_len, hash, privkey) != ERR_OK ||
+		bignPoolCount(pool) != 0 || bignPoolMisses(pool) != 0 ||
+		!memEq(sig1, sig, params->l * 3 / 8))
+	{
+		bignPoolClose(pool);
+		return FALSE;
+	}
+	// выборка из пустого пула
+	if (bignSignPool(sig1, pool, der, der_len, hash, privkey) != ERR_OK ||
+		bignPoolMisses(pool) != 1 ||
+		bignVerify(params, der, der_len, hash, sig1, pubkey) != ERR_OK)
+	{
+		bignPoolClose(pool);
+		return FALSE;
+	}
+	// фоновое пополнение
+	if (bignPoolRun(pool) != ERR_OK)
+	{
+		bignPoolClose(pool);
+		return FALSE;
+	}
+	for (i = 0; i < 1000 && bignPoolCount(pool) < capacity; ++i)
+		mtSleep(10);
+	if (bignPoolCount(pool) != capacity)
+	{
+		bignPoolClose(pool);
+		return FALSE;
+	}
+	for (i = 0; i < 2 * capacity; ++i)
+		if (bignSignPool(sig1, pool, der, der_len, hash, privkey) != 
+				ERR_OK ||
+			memEq(sig1, sig, params->l * 3 / 8) ||
+			bignVerify(params, der, der_len, hash, sig1, pubkey) != ERR_OK)
+		{
+			bignPoolClose(pool);
+			return FALSE;
+		}
+	bignPoolClose(pool);
+	// ошибка фонового потока: код ошибки возвращается вместо выработки 
+	// пары в вызывающем потоке
+	if (bignPoolCreate(&pool, params, capacity, bignTestZeroRng, 0) != 
+			ERR_OK)
+		return FALSE;
+	if (bignPoolRun(pool) != ERR_OK)
+	{
+		bignPoolClose(pool);
+		return FALSE;
+	}
+	for (i = 0; i < 1000; ++i)
+	{
+		code = bignSignPool(sig1, pool, der, der_len, hash, privkey);
+		if (code != ERR_BAD_RNG || bignPoolMisses(pool) == i)
+			break;
+		mtSleep(10);
+	}
+	if (i == 1000 || code != ERR_BAD_RNG || bignPoolRun(pool) != ERR_OK)
+	{
+		bignPoolClose(pool);
+		return FALSE;
+	}
+	// завершение
+	bignPoolClose(pool);
+	return TRUE;
+}
+
 /*
 *******************************************************************************
 Самотестирование
@@ -248,7 +561,9 @@ bool_t bignTest()
 	octet sig[64 + 32];
 	octet id_sig[64 + 32 + 128];
 	mem_align_t state[1024 / sizeof(mem_align_t)];
+	mem_align_t state1[1024 / sizeof(mem_align_t)];
 	mem_align_t stack[512 / sizeof(mem_align_t)];
+	mem_align_t pre[4608 / sizeof(mem_align_t)];
 	octet token[80];
 	word q[W_OF_O(32)];
 	word d[W_OF_O(32)];
@@ -338,6 +653,7 @@ bool_t bignTest()
 	// тест Г.2
 	if (beltHash(hash, beltH(), 13) != ERR_OK)
 		return FALSE;
+	memCopy(state1, state, sizeof(state));
 	if (bignSign(sig, params, der, count, hash, privkey, brngCTRXStepR, 
 			state) != ERR_OK)
 		return FALSE;
@@ -354,7 +670,22 @@ bool_t bignTest()
 	sig[0] ^= 1, pubkey[0] ^= 1;
 	if (bignVerify(params, der, count, hash, sig, pubkey) == ERR_OK)
 		return FALSE;
+	if (sizeof(pre) < bignPubkeyPre_keep(128) ||
+		bignPubkeyPre(pre, params, pubkey) == ERR_OK)
+		return FALSE;
 	pubkey[0] ^= 1;
+	// проверка с предвычислениями для pubkey
+	if (bignPubkeyPre(pre, params, pubkey) != ERR_OK ||
+		bignVerifyPre(params, der, count, hash, sig, pre) != ERR_OK)
+		return FALSE;
+	sig[0] ^= 1;
+	if (bignVerifyPre(params, der, count, hash, sig, pre) != ERR_BAD_SIG)
+		return FALSE;
+	sig[0] ^= 1;
+	// выработка ЭЦП с пулом одноразовых ключей
+	if (!bignTestPool(params, der, count, hash, sig, privkey, pubkey, 
+			state1))
+		return FALSE;
 	// тест Г.8
 	memCopy(id_hash, hash, 32);
 	if (bignIdExtract(id_privkey, id_pubkey, params, der, count, 
@@ -552,6 +883,14 @@ bool_t bignTest()
 		"E48329259BC1211DDAC2EF1DADFFC993"
 		"2702A92F1DD66C14A9BA1D7300C8713C"))
 		return FALSE;
+	// пакетная проверка ЭЦП
+	if (!bignTestVerifyBatch("1.2.112.0.2.0.34.101.45.3.1", 70) ||
+		!bignTestVerifyBatch("1.2.112.0.2.0.34.101.45.3.1", 9))
+		return FALSE;
+	// пакетная выработка ЭЦП
+	if (!bignTestSignBatch("1.2.112.0.2.0.34.101.45.3.1", 1030) ||
+		!bignTestSignBatch("1.2.112.0.2.0.34.101.45.3.1", 9))
+		return FALSE;
 	// все нормально
 	return TRUE;
 }
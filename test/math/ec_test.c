@@ -4,7 +4,7 @@
 \brief Tests for elliptic curves
 \project bee2/test
 \created 2026.02.12
-\version 2026.03.05
+\version 2026.10.16
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
@@ -68,6 +68,97 @@ static bool_t ecSubAA(word c[], const word a[], const word b[],
 
 #define ecSubAA_deep ecAddAA_deep
 
+/*
+*******************************************************************************
+Сумма кратных точек: массивы
+
+Результат ecMulMulti() сравнивается с суммой результатов ecMulA(). 
+Проверяются метод interleaving (5 слагаемых, длинные кратности) и метод 
+Пиппенджера (300 слагаемых, короткие кратности). Среди точек-слагаемых 
+есть повторы, среди кратностей -- нулевая.
+*******************************************************************************
+*/
+
+static bool_t ecTestMulMulti(const ec_o* ec)
+{
+	const size_t n = ec->f->n;
+	const size_t max_k = 300;
+	const size_t ms[2] = { n, 1 };
+	const size_t ks[2] = { 5, 300 };
+	// состояние
+	void* state;
+	word* a;		/* [2 * n * max_k] */
+	word* d;		/* [n * max_k] */
+	word* pt0;		/* [2 * n] */
+	word* pt1;		/* [2 * n] */
+	word* t;		/* [ec->d * n] */
+	void* stack;
+	// другие переменные
+	size_t r, i, j;
+	// создать состояние
+	state = blobCreate2(
+		O_OF_W(2 * n * max_k),
+		O_OF_W(n * max_k),
+		O_OF_W(2 * n),
+		O_OF_W(2 * n),
+		O_OF_W(ec->d * n),
+		utilMax(4,
+			ec->deep,
+			ecMulA_deep(n, ec->d, ec->deep, n),
+			ecMulMulti_deep(n, ec->d, ec->deep, ms[0], ks[0]),
+			ecMulMulti_deep(n, ec->d, ec->deep, ms[1], ks[1])),
+		SIZE_MAX,
+		&a, &d, &pt0, &pt1, &t, &stack);
+	if (state == 0)
+		return FALSE;
+	// a[i] <- (i % 7 + 1) base
+	wwCopy(ecPtA(a, 0, ec), ec->base, 2 * n);
+	for (i = 1; i < 7; ++i)
+	{
+		ecFromA(t, ecPtA(a, i - 1, ec), ec, stack);
+		ecAddA(t, t, ec->base, ec, stack);
+		if (!ecToA(ecPtA(a, i, ec), t, ec, stack))
+		{
+			blobClose(state);
+			return FALSE;
+		}
+	}
+	for (; i < max_k; ++i)
+		wwCopy(ecPtA(a, i, ec), ecPtA(a, i % 7, ec), 2 * n);
+	// цикл по методам
+	for (r = 0; r < 2; ++r)
+	{
+		const size_t m = ms[r];
+		const size_t k = ks[r];
+		// d[i] <- ...
+		for (i = 0; i < k; ++i)
+		{
+			word* di = d + m * i;
+			for (j = 0; j < m; ++j)
+				di[j] = ec->order[j] * (word)(2 * i + 3) + (word)i;
+		}
+		wwSetZero(d + m * (k / 2), m);
+		// pt1 <- \sum_i d[i] a[i]
+		ecSetO(t, ec);
+		for (i = 0; i < k; ++i)
+		{
+			if (!ecMulA(pt0, ecPtA(a, i, ec), ec, d + m * i, m, stack))
+				continue;
+			ecAddA(t, t, pt0, ec, stack);
+		}
+		if (!ecToA(pt1, t, ec, stack) ||
+			!ecMulMulti(pt0, a, ec, d, m, k, stack) ||
+			!wwEq(pt0, pt1, 2 * n))
+		{
+			blobClose(state);
+			return FALSE;
+		}
+	}
+	// все хорошо
+	blobClose(state);
+	return TRUE;
+}
+
 /*
 *******************************************************************************
 Тестирование на заданной кривой
@@ -462,6 +553,12 @@ bool_t ecTestEc(const ec_o* ec)
 			return FALSE;
 		}
 	}
+	// сумма кратных точек: ecMulMulti
+	if (!ecTestMulMulti(ec))
+	{
+		blobClose(state);
+		return FALSE;
+	}
 	// четный порядок?
 	if (ec->order[0] % 2 == 0)
 	{
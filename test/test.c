@@ -4,7 +4,7 @@
 \brief Bee2 testing
 \project bee2/test
 \created 2014.04.02
-\version 2026.03.09
+\version 2026.10.16
 \copyright The Bee2 authors
 \license Licensed under the Apache License, Version 2.0 (see LICENSE.txt).
 *******************************************************************************
@@ -22,6 +22,7 @@
 extern bool_t apduTest();
 extern bool_t b64Test();
 extern bool_t blobTest();
+extern bool_t cpuTest();
 extern bool_t decTest();
 extern bool_t derTest();
 extern bool_t fileTest();
@@ -47,6 +48,7 @@ static int testCore()
 	printf("apduTest: %s\n", (code = apduTest()) ? "OK" : "Err"), ret |= !code;
 	printf("b64Test: %s\n", (code = b64Test()) ? "OK" : "Err"), ret |= !code;
 	printf("blobTest: %s\n", (code = blobTest()) ? "OK" : "Err"), ret |= !code;
+	printf("cpuTest: %s\n", (code = cpuTest()) ? "OK" : "Err"), ret |= !code;
 	printf("decTest: %s\n", (code = decTest()) ? "OK" : "Err"), ret |= !code;
 	printf("derTest: %s\n", (code = derTest()) ? "OK" : "Err"), ret |= !code;
 	printf("fileTest: %s\n", (code = fileTest()) ? "OK" : "Err"), ret |= !code;